@@ -28,6 +28,7 @@ static void create_and_run_scene(gu::Window &window) {
 	gu::Animation animation = gu::Animation("res/pants/pants_animation.dae", *pants);
 	gu::Animator animator;
 	animator.set_animation(animation);
+	gu::env::get_animation_system().add(animator);
 
 	auto arrow = gu::model_res_list.create_and_load("res/arrow/smooth_arrow.obj");
 
@@ -63,14 +64,22 @@ static void create_and_run_scene(gu::Window &window) {
 	//tf.set_scaling(1.0f);
 	//tf.update();
 
-	// creates LightShader and sets constant light values.
-	gu::LightShader light_shader;
-	light_shader.build_from_files(
-		"guru/shader/default_glsl/anim_light_shader.v_shader",
-		"guru/shader/default_glsl/anim_light_shader.f_shader"
+	// builds the skinned variant of the default LightShader
+	// and sets constant light values.
+	gu::ShaderVariants<gu::LightShader> light_shaders;
+	light_shaders.load(
+		"guru/shader/default_glsl/light_shader.v_shader",
+		"guru/shader/default_glsl/light_shader.f_shader"
 	);
-	light_shader.use();
-	light_shader.set_ambient_color(glm::vec3(0.18, 0.18, 0.2));
+	gu::LightShader *light_shader = light_shaders.get(
+		gu::ShaderKey().set(gu::ShaderKey::SKINNING)
+	);
+	if (not light_shader) {
+		gu::env::get_animation_system().remove(animator);
+		return;
+	}
+	light_shader->use();
+	light_shader->set_ambient_color(glm::vec3(0.18, 0.18, 0.2));
 
 	// loads the skybox cubemap.
 	GLuint cubemap_ID = gu::res::load_cube_map(
@@ -79,10 +88,10 @@ static void create_and_run_scene(gu::Window &window) {
 
 	while (not window.should_close()) {
 		gu::env::poll_events_and_update_delta();
-		animator.update_animation();
-		animator.print_rig_hierarchy();
 
-		const std::vector<glm::mat4> &bone_mats = animator.get_final_bone_matrices();
+		// updates the pants' Animator and sends its palette with one call.
+		gu::env::update_animations();
+		animator.print_rig_hierarchy();
 
 		// places every sphere at some position to create a spiral.
 		double glfw_time = glfwGetTime();
@@ -102,30 +111,31 @@ static void create_and_run_scene(gu::Window &window) {
 
 		// prepares for render.
 		gu::env::clear_window_and_screenbuffer();
-		light_shader.use();
-		light_shader.update_GL_bones(bone_mats);
-		light_shader.update_GL_dir_light(0, dir_light);
-		light_shader.update_GL_point_light(0, point_light);
+		light_shader->use();
+		light_shader->set_bone_palette(
+			animator.get_palette_offset(), animator.get_n_bones()
+		);
+		light_shader->update_GL_dir_light(0, dir_light);
+		light_shader->update_GL_point_light(0, point_light);
 		spot_light.place(gu::env::get_camera().get_position());
 		spot_light.orient(gu::env::get_camera().get_quat());
 		for (int i = 0; i < gu::env::get_n_cameras(); ++i) {
 			gu::Camera &cam = gu::env::get_camera(i);
-			light_shader.set_view_pos(cam.get_position());
+			gu::UniformBlocks::update_camera(cam);
 			glm::mat4 PVM;
 
 			// draws pants.
 			glm::mat4 model = tf.get_model_matrix();
 			PVM = cam.get_projview() * model;
-			light_shader.set_PVM_mat(PVM);
-			light_shader.set_PV_mat(cam.get_projview());
-			light_shader.set_model_mat(model);
+			light_shader->set_PVM_mat(PVM);
+			light_shader->set_model_mat(model);
 			pants->draw_meshes();
 
 			// draws the axis arrows.
 			for (uint8_t j = 0; j < 3; ++j) {
 				PVM = cam.get_projview() * axes_tfs[j].get_model_matrix();
-				light_shader.set_PVM_mat(PVM);
-				light_shader.set_model_mat(axes_tfs[j].get_model_matrix());
+				light_shader->set_PVM_mat(PVM);
+				light_shader->set_model_mat(axes_tfs[j].get_model_matrix());
 				arrow->draw_meshes(arrow_overrides[j]);
 			}
 
@@ -134,6 +144,7 @@ static void create_and_run_scene(gu::Window &window) {
 		gu::env::display_frame();
 	}
 
+	gu::env::get_animation_system().remove(animator);
 	gu::model_res_list.delete_entry("res/pants/pants_animation.dae");
 	gu::model_res_list.delete_entry("res/arrow/smooth_arrow.obj");
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "guru/environment/environment.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <assimp/anim.h>
+
+// times how long sampling a clip takes as its length and keyframe count grow.
+// this doesn't draw anything; it prints its results and returns.
+
+static const double TICKS_PER_SECOND = 30.0; // one keyframe per tick
+static const double FRAME_RATE = 60.0;
+static const size_t N_BONES = 64;
+static const size_t N_SEEKS = 1 << 16;
+
+// the keyframe search that Bone used before it kept cursors,
+// which scans from the first keyframe on every sample.
+static size_t find_keyframe_index_linearly(
+	const std::vector<uint16_t> &time_stamps, const float &key_time
+) {
+	for (size_t i = 0; i < time_stamps.size() - 1; ++i) {
+		if (key_time < time_stamps[i + 1])
+			return i;
+	}
+	return time_stamps.size() - 2;
+}
+
+// returns the nanoseconds that each call of <func> took on average.
+template <typename Func>
+static double time_per_call(const size_t &n_calls, Func func) {
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < n_calls; ++i)
+		func(i);
+	std::chrono::duration<double, std::nano> elapsed = (
+		std::chrono::steady_clock::now() - start
+	);
+	return elapsed.count() / static_cast<double>(n_calls);
+}
+
+// creates an assimp channel with <n_keys> keyframes on every track,
+// whose values curve so that the compression keeps them.
+static aiNodeAnim *create_channel(const size_t &n_keys, const size_t &seed) {
+	aiNodeAnim *channel = new aiNodeAnim();
+	channel->mNumPositionKeys = static_cast<unsigned int>(n_keys);
+	channel->mNumRotationKeys = static_cast<unsigned int>(n_keys);
+	channel->mNumScalingKeys = static_cast<unsigned int>(n_keys);
+	channel->mPositionKeys = new aiVectorKey[n_keys];
+	channel->mRotationKeys = new aiQuatKey[n_keys];
+	channel->mScalingKeys = new aiVectorKey[n_keys];
+	for (size_t i = 0; i < n_keys; ++i) {
+		double time = static_cast<double>(i);
+		float phase = static_cast<float>(i) * 0.37f + static_cast<float>(seed);
+		glm::quat q = glm::angleAxis(phase, glm::normalize(glm::vec3(
+			std::sin(phase), std::cos(phase * 1.3f), 0.5f
+		)));
+		channel->mPositionKeys[i] = aiVectorKey(
+			time, aiVector3D(std::sin(phase), std::cos(phase), phase * 0.01f)
+		);
+		channel->mRotationKeys[i] = aiQuatKey(
+			time, aiQuaternion(q.w, q.x, q.y, q.z)
+		);
+		channel->mScalingKeys[i] = aiVectorKey(
+			time, aiVector3D(1.0f + 0.1f * std::sin(phase * 2.0f))
+		);
+	}
+	return channel;
+}
+
+static void create_and_run_scene(gu::Window &window) {
+	std::cout
+		<< "keys  clip (s)  linear (ns)  cursor (ns)  seek (ns)  pose (us)\n";
+	std::mt19937 random(1);
+	for (size_t n_keys = 16; n_keys <= 8192; n_keys *= 2) {
+		double duration = static_cast<double>(n_keys - 1);
+		double clip_seconds = duration / TICKS_PER_SECOND;
+		size_t n_frames = static_cast<size_t>(clip_seconds * FRAME_RATE);
+		double ticks_per_frame = TICKS_PER_SECOND / FRAME_RATE;
+
+		// loads a clip of <N_BONES> without removing any keyframes.
+		gu::ClipCompression::Tolerances tolerances;
+		tolerances.position = 0.0f;
+		tolerances.orientation = 0.0f;
+		tolerances.scaling = 0.0f;
+		gu::ClipCompression::Stats stats;
+		std::vector<gu::Animation::Bone> bones;
+		bones.reserve(N_BONES);
+		for (size_t i = 0; i < N_BONES; ++i) {
+			aiNodeAnim *channel = create_channel(n_keys, i);
+			bones.emplace_back(
+				"bone", static_cast<int>(i), channel, duration, tolerances, stats
+			);
+			delete channel;
+		}
+
+		// times the keyframe search alone over one playthrough.
+		std::vector<uint16_t> time_stamps(n_keys);
+		for (size_t i = 0; i < n_keys; ++i) {
+			time_stamps[i] = gu::ClipCompression::pack_time_stamp(
+				static_cast<double>(i), duration
+			);
+		}
+		float time_scale = static_cast<float>(
+			gu::ClipCompression::MAX_TIME_STAMP / duration
+		);
+		auto get_key_time = [&](const size_t &frame) {
+			return static_cast<float>(frame * ticks_per_frame) * time_scale;
+		};
+		volatile size_t sink = 0;
+		double linear_ns = time_per_call(n_frames, [&](const size_t &frame) {
+			sink = sink + find_keyframe_index_linearly(
+				time_stamps, get_key_time(frame)
+			);
+		});
+		size_t cursor = 0;
+		double cursor_ns = time_per_call(n_frames, [&](const size_t &frame) {
+			sink = sink + gu::Animation::Bone::find_keyframe_index(
+				time_stamps, get_key_time(frame), cursor
+			);
+		});
+
+		// times random seeks, which fall back to the binary search.
+		std::uniform_real_distribution<float> seek_time(
+			0.0f, static_cast<float>(gu::ClipCompression::MAX_TIME_STAMP)
+		);
+		std::vector<float> seek_times(N_SEEKS);
+		for (float &key_time : seek_times)
+			key_time = seek_time(random);
+		double seek_ns = time_per_call(N_SEEKS, [&](const size_t &i) {
+			sink = sink + gu::Animation::Bone::find_keyframe_index(
+				time_stamps, seek_times[i], cursor
+			);
+		});
+
+		// times sampling and evaluating the whole skeleton per frame.
+		gu::PoseBatch batch;
+		batch.resize(N_BONES);
+		std::vector<gu::Animation::Bone::Cursor> cursors(N_BONES);
+		double pose_ns = time_per_call(n_frames, [&](const size_t &frame) {
+			float animation_time = static_cast<float>(frame * ticks_per_frame);
+			for (size_t i = 0; i < N_BONES; ++i)
+				bones[i].sample(animation_time, cursors[i], batch, i);
+			batch.evaluate();
+		});
+
+		std::cout << std::fixed << std::setprecision(1)
+			<< std::setw(4) << n_keys
+			<< std::setw(10) << clip_seconds
+			<< std::setw(13) << linear_ns
+			<< std::setw(13) << cursor_ns
+			<< std::setw(11) << seek_ns
+			<< std::setw(11) << pose_ns / 1000.0
+			<< std::endl;
+	}
+}
\ No newline at end of file
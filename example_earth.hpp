@@ -68,8 +68,10 @@ static void create_and_run_scene(gu::Window &window) {
 	arrow_transformation.update();
 
 	// sets up the transformation for the spheres.
+	// every sphere is drawn at once with instancing.
 	static const size_t N_TRANSFORMATIONS = 57;
 	std::vector<gu::Transformation> transformations;
+	std::vector<glm::mat4> sphere_model_mats(N_TRANSFORMATIONS);
 	for (size_t i = 0; i < N_TRANSFORMATIONS; ++i) {
 		transformations.push_back(gu::Transformation());
 		transformations.back().orient(0.0, 0.0, glm::radians(23.0));
@@ -77,14 +79,20 @@ static void create_and_run_scene(gu::Window &window) {
 		transformations.back().update();
 	}
 
-	// creates LightShader and sets constant light values.
-	gu::LightShader light_shader;
-	light_shader.build_from_files(
+	// builds the instanced variant of the default LightShader
+	// and sets constant light values.
+	gu::ShaderVariants<gu::LightShader> light_shaders;
+	light_shaders.load(
 		"guru/shader/default_glsl/light_shader.v_shader",
 		"guru/shader/default_glsl/light_shader.f_shader"
 	);
-	light_shader.use();
-	light_shader.set_ambient_color(glm::vec3(0.18, 0.18, 0.2));
+	gu::LightShader *light_shader = light_shaders.get(
+		gu::ShaderKey().set(gu::ShaderKey::INSTANCING)
+	);
+	if (not light_shader)
+		return;
+	light_shader->use();
+	light_shader->set_ambient_color(glm::vec3(0.18, 0.18, 0.2));
 
 	// loads the skybox cubemap.
 	GLuint cubemap_ID = gu::res::load_cube_map(
@@ -114,6 +122,7 @@ static void create_and_run_scene(gu::Window &window) {
 			);
 			transformations[i].add_yaw(-0.1f - 0.002f * (i + 1));
 			transformations[i].update();
+			sphere_model_mats[i] = transformations[i].get_model_matrix();
 		}
 
 		for (uint8_t i = 0; i < 3; ++i) {
@@ -131,37 +140,26 @@ static void create_and_run_scene(gu::Window &window) {
 
 		// prepares for render.
 		gu::env::clear_window_and_screenbuffer();
-		light_shader.use();
-		light_shader.update_GL_dir_light(0, dir_light);
-		light_shader.update_GL_point_light(0, point_light);
+		light_shader->use();
+		light_shader->update_GL_dir_light(0, dir_light);
+		light_shader->update_GL_point_light(0, point_light);
 		spot_light.place(gu::env::get_camera().get_position());
 		spot_light.orient(gu::env::get_camera().get_quat());
 		for (int i = 0; i < gu::env::get_n_cameras(); ++i) {
 			gu::Camera &cam = gu::env::get_camera(i);
-			light_shader.set_view_pos(cam.get_position());
-			glm::mat4 PVM;
+			gu::UniformBlocks::update_camera(cam);
 
 			// draws arrow that indicates the DirLight's direction.
-			PVM = cam.get_projview() * arrow_transformation.get_model_matrix();
-			light_shader.set_PVM_mat(PVM);
-			light_shader.set_model_mat(arrow_transformation.get_model_matrix());
-			arrow->draw_meshes();
+			glm::mat4 model = arrow_transformation.get_model_matrix();
+			arrow->draw_meshes_instanced({&model, 1});
 
 			// draws every sphere.
-			for (size_t j = 0; j < N_TRANSFORMATIONS; ++j) {
-				glm::mat4 model = transformations[j].get_model_matrix();
-				PVM = cam.get_projview() * model;
-				light_shader.set_PVM_mat(PVM);
-				light_shader.set_model_mat(model);
-				sphere->draw_meshes();
-			}
+			sphere->draw_meshes_instanced(sphere_model_mats);
 
 			// draws the axis arrows.
 			for (uint8_t j = 0; j < 3; ++j) {
-				PVM = cam.get_projview() * axes_tfs[j].get_model_matrix();
-				light_shader.set_PVM_mat(PVM);
-				light_shader.set_model_mat(axes_tfs[j].get_model_matrix());
-				arrow->draw_meshes(arrow_overrides[j]);
+				model = axes_tfs[j].get_model_matrix();
+				arrow->draw_meshes_instanced({&model, 1}, arrow_overrides[j]);
 			}
 
 			gu::env::draw_skybox(cam.get_skybox_mat(), cubemap_ID);
@@ -0,0 +1,74 @@
+#include "guru/environment/environment.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+// checks that the SSE frustum test agrees with the one that tests
+// one plane at a time, including for spheres much larger than one unit.
+// this doesn't draw anything; it prints its results and returns.
+
+static const size_t N_FRUSTUMS = 64;
+static const size_t N_SHAPES = 4096;
+
+// returns true if <a> and <b> are equal within a small relative tolerance,
+// since the two paths may round their sums differently.
+static bool is_close(const float &a, const float &b) {
+	return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::abs(b));
+}
+
+static void create_and_run_scene(gu::Window &window) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+	std::uniform_real_distribution<float> size(0.0f, 50.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	size_t n_mismatches = 0;
+	size_t n_large_rejects = 0;
+	for (size_t i = 0; i < N_FRUSTUMS; ++i) {
+		// builds a frustum that looks from near the origin in any direction.
+		float yaw = angle(random);
+		glm::vec3 position(coord(random), coord(random), coord(random));
+		glm::vec3 forward(std::cos(yaw), 0.0f, std::sin(yaw));
+		glm::mat4 projview = (
+			glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f)
+			* glm::lookAt(position, position + forward, glm::vec3(0, 1, 0))
+		);
+		gu::Frustum frustum;
+		frustum.set(projview);
+
+		// compares both paths for spheres and boxes anywhere near the frustum.
+		for (size_t j = 0; j < N_SHAPES; ++j) {
+			glm::vec3 center = position + glm::vec3(
+				coord(random), coord(random), coord(random)
+			);
+			glm::vec3 extents(size(random), size(random), size(random));
+			float radius = size(random);
+			auto compare = [&](const glm::vec3 &e, const float &r) {
+				float simd = frustum.get_min_distance(center, e, r);
+				float scalar = frustum.get_min_distance_scalar(center, e, r);
+				if (not is_close(simd, scalar))
+					++n_mismatches;
+			};
+			compare(glm::vec3(0.0f), radius); // sphere
+			compare(extents, 0.0f); // box that intersects
+			compare(-extents, 0.0f); // box that's contained
+		}
+
+		// a large sphere in the middle of the view volume
+		// must be accepted before its box is tested.
+		glm::vec3 center = position + forward * 500.0f;
+		float radius = 100.0f;
+		float center_dist = frustum.get_min_distance(
+			center, glm::vec3(0.0f), 0.0f
+		);
+		if (center_dist < radius)
+			++n_large_rejects;
+	}
+
+	std::cout
+		<< "frustum paths disagreed " << n_mismatches << " times, and "
+		<< n_large_rejects << " large spheres inside the view volume"
+		<< " weren't accepted by their distance alone.\n"
+		<< (n_mismatches == 0 and n_large_rejects == 0 ? "passed" : "FAILED")
+		<< std::endl;
+}
\ No newline at end of file
@@ -93,11 +93,34 @@ void Camera::update() {
 
 	if (projview_needs_update) {
 		_projview_mat = _proj_mat * _view_mat;
+		_frustum.set(_projview_mat);
 		if (skybox_mat_needs_update)
 			_skybox_mat = _proj_mat * glm::mat4(glm::mat3(_view_mat));
 	}
 }
 
+bool Camera::is_model_visible(
+	const Bounds &bounds, const glm::mat4 &model_mat
+) const {
+	bool visible = _frustum.intersects(bounds.transformed(model_mat));
+	if (visible)
+		++_culling_stats.n_visible_models;
+	else
+		++_culling_stats.n_culled_models;
+	return visible;
+}
+
+bool Camera::is_mesh_visible(
+	const Bounds &bounds, const glm::mat4 &model_mat
+) const {
+	bool visible = _frustum.intersects(bounds.transformed(model_mat));
+	if (visible)
+		++_culling_stats.n_visible_meshes;
+	else
+		++_culling_stats.n_culled_meshes;
+	return visible;
+}
+
 void Camera::_set_ortho_projection(bool orthographic) {
 	_orthographic = orthographic;
 	_proj_mat_needs_update = true;
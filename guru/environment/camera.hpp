@@ -5,14 +5,37 @@
  * are used to transform the rendered objects
  * to apply a particular perspective to a scene.
  *
+ * ---
+ * the Camera keeps the Frustum of its projection * view matrix,
+ * which is used to cull models and Meshes outside of its view.
+ * every test counts toward the Camera's CullingStats,
+ * which are reset once per frame by env::poll_events_and_update_delta().
+ *
  */
 
 #pragma once
 #include <glad/gl.h>
+#include "frustum.hpp"
+#include "../mathmatics/bounds.hpp"
 #include "../mathmatics/quat_point.hpp"
 
 namespace gu {
 class Camera : public QuatPoint {
+public:
+	/**
+	 * Camera::CullingStats
+	 * ---
+	 * this struct counts how many models and Meshes
+	 * were tested against the Camera's view since the last reset.
+	 *
+	 */
+	struct CullingStats {
+		size_t n_visible_models = 0;
+		size_t n_culled_models = 0;
+		size_t n_visible_meshes = 0;
+		size_t n_culled_meshes = 0;
+	};
+
 protected:
 	glm::mat4 _view_mat = glm::mat4(1.0); // view matrix
 	glm::mat4 _proj_mat = glm::mat4(1.0); // projection matrix
@@ -29,6 +52,10 @@ protected:
 	float _fov = glm::radians(35.0f); // field of view in radians
 	float _min_render_dist = 0.01f; // minimum render distance
 	float _max_render_dist = 1000.0f; // maximum render distance
+	Frustum _frustum; // of the projview matrix
+
+	// counted by the const tests, which don't change the Camera's view.
+	mutable CullingStats _culling_stats;
 
 public:
 	// ctor. sets the position.
@@ -47,9 +74,47 @@ public:
 	// with the view having the Camera's position stripped.
 	inline const glm::mat4 &get_skybox_mat() const { return _skybox_mat; }
 
+	// returns the planes of the Camera's view volume.
+	inline const Frustum &get_frustum() const { return _frustum; }
+
+	// returns true if the <bounds> of a model, transformed by its <model_mat>,
+	// are at least partly in the Camera's view.
+	// the result is counted in the CullingStats.
+	bool is_model_visible(
+		const Bounds &bounds, const glm::mat4 &model_mat
+	) const;
+
+	// returns true if the <bounds> of a Mesh, transformed by its <model_mat>,
+	// are at least partly in the Camera's view.
+	// the result is counted in the CullingStats.
+	bool is_mesh_visible(
+		const Bounds &bounds, const glm::mat4 &model_mat
+	) const;
+
+	inline const CullingStats &get_culling_stats() const {
+		return _culling_stats;
+	}
+	inline void reset_culling_stats() { _culling_stats = CullingStats(); }
+
 	// returns the Camera's field of view in radians.
 	inline const float &get_field_of_view() const { return _fov; }
 
+	// returns the distances to the near and far planes.
+	inline const float &get_min_render_distance() const {
+		return _min_render_dist;
+	}
+	inline const float &get_max_render_distance() const {
+		return _max_render_dist;
+	}
+
+	// returns true if the Camera uses orthographic projection.
+	inline bool is_orthographic() const { return _orthographic; }
+
+	// returns the glViewport(...) x, y, width and height of the Camera.
+	inline glm::ivec4 get_viewport() const {
+		return glm::ivec4(_render_x, _render_y, _render_w, _render_h);
+	}
+
 	// sets the projection matrix to use perspective projection.
 	inline void use_perspective_projection() {
 		_set_ortho_projection(false);
@@ -0,0 +1,250 @@
+#include "deferred_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <glm/matrix.hpp>
+#include "light_clusters.hpp"
+#include "../shader/uniform_blocks.hpp"
+#include "../system/gl_state.hpp"
+
+static const std::filesystem::path AMBIENT_SHADER_V_PATH = (
+	"guru/shader/default_glsl/deferred_ambient_shader.v_shader"
+);
+static const std::filesystem::path AMBIENT_SHADER_F_PATH = (
+	"guru/shader/default_glsl/deferred_ambient_shader.f_shader"
+);
+static const std::filesystem::path LIGHT_SHADER_V_PATH = (
+	"guru/shader/default_glsl/deferred_light_shader.v_shader"
+);
+static const std::filesystem::path LIGHT_SHADER_F_PATH = (
+	"guru/shader/default_glsl/deferred_light_shader.f_shader"
+);
+
+// the detail of the sphere drawn around each light's range.
+static const int SPHERE_SEGMENTS = 16; // around the equator
+static const int SPHERE_RINGS = 8; // from pole to pole
+
+namespace gu {
+DeferredRenderer::~DeferredRenderer() {
+	deallocate();
+}
+
+bool DeferredRenderer::init(const int &width, const int &height) {
+	if (not is_initialized()) {
+		bool built = (
+			    _ambient_shader.build_from_files(
+				AMBIENT_SHADER_V_PATH, AMBIENT_SHADER_F_PATH
+			)
+			and _light_shader.build_from_files(
+				LIGHT_SHADER_V_PATH, LIGHT_SHADER_F_PATH
+			)
+		);
+		if (not built)
+			return false;
+		_create_geometry();
+	}
+	return _gbuffer.create(width, height);
+}
+
+void DeferredRenderer::begin_geometry_pass() {
+	_gbuffer.bind_and_clear();
+}
+
+void DeferredRenderer::light(
+	const GLuint &framebuffer_ID,
+	const Camera &camera,
+	const std::vector<PointLight *> &point_lights,
+	const std::vector<SpotLight *> &spot_lights,
+	const Color &clear_color
+) {
+	_stats = Stats();
+	if (not is_initialized())
+		return;
+
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, framebuffer_ID);
+	glm::ivec4 viewport = camera.get_viewport();
+	glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+	glm::mat4 inv_PV_mat = glm::inverse(camera.get_projview());
+	UniformBlocks::update_camera(camera);
+	UniformBlocks::upload_lights();
+	_gbuffer.bind_textures(DeferredShader::GBUFFER_TEXTURE_UNIT);
+
+	// lights every pixel with the ambient color and the DirLights,
+	// writing the GBuffer's depth so that the forward-shaded passes
+	// are hidden behind the opaque geometry.
+	GLState::set_blend(false);
+	GLState::set_cull_face(GL_NONE);
+	GLState::set_depth_test(true);
+	GLState::set_depth_func(GL_ALWAYS);
+	glDepthMask(GL_TRUE);
+	_ambient_shader.use();
+	_ambient_shader.set_inv_PV_mat(inv_PV_mat);
+	_ambient_shader.set_viewport(glm::vec4(viewport));
+	_ambient_shader.set_clear_color(clear_color.as_rgb());
+	GLState::bind_VAO(_empty_VAO_ID);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	GLState::set_depth_func(GL_LESS);
+
+	_light_data.clear();
+	for (PointLight *light : point_lights)
+		LightClusters::push_light_texels(_light_data, *light, _light_threshold);
+	for (SpotLight *light : spot_lights)
+		LightClusters::push_light_texels(_light_data, *light, _light_threshold);
+	_stats.n_light_volumes = _light_data.size() / LightClusters::LIGHT_TEXELS;
+	if (_stats.n_light_volumes == 0) {
+		// restores the face culling that the forward-shaded passes expect.
+		GLState::set_cull_face(GL_BACK);
+		return;
+	}
+	_upload_lights();
+
+	// adds each light by drawing the back faces of the sphere
+	// around its range, which covers every pixel it reaches once
+	// whether or not the Camera is inside of the sphere.
+	// depth clamping keeps the far side of large spheres from being clipped.
+	GLState::set_depth_test(false);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_DEPTH_CLAMP);
+	GLState::set_blend(true);
+	GLState::set_blend_func(GL_ONE, GL_ONE);
+	GLState::set_cull_face(GL_FRONT);
+	_light_shader.use();
+	_light_shader.set_inv_PV_mat(inv_PV_mat);
+	_light_shader.set_viewport(glm::vec4(viewport));
+	GLState::bind_VAO(_sphere_VAO_ID);
+	glDrawElementsInstanced(
+		GL_TRIANGLES,
+		_n_sphere_indices,
+		GL_UNSIGNED_INT,
+		nullptr,
+		static_cast<GLsizei>(_stats.n_light_volumes)
+	);
+
+	// restores the state that the forward-shaded passes expect.
+	glDisable(GL_DEPTH_CLAMP);
+	glDepthMask(GL_TRUE);
+	GLState::set_blend(false);
+	GLState::set_depth_test(true);
+	GLState::set_cull_face(GL_BACK);
+}
+
+void DeferredRenderer::deallocate() {
+	_gbuffer.deallocate();
+	if (_lights_texture_ID != 0) {
+		glDeleteTextures(1, &_lights_texture_ID);
+		GLState::forget_texture(_lights_texture_ID);
+	}
+	if (_lights_buffer_ID != 0)
+		glDeleteBuffers(1, &_lights_buffer_ID);
+	if (_sphere_EBO_ID != 0)
+		glDeleteBuffers(1, &_sphere_EBO_ID);
+	if (_sphere_VBO_ID != 0)
+		glDeleteBuffers(1, &_sphere_VBO_ID);
+	if (_sphere_VAO_ID != 0) {
+		glDeleteVertexArrays(1, &_sphere_VAO_ID);
+		GLState::forget_VAO(_sphere_VAO_ID);
+	}
+	if (_empty_VAO_ID != 0) {
+		glDeleteVertexArrays(1, &_empty_VAO_ID);
+		GLState::forget_VAO(_empty_VAO_ID);
+	}
+	_lights_texture_ID = 0;
+	_lights_buffer_ID = 0;
+	_lights_capacity = 0;
+	_sphere_EBO_ID = 0;
+	_sphere_VBO_ID = 0;
+	_sphere_VAO_ID = 0;
+	_empty_VAO_ID = 0;
+	_n_sphere_indices = 0;
+}
+
+void DeferredRenderer::_create_geometry() {
+	// the full-screen triangle is made from gl_VertexID,
+	// but a VAO still has to be bound to draw it.
+	glGenVertexArrays(1, &_empty_VAO_ID);
+
+	// builds a sphere that's pushed out enough that its flat faces
+	// still contain the unit sphere.
+	const float pi = 3.14159265f;
+	float scale = 1.0f / (
+		  std::cos(pi / SPHERE_SEGMENTS)
+		* std::cos(pi / (2 * SPHERE_RINGS))
+	);
+	std::vector<float> positions;
+	for (int ring = 0; ring <= SPHERE_RINGS; ++ring) {
+		float polar = pi * ring / SPHERE_RINGS;
+		for (int segment = 0; segment <= SPHERE_SEGMENTS; ++segment) {
+			float azimuth = 2.0f * pi * segment / SPHERE_SEGMENTS;
+			positions.push_back(std::sin(polar) * std::cos(azimuth) * scale);
+			positions.push_back(std::cos(polar) * scale);
+			positions.push_back(std::sin(polar) * std::sin(azimuth) * scale);
+		}
+	}
+
+	std::vector<GLuint> indices;
+	for (int ring = 0; ring < SPHERE_RINGS; ++ring) {
+		for (int segment = 0; segment < SPHERE_SEGMENTS; ++segment) {
+			GLuint a = ring * (SPHERE_SEGMENTS + 1) + segment;
+			GLuint b = a + SPHERE_SEGMENTS + 1;
+			indices.insert(indices.end(), {a, a + 1, b, b, a + 1, b + 1});
+		}
+	}
+	_n_sphere_indices = static_cast<GLsizei>(indices.size());
+
+	glGenVertexArrays(1, &_sphere_VAO_ID);
+	glGenBuffers(1, &_sphere_VBO_ID);
+	glGenBuffers(1, &_sphere_EBO_ID);
+	GLState::bind_VAO(_sphere_VAO_ID);
+	glBindBuffer(GL_ARRAY_BUFFER, _sphere_VBO_ID);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		positions.size() * sizeof(float),
+		positions.data(),
+		GL_STATIC_DRAW
+	);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _sphere_EBO_ID);
+	glBufferData(
+		GL_ELEMENT_ARRAY_BUFFER,
+		indices.size() * sizeof(GLuint),
+		indices.data(),
+		GL_STATIC_DRAW
+	);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+	GLState::bind_VAO(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// every light is LightClusters::LIGHT_TEXELS texels of the buffer.
+	glGenBuffers(1, &_lights_buffer_ID);
+	glGenTextures(1, &_lights_texture_ID);
+	_upload_lights();
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _lights_buffer_ID);
+}
+
+void DeferredRenderer::_upload_lights() {
+	// orphans the old storage so that the draws still reading it
+	// don't stall the upload.
+	_lights_capacity = std::max(_lights_capacity, size_t(64));
+	while (_lights_capacity < _light_data.size())
+		_lights_capacity *= 2;
+	glBindBuffer(GL_TEXTURE_BUFFER, _lights_buffer_ID);
+	glBufferData(
+		GL_TEXTURE_BUFFER,
+		_lights_capacity * sizeof(glm::vec4),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+	glBufferSubData(
+		GL_TEXTURE_BUFFER,
+		0,
+		_light_data.size() * sizeof(glm::vec4),
+		_light_data.data()
+	);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	GLState::bind_texture(
+		DeferredShader::LIGHTS_TEXTURE_UNIT,
+		GL_TEXTURE_BUFFER,
+		_lights_texture_ID
+	);
+}
+} // namespace gu
\ No newline at end of file
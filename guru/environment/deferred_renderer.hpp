@@ -0,0 +1,124 @@
+/**
+ * deferred_renderer.hpp
+ * ---
+ * this file defines the DeferredRenderer class, which lights
+ * the opaque geometry drawn to its GBuffer once per pixel,
+ * instead of once per drawn fragment like forward shading.
+ *
+ * ---
+ * a frame is drawn in passes:
+ * 1. the opaque geometry is drawn to the GBuffer after
+ *    begin_geometry_pass(), using a ModelShader built from
+ *    "gbuffer_shader.v_shader" and "gbuffer_shader.f_shader",
+ *    which reads the same uniforms as the other ModelShaders.
+ * 2. light(...) draws a full-screen pass to the bound framebuffer
+ *    with the ambient color and the DirLights of the "LightBlock",
+ *    which also copies the GBuffer's depth to the framebuffer.
+ *    each PointLight and SpotLight is then added by drawing
+ *    a sphere around its range, so only the pixels it reaches are lit.
+ * 3. the skybox and the transparent geometry are drawn
+ *    with forward shading afterwards, depth-tested against
+ *    the copied depth, so a multisampled Screenbuffer still
+ *    antialiases them before the frame is displayed.
+ *
+ * ---
+ * the env uses a DeferredRenderer when its render mode
+ * is set to env::DEFERRED_RENDERING.
+ *
+ */
+
+#pragma once
+#include <vector>
+#include <glad/gl.h>
+#include <glm/vec4.hpp>
+#include "camera.hpp"
+#include "lights.hpp"
+#include "../resources/color.hpp"
+#include "../shader/deferred_shader.hpp"
+#include "../system/gbuffer.hpp"
+
+namespace gu {
+class DeferredRenderer {
+public:
+	/**
+	 * DeferredRenderer::Stats
+	 * ---
+	 * this struct counts the work done by the last call to light(...).
+	 *
+	 */
+	struct Stats {
+		size_t n_light_volumes = 0;
+	};
+
+private:
+	GBuffer _gbuffer;
+	DeferredShader _ambient_shader; // full-screen pass
+	DeferredShader _light_shader; // light volumes
+	GLuint _empty_VAO_ID = 0; // for the full-screen triangle
+	GLuint _sphere_VAO_ID = 0;
+	GLuint _sphere_VBO_ID = 0;
+	GLuint _sphere_EBO_ID = 0;
+	GLsizei _n_sphere_indices = 0;
+	GLuint _lights_buffer_ID = 0;
+	GLuint _lights_texture_ID = 0;
+	size_t _lights_capacity = 0; // in texels
+	std::vector<glm::vec4> _light_data;
+	float _light_threshold = 1.0f / 256.0f;
+	Stats _stats;
+
+public:
+	// dtor. deletes the resources.
+	~DeferredRenderer();
+
+	// returns true if the shaders were built and the GBuffer
+	// was created with the given <width> and <height>.
+	// this does nothing but resize the GBuffer if it's already initialized.
+	bool init(const int &width, const int &height);
+
+	// returns true if the DeferredRenderer has been initialized.
+	inline bool is_initialized() const { return _empty_VAO_ID != 0; }
+
+	// reallocates the GBuffer for the given <width> and <height>.
+	inline bool resize(const int &width, const int &height) {
+		return _gbuffer.create(width, height);
+	}
+
+	inline const GBuffer &get_gbuffer() const { return _gbuffer; }
+
+	// sets the fraction of a light's brightest color
+	// below which its light is cut off, which decides the size of its volume.
+	inline void set_light_threshold(const float &threshold) {
+		_light_threshold = threshold;
+	}
+
+	// clears and binds the GBuffer so that the opaque geometry is drawn to it.
+	void begin_geometry_pass();
+
+	// binds the framebuffer with the <framebuffer_ID> and lights
+	// the GBuffer from the <camera>'s view into it,
+	// with the <point_lights> and <spot_lights> drawn as volumes.
+	// pixels with no geometry are given the <clear_color>.
+	// the framebuffer is left bound for the forward-shaded passes.
+	void light(
+		const GLuint &framebuffer_ID,
+		const Camera &camera,
+		const std::vector<PointLight *> &point_lights,
+		const std::vector<SpotLight *> &spot_lights,
+		const Color &clear_color
+	);
+
+	// returns the counts of the last call to light(...).
+	inline const Stats &get_stats() const { return _stats; }
+
+	// deletes the shaders' buffers, the sphere and the GBuffer.
+	void deallocate();
+
+private:
+	// creates the VAOs and buffers of the full-screen triangle,
+	// the light volume sphere and the light texture buffer.
+	void _create_geometry();
+
+	// sends the <_light_data> to the light texture buffer.
+	void _upload_lights();
+};
+} // namespace gu
\ No newline at end of file
@@ -4,7 +4,9 @@
 #pragma comment(lib, "dwmapi.lib")
 #endif
 #include "environment.hpp"
+#include "../system/gl_task_queue.hpp"
 #include "../system/settings.hpp"
+#include "../system/thread_pool.hpp"
 #include <iostream>
 
 static const std::filesystem::path DEF_SCREEN_SHADER_V_PATH = (
@@ -28,6 +30,9 @@ GLuint env::_skybox_VAO_ID = 0;
 GLuint env::_skybox_VBO_ID = 0;
 std::vector<Camera> env::_cameras;
 Screenbuffer env::_screenbuffer;
+env::RENDER_MODE env::_render_mode = env::FORWARD_RENDERING;
+DeferredRenderer env::_deferred_renderer;
+AnimationSystem env::_animation_system;
 Color env::_clear_color = gu::Color(0.3f, 0.3f, 0.3f);
 ScreenShader env::_default_screen_shader;
 SkyboxShader env::_default_skybox_shader;
@@ -52,31 +57,45 @@ bool init_glad() {
 		std::cerr << "glad failed to initialize." << std::endl;
 		return false;
 	}
-	glEnable(GL_DEPTH_TEST);
+	GLState::invalidate();
+	GLState::set_depth_test(true);
 	glEnable(GL_MULTISAMPLE);
-	glDepthFunc(GL_LESS);
+	GLState::set_depth_func(GL_LESS);
 	return true;
 }
 
 void terminate() {
+	// stops background loading before any resources are deallocated.
+	ThreadPool::thread_pool.shutdown();
+	GLTaskQueue::clear();
+
 	model_res_list.deallocate();
 	material_list.deallocate();
 	texture_list.deallocate();
+	res::GeometryArena::geometry_arena.deallocate();
+	UniformBlocks::deallocate();
+	res::BonePalette::bone_palette.deallocate();
+	env::_deferred_renderer.deallocate();
 
 	if (env::_screen_display_VBO_ID != 0)
 		glDeleteBuffers(1, &env::_screen_display_VBO_ID);
-	if (env::_screen_display_VAO_ID != 0)
+	if (env::_screen_display_VAO_ID != 0) {
 		glDeleteVertexArrays(1, &env::_screen_display_VAO_ID);
+		GLState::forget_VAO(env::_screen_display_VAO_ID);
+	}
 	env::_screen_display_VBO_ID = 0;
 	env::_screen_display_VAO_ID = 0;
 
 	if (env::_skybox_VBO_ID != 0)
 		glDeleteBuffers(1, &env::_skybox_VBO_ID);
-	if (env::_skybox_VAO_ID != 0)
+	if (env::_skybox_VAO_ID != 0) {
 		glDeleteVertexArrays(1, &env::_skybox_VAO_ID);
+		GLState::forget_VAO(env::_skybox_VAO_ID);
+	}
 	env::_skybox_VBO_ID = 0;
 	env::_skybox_VAO_ID = 0;
 
+	GLState::invalidate();
 	glfwTerminate();
 }
 
@@ -109,6 +128,7 @@ void env::reset() {
 	set_clear_color(gu::Color(0.3f, 0.3f, 0.3f));
 	std::vector<Camera>().swap(_cameras);
 	create_camera();
+	_animation_system.clear();
 }
 
 // creates the VAO and VBO for the rectangle used to show the <_screenbuffer>.
@@ -129,7 +149,7 @@ void env::_create_screen_display() {
 	// creates and binds the VAO and VBO.
 	glGenVertexArrays(1, &_screen_display_VAO_ID);
 	glGenBuffers(1, &_screen_display_VBO_ID);
-	glBindVertexArray(_screen_display_VAO_ID);
+	GLState::bind_VAO(_screen_display_VAO_ID);
 	glBindBuffer(GL_ARRAY_BUFFER, _screen_display_VBO_ID);
 
 	// transfers data to video card.
@@ -145,7 +165,7 @@ void env::_create_screen_display() {
 
 	// disconnects the VAO and VBO from the system.
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::bind_VAO(0);
 }
 
 // creates the VAO and VBO for the cube used to render the skybox.
@@ -171,7 +191,7 @@ void env::_create_skybox() {
 	// creates and binds the VAO and VBO.
 	glGenVertexArrays(1, &_skybox_VAO_ID);
 	glGenBuffers(1, &_skybox_VBO_ID);
-	glBindVertexArray(_skybox_VAO_ID);
+	GLState::bind_VAO(_skybox_VAO_ID);
 	glBindBuffer(GL_ARRAY_BUFFER, _skybox_VBO_ID);
 
 	// transfers data to video card.
@@ -184,7 +204,7 @@ void env::_create_skybox() {
 
 	// disconnects the VAO and VBO from the system.
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::bind_VAO(0);
 }
 
 Camera &env::get_camera(int index) {
@@ -198,6 +218,21 @@ size_t env::create_camera() {
 	return _cameras.size() - 1;
 }
 
+bool env::set_render_mode(const RENDER_MODE &mode) {
+	if (mode == DEFERRED_RENDERING) {
+		int width, height;
+		glfwGetWindowSize(_window->get_GLFWwindow(), &width, &height);
+		if (not _deferred_renderer.init(width, height)) {
+			std::cerr << "env: the DeferredRenderer failed to be initialized."
+				<< std::endl;
+			_render_mode = FORWARD_RENDERING;
+			return false;
+		}
+	}
+	_render_mode = mode;
+	return true;
+}
+
 void env::activate_MSAA(uint8_t n_multisamples) {
 	_screenbuffer.set_n_samples(n_multisamples);
 	int width, height;
@@ -221,19 +256,33 @@ void env::draw_skybox(
 ) {
 	skybox_shader.use();
 	skybox_shader.set_PV_mat_4fv(cam_skybox_mat);
-	glActiveTexture(GL_TEXTURE0 + Material::MAP_TYPE::SKYBOX);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap_ID);
-	glDisable(GL_CULL_FACE);
-	glDepthFunc(GL_LEQUAL);
-	glBindVertexArray(_skybox_VAO_ID);
+	GLState::bind_texture(
+		Material::MAP_TYPE::SKYBOX, GL_TEXTURE_CUBE_MAP, cubemap_ID
+	);
+	GLState::set_cull_face(GL_NONE);
+	GLState::set_depth_func(GL_LEQUAL);
+	GLState::bind_VAO(_skybox_VAO_ID);
 	glDrawArrays(GL_TRIANGLES, 0, 36);
-	glDepthFunc(GL_LESS);
-	glBindVertexArray(0);
+	GLState::set_depth_func(GL_LESS);
 }
 
 void env::poll_events_and_update_delta() {
 	glfwPollEvents();
 	gu::Delta::update();
+	res::BonePalette::bone_palette.clear();
+	for (Camera &camera : _cameras)
+		camera.reset_culling_stats();
+	GLTaskQueue::run(Settings::get_GL_upload_budget());
+}
+
+void env::update_animations() {
+	_animation_system.update();
+	res::BonePalette::bone_palette.upload();
+}
+
+void env::update_animations(const Camera &camera) {
+	_animation_system.update(camera);
+	res::BonePalette::bone_palette.upload();
 }
 
 // clears the default buffer and
@@ -243,6 +292,25 @@ void env::clear_window_and_screenbuffer() {
 		_screenbuffer.bind_and_clear(_clear_color);
 	else
 		_window->clear();
+
+	if (_render_mode == DEFERRED_RENDERING)
+		_deferred_renderer.begin_geometry_pass();
+}
+
+void env::light_deferred_frame(
+	const Camera &camera,
+	const std::vector<PointLight *> &point_lights,
+	const std::vector<SpotLight *> &spot_lights
+) {
+	if (_render_mode != DEFERRED_RENDERING)
+		return;
+
+	GLuint framebuffer_ID = (
+		_screenbuffer.is_used() ? _screenbuffer.get_image_ID() : 0
+	);
+	_deferred_renderer.light(
+		framebuffer_ID, camera, point_lights, spot_lights, _clear_color
+	);
 }
 
 void env::display_frame() {
@@ -258,14 +326,13 @@ void env::display_frame(const ScreenShader &screen_shader) {
 
 	if (_screenbuffer.is_used()) {
 		_blit_frame_to_buffer();
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
 		glClear(GL_COLOR_BUFFER_BIT);
-		glDisable(GL_DEPTH_TEST);
+		GLState::set_depth_test(false);
 
 		screen_shader.use();
-		glBindVertexArray(_screen_display_VAO_ID);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, _screenbuffer.get_screen_ID());
+		GLState::bind_VAO(_screen_display_VAO_ID);
+		GLState::bind_texture(0, GL_TEXTURE_2D, _screenbuffer.get_screen_ID());
 		glDrawArrays(GL_TRIANGLES, 0, 6);
 	}
 
@@ -283,17 +350,23 @@ void env::_screenbuffer_size_callback(
 
 	if (_screenbuffer.is_used())
 		_screenbuffer.create(width, height);
+	if (_render_mode == DEFERRED_RENDERING)
+		_deferred_renderer.resize(width, height);
 
 	for (int i = 0; i < _cameras.size(); ++i)
 		get_camera(i).framebuffer_size_callback(width, height);
 }
 
 void env::_blit_frame_to_buffer() {
-	glDisable(GL_CULL_FACE);
+	GLState::set_cull_face(GL_NONE);
 	glPolygonMode(GL_BACK, GL_FILL);
 
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, _screenbuffer.get_image_ID());
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _screenbuffer.get_inter_ID());
+	GLState::bind_framebuffer(
+		GL_READ_FRAMEBUFFER, _screenbuffer.get_image_ID()
+	);
+	GLState::bind_framebuffer(
+		GL_DRAW_FRAMEBUFFER, _screenbuffer.get_inter_ID()
+	);
 	const GLsizei &w = _screenbuffer.get_width();
 	const GLsizei &h = _screenbuffer.get_height();
 	glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
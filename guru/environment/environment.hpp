@@ -9,14 +9,22 @@
 
 #pragma once
 #include "camera.hpp"
+#include "deferred_renderer.hpp"
+#include "light_clusters.hpp"
+#include "render_queue.hpp"
+#include "scene_tree.hpp"
+#include "shadow_maps.hpp"
 #include "../mathmatics/transformation.hpp"
+#include "../resources/animation/animation_system.hpp"
 #include "../resources/animation/animator.hpp"
+#include "../resources/animation/bone_palette.hpp"
 #include "../resources/material/material_list.hpp"
 #include "../resources/model/model_list.hpp"
 #include "../resources/texture/load_texture.hpp"
 #include "../resources/texture/texture_list.hpp"
 #include "../shader/light_shader.hpp"
 #include "../shader/screen_shader.hpp"
+#include "../shader/shader_variants.hpp"
 #include "../shader/skybox_shader.hpp"
 #include "../system/screenbuffer.hpp"
 #include "../system/window.hpp"
@@ -38,6 +46,13 @@ bool init_glad();
 void terminate();
 
 class env {
+public:
+	// the ways that the opaque geometry of a frame can be shaded.
+	enum RENDER_MODE : uint8_t {
+		FORWARD_RENDERING,
+		DEFERRED_RENDERING,
+	};
+
 private:
 	static Window *_window;
 	static GLuint _screen_display_VAO_ID; // screenbuffer display
@@ -46,6 +61,9 @@ private:
 	static GLuint _skybox_VBO_ID;
 	static std::vector<Camera> _cameras;
 	static Screenbuffer _screenbuffer;
+	static RENDER_MODE _render_mode;
+	static DeferredRenderer _deferred_renderer;
+	static AnimationSystem _animation_system;
 	static Color _clear_color;
 	static ScreenShader _default_screen_shader;
 	static SkyboxShader _default_skybox_shader;
@@ -80,6 +98,20 @@ public:
 		_clear_color = color;
 	}
 
+	// sets how the opaque geometry is shaded.
+	// with DEFERRED_RENDERING, clear_window_and_screenbuffer() binds
+	// the DeferredRenderer's GBuffer, which the opaque geometry is drawn to
+	// before light_deferred_frame(...) lights it into the Screenbuffer.
+	// returns false and keeps FORWARD_RENDERING if the DeferredRenderer
+	// couldn't be initialized.
+	static bool set_render_mode(const RENDER_MODE &mode);
+
+	inline static RENDER_MODE get_render_mode() { return _render_mode; }
+
+	inline static DeferredRenderer &get_deferred_renderer() {
+		return _deferred_renderer;
+	}
+
 	// turns on MSAA antialiasing, which will utilize the Screenbuffer.
 	// giving 0 for <n_multisamples> will turn the Screenbuffer off.
 	static void activate_MSAA(uint8_t n_multisamples);
@@ -99,11 +131,46 @@ public:
 	);
 
 	// polls the Window for events and updates the delta time.
+	// OpenGL uploads queued by resources loading in the background
+	// are then run for up to Settings::get_GL_upload_budget() seconds.
 	static void poll_events_and_update_delta();
 
+	// returns the AnimationSystem that's updated by update_animations(...).
+	inline static AnimationSystem &get_animation_system() {
+		return _animation_system;
+	}
+
+	// updates every Animator added to the AnimationSystem,
+	// writing their final bone matrices to the BonePalette,
+	// and then sends the BonePalette to the videocard with one call.
+	// each Animator is then drawn with its palette offset
+	// (see ModelShader::set_bone_palette(...)).
+	// this should be called once per frame after polling events
+	// and after any other palettes have been pushed.
+	static void update_animations();
+
+	// updates the animations like above after each Animator
+	// picks its LOD_LEVEL from how it appears to the <camera>.
+	static void update_animations(const Camera &camera);
+
 	// sets up the Window and Screenbuffer for drawing.
 	static void clear_window_and_screenbuffer();
 
+	// lights the opaque geometry drawn to the GBuffer from the <camera>'s
+	// view into the Screenbuffer (or the Window if it isn't used)
+	// with the <point_lights> and <spot_lights>.
+	// the skybox and transparent geometry are drawn afterwards.
+	// this does nothing with FORWARD_RENDERING.
+	static void light_deferred_frame(
+		const Camera &camera,
+		const std::vector<PointLight *> &point_lights = (
+			std::vector<PointLight *>()
+		),
+		const std::vector<SpotLight *> &spot_lights = (
+			std::vector<SpotLight *>()
+		)
+	);
+
 	// displays the frame after everything has been drawn.
 	// the frame is drawn using a default ScreenShader.
 	static void display_frame();
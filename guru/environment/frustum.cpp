@@ -0,0 +1,133 @@
+#include "frustum.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(GURU_SIMD_CULLING)
+#include <xmmintrin.h>
+#endif
+
+namespace gu {
+void Frustum::set(const glm::mat4 &projview) {
+	// each plane is the last row of the matrix plus or minus another row.
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; ++i)
+		rows[i] = glm::vec4(
+			projview[0][i], projview[1][i], projview[2][i], projview[3][i]
+		);
+
+	for (size_t i = 0; i < N_PLANES; ++i) {
+		float sign = i % 2 == 0 ? 1.0f : -1.0f;
+		glm::vec4 plane = rows[3] + sign * rows[i / 2];
+
+		// normalizes the plane so that distances are in world units.
+		float length = std::sqrt(
+			plane.x * plane.x + plane.y * plane.y + plane.z * plane.z
+		);
+		if (length > 0.0f)
+			plane /= length;
+		_x[i] = plane.x;
+		_y[i] = plane.y;
+		_z[i] = plane.z;
+		_w[i] = plane.w;
+	}
+}
+
+bool Frustum::intersects_sphere(
+	const glm::vec3 &center, const float &radius
+) const {
+	return get_min_distance(center, glm::vec3(0.0f), radius) >= 0.0f;
+}
+
+bool Frustum::intersects_box(const glm::vec3 &min, const glm::vec3 &max) const {
+	glm::vec3 center = (min + max) * 0.5f;
+	return get_min_distance(center, max - center, 0.0f) >= 0.0f;
+}
+
+bool Frustum::contains_box(const glm::vec3 &min, const glm::vec3 &max) const {
+	glm::vec3 center = (min + max) * 0.5f;
+	return get_min_distance(center, center - max, 0.0f) >= 0.0f;
+}
+
+bool Frustum::intersects(const Bounds &bounds) const {
+	if (bounds.is_empty())
+		return false;
+
+	// a sphere entirely in front of every plane is inside,
+	// and one entirely behind any plane is outside.
+	float center_dist = get_min_distance(bounds.center, glm::vec3(0.0f), 0.0f);
+	if (center_dist >= bounds.radius)
+		return true;
+	if (center_dist < -bounds.radius)
+		return false;
+	return intersects_box(bounds.min, bounds.max);
+}
+
+#if defined(GURU_SIMD_CULLING)
+float Frustum::get_min_distance(
+	const glm::vec3 &center, const glm::vec3 &extents, const float &radius
+) const {
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+	const __m128 cx = _mm_set1_ps(center.x);
+	const __m128 cy = _mm_set1_ps(center.y);
+	const __m128 cz = _mm_set1_ps(center.z);
+	const __m128 ex = _mm_set1_ps(extents.x);
+	const __m128 ey = _mm_set1_ps(extents.y);
+	const __m128 ez = _mm_set1_ps(extents.z);
+	const __m128 r = _mm_set1_ps(radius);
+
+	// the distance of the center plus the box's extents
+	// along each plane's normal, plus the radius.
+	__m128 min_dist = _mm_set1_ps(INFINITY);
+	for (size_t i = 0; i < N_PADDED_PLANES; i += 4) {
+		__m128 nx = _mm_load_ps(_x + i);
+		__m128 ny = _mm_load_ps(_y + i);
+		__m128 nz = _mm_load_ps(_z + i);
+		__m128 dist = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+			_mm_add_ps(_mm_mul_ps(nz, cz), _mm_load_ps(_w + i))
+		);
+		__m128 reach = _mm_add_ps(
+			_mm_add_ps(
+				_mm_mul_ps(_mm_andnot_ps(sign_mask, nx), ex),
+				_mm_mul_ps(_mm_andnot_ps(sign_mask, ny), ey)
+			),
+			_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, nz), ez), r)
+		);
+		min_dist = _mm_min_ps(min_dist, _mm_add_ps(dist, reach));
+	}
+
+	// finds the smallest of the four lanes.
+	min_dist = _mm_min_ps(
+		min_dist, _mm_shuffle_ps(min_dist, min_dist, _MM_SHUFFLE(2, 3, 0, 1))
+	);
+	min_dist = _mm_min_ps(
+		min_dist, _mm_shuffle_ps(min_dist, min_dist, _MM_SHUFFLE(1, 0, 3, 2))
+	);
+	return _mm_cvtss_f32(min_dist);
+}
+#else
+float Frustum::get_min_distance(
+	const glm::vec3 &center, const glm::vec3 &extents, const float &radius
+) const {
+	return get_min_distance_scalar(center, extents, radius);
+}
+#endif
+
+float Frustum::get_min_distance_scalar(
+	const glm::vec3 &center, const glm::vec3 &extents, const float &radius
+) const {
+	// sums in the same order as the SSE lanes do.
+	float min_dist = INFINITY;
+	for (size_t i = 0; i < N_PLANES; ++i) {
+		float dist = (
+			(_x[i] * center.x + _y[i] * center.y)
+			+ (_z[i] * center.z + _w[i])
+		);
+		float reach = (
+			(std::abs(_x[i]) * extents.x + std::abs(_y[i]) * extents.y)
+			+ (std::abs(_z[i]) * extents.z + radius)
+		);
+		min_dist = std::min(min_dist, dist + reach);
+	}
+	return min_dist;
+}
+} // namespace gu
\ No newline at end of file
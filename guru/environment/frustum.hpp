@@ -0,0 +1,86 @@
+/**
+ * frustum.hpp
+ * ---
+ * this file defines the Frustum class, which holds the six planes
+ * of a Camera's view volume and tests Bounds against them.
+ *
+ * ---
+ * the planes are taken from the projection * view matrix
+ * and stored in structure-of-arrays lanes padded to eight,
+ * so with SSE each Bounds is tested against four planes at once.
+ * without SSE, or if GURU_DISABLE_SIMD_CULLING is defined,
+ * the planes are tested one at a time.
+ *
+ */
+
+#pragma once
+#include <cfloat>
+#include <glm/mat4x4.hpp>
+#include "../mathmatics/bounds.hpp"
+
+#if not defined(GURU_DISABLE_SIMD_CULLING) and ( \
+	defined(__SSE__) or defined(_M_X64) or defined(_M_AMD64) \
+	or (defined(_M_IX86_FP) and _M_IX86_FP >= 1) \
+)
+#define GURU_SIMD_CULLING
+#endif
+
+namespace gu {
+class Frustum {
+public:
+	static const size_t N_PLANES = 6;
+
+private:
+	static const size_t N_PADDED_PLANES = 8;
+
+	// the normal (x, y, z) and distance (w) of each plane,
+	// with the normals pointing into the view volume.
+	// the padded planes are as far away as possible,
+	// so they never reject anything or lower the smallest distance.
+	alignas(16) float _x[N_PADDED_PLANES] = {};
+	alignas(16) float _y[N_PADDED_PLANES] = {};
+	alignas(16) float _z[N_PADDED_PLANES] = {};
+	alignas(16) float _w[N_PADDED_PLANES] = {
+		1, 1, 1, 1, 1, 1, FLT_MAX, FLT_MAX
+	};
+
+public:
+	// sets the planes to the view volume of the <projview> matrix.
+	void set(const glm::mat4 &projview);
+
+	// returns true if the sphere at the <center> with the <radius>
+	// is at least partly inside of the view volume.
+	bool intersects_sphere(const glm::vec3 &center, const float &radius) const;
+
+	// returns true if the box from <min> to <max>
+	// is at least partly inside of the view volume.
+	// boxes near the corners of the view volume may be kept
+	// even though they're just outside of it.
+	bool intersects_box(const glm::vec3 &min, const glm::vec3 &max) const;
+
+	// returns true if the box from <min> to <max>
+	// is entirely inside of the view volume.
+	bool contains_box(const glm::vec3 &min, const glm::vec3 &max) const;
+
+	// returns true if the world-space <bounds> are at least partly
+	// inside of the view volume, testing the box
+	// only if the sphere crosses a plane.
+	bool intersects(const Bounds &bounds) const;
+
+	// returns the smallest signed distance from the planes
+	// to the sphere's surface or the box's farthest corner,
+	// which is negative if the sphere or box is entirely behind a plane.
+	// the box is given by its <center> and <extents>.
+	// negative <extents> and <radius> give the distance
+	// to the nearest corner or point of the surface instead.
+	float get_min_distance(
+		const glm::vec3 &center, const glm::vec3 &extents, const float &radius
+	) const;
+
+	// returns the same as get_min_distance(...) one plane at a time,
+	// which is what is used without SSE.
+	float get_min_distance_scalar(
+		const glm::vec3 &center, const glm::vec3 &extents, const float &radius
+	) const;
+};
+} // namespace gu
\ No newline at end of file
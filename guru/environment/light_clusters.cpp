@@ -0,0 +1,390 @@
+#include "light_clusters.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <glm/geometric.hpp>
+#include "../shader/uniform_blocks.hpp"
+#include "../system/gl_state.hpp"
+#include "../system/thread_pool.hpp"
+
+static_assert(sizeof(gu::LightClusters::ClusterData) == 48);
+
+// returns the view-space coordinate along the <axis> (0 for x, 1 for y)
+// of the point at the <ndc> coordinate and the view-space depth <z>
+// that's projected by the <proj_mat>.
+static float unproject(
+	const glm::mat4 &proj_mat,
+	const int &axis,
+	const float &ndc,
+	const float &z
+) {
+	float w = proj_mat[2][3] * z + proj_mat[3][3];
+	return (
+		(ndc * w - proj_mat[2][axis] * z - proj_mat[3][axis])
+		/ proj_mat[axis][axis]
+	);
+}
+
+// returns the view-space depth (positive) where the given <slice> begins.
+static float get_slice_depth(
+	const float &near, const float &far, const size_t &slice
+) {
+	return near * std::pow(
+		far / near, static_cast<float>(slice) / gu::LightClusters::GRID_Z
+	);
+}
+
+// returns the constant, linear and quadratic attenuation of the <light>.
+template <typename T>
+static glm::vec3 get_attenuation(T &light) {
+	return glm::vec3(
+		light.get_constant().get_value(),
+		light.get_linear().get_value(),
+		light.get_quadratic().get_value()
+	);
+}
+
+// pushes back the texels of a light to the <texels> and returns its range,
+// or pushes nothing and returns 0 if the light is too dim.
+// the light is a SpotLight if it has a <direction>.
+static float push_texels(
+	std::vector<glm::vec4> &texels,
+	const glm::vec3 &position,
+	const glm::vec3 &diffuse,
+	const glm::vec3 &specular,
+	const glm::vec3 &attenuation,
+	const glm::vec3 *direction,
+	const glm::vec2 &cutoffs,
+	const int &shadow_layer,
+	const float &threshold
+) {
+	float brightness = std::max({
+		diffuse.x, diffuse.y, diffuse.z, specular.x, specular.y, specular.z
+	});
+	float range = gu::LightClusters::calc_range(
+		attenuation, brightness, threshold
+	);
+	if (range <= 0.0f)
+		return 0.0f;
+
+	float is_spot_light = direction ? 1.0f : 0.0f;
+	texels.emplace_back(position, range);
+	texels.emplace_back(diffuse, is_spot_light);
+	texels.emplace_back(specular, 0.0f);
+	texels.emplace_back(attenuation, 0.0f);
+	texels.emplace_back(direction ? *direction : glm::vec3(0.0f), 0.0f);
+	texels.emplace_back(
+		cutoffs.x, cutoffs.y, static_cast<float>(shadow_layer), 0.0f
+	);
+	return range;
+}
+
+namespace gu {
+LightClusters::~LightClusters() {
+	deallocate();
+}
+
+void LightClusters::build(
+	const Camera &camera,
+	const std::vector<PointLight *> &point_lights,
+	const std::vector<SpotLight *> &spot_lights
+) {
+	_light_data.clear();
+	_view_spheres.clear();
+	for (PointLight *light : point_lights) {
+		if (push_light_texels(_light_data, *light, _light_threshold) > 0.0f)
+			_add_view_sphere(camera);
+	}
+	for (SpotLight *light : spot_lights) {
+		if (push_light_texels(_light_data, *light, _light_threshold) > 0.0f)
+			_add_view_sphere(camera);
+	}
+
+	// the slices are spaced exponentially,
+	// so a depth's slice is log(depth) * scale + bias.
+	float near = std::max(camera.get_min_render_distance(), 1e-4f);
+	float far = std::max(camera.get_max_render_distance(), near * 2.0f);
+	float scale = GRID_Z / std::log(far / near);
+	glm::ivec4 viewport = camera.get_viewport();
+	_cluster_data.viewport = glm::vec4(viewport);
+	_cluster_data.depth = glm::vec4(near, far, scale, -std::log(near) * scale);
+	_cluster_data.dims = glm::ivec4(
+		GRID_X, GRID_Y, GRID_Z, camera.is_orthographic() ? 1 : 0
+	);
+
+	// every slice writes only to its own clusters and indices.
+	_grid.resize(N_CLUSTERS * 2);
+	const glm::mat4 &proj_mat = camera.get_projection();
+	ThreadPool::thread_pool.run_parallel(
+		GRID_Z, [this, &proj_mat](size_t slice) {
+			_bin_slice(proj_mat, slice);
+		}
+	);
+
+	// joins the slices, moving each cluster's offset past the slices before.
+	_indices.clear();
+	_stats = Stats();
+	_stats.n_lights = _view_spheres.size();
+	for (size_t slice = 0; slice < GRID_Z; ++slice) {
+		uint32_t base = static_cast<uint32_t>(_indices.size());
+		size_t first = slice * GRID_X * GRID_Y * 2;
+		for (size_t i = 0; i < GRID_X * GRID_Y; ++i) {
+			_grid[first + i * 2] += base;
+			_stats.max_cluster_lights = std::max(
+				_stats.max_cluster_lights, size_t(_grid[first + i * 2 + 1])
+			);
+		}
+		_indices.insert(
+			_indices.end(),
+			_slice_indices[slice].begin(),
+			_slice_indices[slice].end()
+		);
+	}
+	_stats.n_references = _indices.size();
+
+	_upload(
+		_lights_buffer,
+		GL_RGBA32F,
+		LIGHTS_TEXTURE_UNIT,
+		_light_data.data(),
+		_light_data.size() * sizeof(glm::vec4)
+	);
+	_upload(
+		_grid_buffer,
+		GL_RG32UI,
+		GRID_TEXTURE_UNIT,
+		_grid.data(),
+		_grid.size() * sizeof(uint32_t)
+	);
+	_upload(
+		_indices_buffer,
+		GL_R32UI,
+		INDICES_TEXTURE_UNIT,
+		_indices.data(),
+		_indices.size() * sizeof(uint32_t)
+	);
+
+	if (_cluster_UBO_ID == 0) {
+		glGenBuffers(1, &_cluster_UBO_ID);
+		glBindBuffer(GL_UNIFORM_BUFFER, _cluster_UBO_ID);
+		glBufferData(
+			GL_UNIFORM_BUFFER, sizeof(ClusterData), nullptr, GL_DYNAMIC_DRAW
+		);
+	} else {
+		glBindBuffer(GL_UNIFORM_BUFFER, _cluster_UBO_ID);
+	}
+	glBufferSubData(
+		GL_UNIFORM_BUFFER, 0, sizeof(ClusterData), &_cluster_data
+	);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	bind();
+}
+
+void LightClusters::bind() const {
+	if (_cluster_UBO_ID == 0)
+		return;
+
+	glBindBufferBase(
+		GL_UNIFORM_BUFFER, UniformBlocks::CLUSTER_BINDING, _cluster_UBO_ID
+	);
+	GLState::bind_texture(
+		LIGHTS_TEXTURE_UNIT, GL_TEXTURE_BUFFER, _lights_buffer.texture_ID
+	);
+	GLState::bind_texture(
+		GRID_TEXTURE_UNIT, GL_TEXTURE_BUFFER, _grid_buffer.texture_ID
+	);
+	GLState::bind_texture(
+		INDICES_TEXTURE_UNIT, GL_TEXTURE_BUFFER, _indices_buffer.texture_ID
+	);
+}
+
+float LightClusters::calc_range(
+	const glm::vec3 &attenuation,
+	const float &brightness,
+	const float &threshold
+) {
+	// solves brightness / (c + l * d + q * d^2) = threshold for d.
+	float c = attenuation.x - brightness / std::max(threshold, 1e-6f);
+	float l = attenuation.y;
+	float q = attenuation.z;
+	if (c >= 0.0f)
+		return 0.0f;
+	if (q > 0.0f)
+		return (-l + std::sqrt(l * l - 4.0f * q * c)) / (2.0f * q);
+	if (l > 0.0f)
+		return -c / l;
+	return FLT_MAX; // the light never fades
+}
+
+void LightClusters::deallocate() {
+	_delete(_lights_buffer);
+	_delete(_grid_buffer);
+	_delete(_indices_buffer);
+	if (_cluster_UBO_ID != 0)
+		glDeleteBuffers(1, &_cluster_UBO_ID);
+	_cluster_UBO_ID = 0;
+}
+
+float LightClusters::push_light_texels(
+	std::vector<glm::vec4> &texels,
+	PointLight &point_light,
+	const float &threshold
+) {
+	return push_texels(
+		texels,
+		static_cast<glm::vec3>(point_light.get_position()),
+		point_light.get_diffuse().as_rgb(),
+		point_light.get_specular().as_rgb(),
+		get_attenuation(point_light),
+		nullptr,
+		glm::vec2(0.0f),
+		-1,
+		threshold
+	);
+}
+
+float LightClusters::push_light_texels(
+	std::vector<glm::vec4> &texels,
+	SpotLight &spot_light,
+	const float &threshold
+) {
+	glm::vec3 direction = static_cast<glm::vec3>(spot_light.get_forward());
+	return push_texels(
+		texels,
+		static_cast<glm::vec3>(spot_light.get_position()),
+		spot_light.get_diffuse().as_rgb(),
+		spot_light.get_specular().as_rgb(),
+		get_attenuation(spot_light),
+		&direction,
+		glm::vec2(
+			spot_light.get_inner_cutoff().get_value(),
+			spot_light.get_outer_cutoff().get_value()
+		),
+		spot_light.get_shadow_layer(),
+		threshold
+	);
+}
+
+void LightClusters::_add_view_sphere(const Camera &camera) {
+	const glm::vec4 &position = _light_data[_light_data.size() - LIGHT_TEXELS];
+	ViewSphere sphere;
+	sphere.center = glm::vec3(
+		camera.get_view() * glm::vec4(glm::vec3(position), 1.0f)
+	);
+	sphere.radius = position.w;
+	_view_spheres.push_back(sphere);
+}
+
+void LightClusters::_bin_slice(
+	const glm::mat4 &proj_mat, const size_t &slice
+) {
+	std::vector<uint32_t> &indices = _slice_indices[slice];
+	indices.clear();
+
+	// the slice is between two depths, which are negative along view z.
+	float near = _cluster_data.depth.x;
+	float far = _cluster_data.depth.y;
+	float z_near = -get_slice_depth(near, far, slice);
+	float z_far = -get_slice_depth(near, far, slice + 1);
+
+	// a tile's view-space x only depends on its column and y on its row,
+	// so each cluster's box is a column's x range, a row's y range
+	// and the slice's z range.
+	float col_min[GRID_X], col_max[GRID_X];
+	float row_min[GRID_Y], row_max[GRID_Y];
+	for (size_t x = 0; x < GRID_X; ++x) {
+		float ndc_0 = -1.0f + 2.0f * x / GRID_X;
+		float ndc_1 = -1.0f + 2.0f * (x + 1) / GRID_X;
+		float values[4] = {
+			unproject(proj_mat, 0, ndc_0, z_near),
+			unproject(proj_mat, 0, ndc_0, z_far),
+			unproject(proj_mat, 0, ndc_1, z_near),
+			unproject(proj_mat, 0, ndc_1, z_far),
+		};
+		col_min[x] = *std::min_element(values, values + 4);
+		col_max[x] = *std::max_element(values, values + 4);
+	}
+	for (size_t y = 0; y < GRID_Y; ++y) {
+		float ndc_0 = -1.0f + 2.0f * y / GRID_Y;
+		float ndc_1 = -1.0f + 2.0f * (y + 1) / GRID_Y;
+		float values[4] = {
+			unproject(proj_mat, 1, ndc_0, z_near),
+			unproject(proj_mat, 1, ndc_0, z_far),
+			unproject(proj_mat, 1, ndc_1, z_near),
+			unproject(proj_mat, 1, ndc_1, z_far),
+		};
+		row_min[y] = *std::min_element(values, values + 4);
+		row_max[y] = *std::max_element(values, values + 4);
+	}
+
+	// keeps the lights whose spheres reach the slice's depths.
+	std::vector<uint32_t> slice_lights;
+	for (uint32_t i = 0; i < _view_spheres.size(); ++i) {
+		const ViewSphere &sphere = _view_spheres[i];
+		if (
+			sphere.center.z - sphere.radius <= z_near
+			and sphere.center.z + sphere.radius >= z_far
+		)
+			slice_lights.push_back(i);
+	}
+
+	// tests each light's sphere against each cluster's box.
+	uint32_t *grid = _grid.data() + slice * GRID_X * GRID_Y * 2;
+	for (size_t y = 0; y < GRID_Y; ++y) {
+		for (size_t x = 0; x < GRID_X; ++x) {
+			uint32_t offset = static_cast<uint32_t>(indices.size());
+			for (const uint32_t &i : slice_lights) {
+				const ViewSphere &sphere = _view_spheres[i];
+				glm::vec3 closest = glm::vec3(
+					std::clamp(sphere.center.x, col_min[x], col_max[x]),
+					std::clamp(sphere.center.y, row_min[y], row_max[y]),
+					std::clamp(sphere.center.z, z_far, z_near)
+				);
+				glm::vec3 diff = closest - sphere.center;
+				if (glm::dot(diff, diff) <= sphere.radius * sphere.radius)
+					indices.push_back(i);
+			}
+			uint32_t *cluster = grid + (y * GRID_X + x) * 2;
+			cluster[0] = offset;
+			cluster[1] = static_cast<uint32_t>(indices.size()) - offset;
+		}
+	}
+}
+
+void LightClusters::_upload(
+	TextureBuffer &buffer,
+	const GLenum &format,
+	const GLuint &unit,
+	const void *data,
+	const size_t &n_bytes
+) {
+	if (buffer.buffer_ID == 0) {
+		glGenBuffers(1, &buffer.buffer_ID);
+		glGenTextures(1, &buffer.texture_ID);
+		GLState::bind_texture(unit, GL_TEXTURE_BUFFER, buffer.texture_ID);
+		glTexBuffer(GL_TEXTURE_BUFFER, format, buffer.buffer_ID);
+	}
+
+	// orphans the old storage so that the draws still reading it
+	// don't stall the upload. the texture keeps reading the buffer object
+	// after it's reallocated.
+	buffer.capacity = std::max(buffer.capacity, size_t(256));
+	while (buffer.capacity < n_bytes)
+		buffer.capacity *= 2;
+	glBindBuffer(GL_TEXTURE_BUFFER, buffer.buffer_ID);
+	glBufferData(GL_TEXTURE_BUFFER, buffer.capacity, nullptr, GL_STREAM_DRAW);
+	if (n_bytes > 0)
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, n_bytes, data);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LightClusters::_delete(TextureBuffer &buffer) {
+	if (buffer.texture_ID != 0) {
+		glDeleteTextures(1, &buffer.texture_ID);
+		GLState::forget_texture(buffer.texture_ID);
+	}
+	if (buffer.buffer_ID != 0)
+		glDeleteBuffers(1, &buffer.buffer_ID);
+	buffer = TextureBuffer();
+}
+} // namespace gu
\ No newline at end of file
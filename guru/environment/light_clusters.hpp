@@ -0,0 +1,199 @@
+/**
+ * light_clusters.hpp
+ * ---
+ * this file defines the LightClusters class, which splits the view
+ * of a Camera into a 3D grid of clusters and bins every PointLight
+ * and SpotLight into the clusters that its range reaches,
+ * so that each fragment only lights itself with the lights
+ * of its own cluster instead of with every light in the scene.
+ *
+ * ---
+ * the grid has GRID_X by GRID_Y tiles across the viewport
+ * and GRID_Z depth slices that grow exponentially from the near plane
+ * to the far plane. the slices are binned in parallel
+ * on the ThreadPool, and the results are sent to the videocard
+ * as three texture buffers (samplerBuffer/usamplerBuffer):
+ *
+ * uniform samplerBuffer _cluster_lights; // LIGHT_TEXELS texels per light
+ * uniform usamplerBuffer _cluster_grid; // offset, count per cluster
+ * uniform usamplerBuffer _cluster_indices; // light index per reference
+ *
+ * along with the "ClusterBlock" that's shared by every shader program:
+ *
+ * layout (std140) uniform ClusterBlock {
+ *     vec4 _cluster_viewport; // x, y, width, height
+ *     vec4 _cluster_depth; // near, far, slice scale, slice bias
+ *     ivec4 _cluster_dims; // GRID_X, GRID_Y, GRID_Z, orthographic
+ * };
+ *
+ * each light's texels are:
+ * position (.w is the range), diffuse (.w is 1 for a SpotLight),
+ * specular, attenuation (constant, linear, quadratic),
+ * direction and cutoffs (inner, outer, shadow layer or -1).
+ * see "clustered_light_shader.f_shader".
+ *
+ * ---
+ * a light's range is the distance at which its attenuation
+ * dims its brightest color below the threshold given to
+ * set_light_threshold(...). a SpotLight is binned by the sphere
+ * of its range, which ignores its cone.
+ * the DirLights and the ambient color still come from the "LightBlock".
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <glad/gl.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include "camera.hpp"
+#include "lights.hpp"
+
+namespace gu {
+class LightClusters {
+public:
+	static const size_t GRID_X = 16;
+	static const size_t GRID_Y = 9;
+	static const size_t GRID_Z = 24;
+	static const size_t N_CLUSTERS = GRID_X * GRID_Y * GRID_Z;
+	static const size_t LIGHT_TEXELS = 6; // vec4s per light
+
+	// the texture units the buffers are bound to,
+	// which follow the BakedAnimation's.
+	static constexpr GLuint LIGHTS_TEXTURE_UNIT = 10;
+	static constexpr GLuint GRID_TEXTURE_UNIT = 11;
+	static constexpr GLuint INDICES_TEXTURE_UNIT = 12;
+
+	/**
+	 * LightClusters::Stats
+	 * ---
+	 * this struct counts the results of the last build(...).
+	 *
+	 */
+	struct Stats {
+		size_t n_lights = 0;
+		size_t n_references = 0; // light indices across every cluster
+		size_t max_cluster_lights = 0; // in the busiest cluster
+	};
+
+	// this struct matches the std140 layout of the "ClusterBlock".
+	struct ClusterData {
+		glm::vec4 viewport = glm::vec4(0.0f);
+		glm::vec4 depth = glm::vec4(0.0f);
+		glm::ivec4 dims = glm::ivec4(0);
+	};
+
+private:
+	// a buffer object read by the shaders through a texture.
+	struct TextureBuffer {
+		GLuint buffer_ID = 0;
+		GLuint texture_ID = 0;
+		size_t capacity = 0; // in bytes
+	};
+
+	// a light's range as a sphere in view space.
+	struct ViewSphere {
+		glm::vec3 center = glm::vec3(0.0f);
+		float radius = 0.0f;
+	};
+
+	float _light_threshold = 1.0f / 256.0f;
+	std::vector<glm::vec4> _light_data; // LIGHT_TEXELS per light
+	std::vector<ViewSphere> _view_spheres;
+	std::vector<uint32_t> _grid; // offset, count per cluster
+	std::vector<uint32_t> _indices;
+	std::vector<uint32_t> _slice_indices[GRID_Z]; // filled in parallel
+	ClusterData _cluster_data;
+	Stats _stats;
+
+	TextureBuffer _lights_buffer;
+	TextureBuffer _grid_buffer;
+	TextureBuffer _indices_buffer;
+	GLuint _cluster_UBO_ID = 0;
+
+public:
+	inline LightClusters() {}
+
+	// dtor. deletes the buffers and textures.
+	~LightClusters();
+
+	LightClusters(const LightClusters &) = delete;
+	LightClusters &operator=(const LightClusters &) = delete;
+
+	// sets the fraction of a light's brightest color
+	// below which its light is cut off, which decides its range.
+	// lower thresholds give larger ranges and more lights per cluster.
+	inline void set_light_threshold(const float &threshold) {
+		_light_threshold = threshold;
+	}
+
+	// bins the <point_lights> and <spot_lights> into the clusters
+	// of the <camera>'s view, sends the results to the videocard
+	// and binds them. this should be called once per frame per Camera,
+	// after the Camera and the lights have been updated.
+	void build(
+		const Camera &camera,
+		const std::vector<PointLight *> &point_lights,
+		const std::vector<SpotLight *> &spot_lights
+	);
+
+	// binds the buffers of the last build(...),
+	// for when another LightClusters was bound since.
+	void bind() const;
+
+	// returns the counts of the last build(...).
+	inline const Stats &get_stats() const { return _stats; }
+
+	// returns the range of a light with the given <attenuation>
+	// (constant, linear, quadratic) and the <brightness> of its
+	// brightest color, with the light cut off at the <threshold>.
+	static float calc_range(
+		const glm::vec3 &attenuation,
+		const float &brightness,
+		const float &threshold
+	);
+
+	// pushes back the LIGHT_TEXELS texels of the <point_light>
+	// to the <texels> and returns its range, or pushes nothing
+	// and returns 0 if it's too dim to light anything.
+	static float push_light_texels(
+		std::vector<glm::vec4> &texels,
+		PointLight &point_light,
+		const float &threshold
+	);
+
+	// pushes back the LIGHT_TEXELS texels of the <spot_light>
+	// to the <texels> and returns its range, or pushes nothing
+	// and returns 0 if it's too dim to light anything.
+	static float push_light_texels(
+		std::vector<glm::vec4> &texels,
+		SpotLight &spot_light,
+		const float &threshold
+	);
+
+	// deletes the buffers and textures.
+	void deallocate();
+
+private:
+	// adds the view sphere of the last light pushed to the <_light_data>.
+	void _add_view_sphere(const Camera &camera);
+
+	// bins the lights into the clusters of the depth <slice>.
+	void _bin_slice(const glm::mat4 &proj_mat, const size_t &slice);
+
+	// sends <n_bytes> of the <data> to the <buffer>, creating it
+	// with the given texel <format> if it doesn't exist yet.
+	static void _upload(
+		TextureBuffer &buffer,
+		const GLenum &format,
+		const GLuint &unit,
+		const void *data,
+		const size_t &n_bytes
+	);
+
+	// deletes the <buffer>.
+	static void _delete(TextureBuffer &buffer);
+};
+} // namespace gu
\ No newline at end of file
@@ -1,10 +1,17 @@
 #include "lights.hpp"
 
+// the last version given to a light. 0 is never given,
+// so a light slot that's never been sent doesn't match any light.
+static uint64_t last_light_version = 0;
+
 namespace gu {
+uint64_t next_light_version() {
+	return ++last_light_version;
+}
+
 void DirLight::_set_orientation_as_modified() {
 	_orientation_is_new = true;
-	_direction_needs_GL_update = true;
-	_is_new = true;
+	_set_light_as_modified();
 	#if defined(GURU_AUTO_UPDATE_MATH_OBJECTS)
 	update();
 	#endif
@@ -12,14 +19,12 @@ void DirLight::_set_orientation_as_modified() {
 
 void PointLight::_set_position_as_modified() {
 	_position_is_new = true;
-	_position_needs_GL_update = true;
-	_is_new = true;
+	_set_light_as_modified();
 }
 
 void SpotLight::_set_orientation_as_modified() {
 	_orientation_is_new = true;
-	_direction_needs_GL_update = true;
-	_is_new = true;
+	_set_light_as_modified();
 	#if defined(GURU_AUTO_UPDATE_MATH_OBJECTS)
 	update();
 	#endif
@@ -27,8 +32,7 @@ void SpotLight::_set_orientation_as_modified() {
 
 void SpotLight::_set_position_as_modified() {
 	_position_is_new = true;
-	_position_needs_GL_update = true;
-	_is_new = true;
+	_set_light_as_modified();
 	#if defined(GURU_AUTO_UPDATE_MATH_OBJECTS)
 	update();
 	#endif
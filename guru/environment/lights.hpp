@@ -1,23 +1,46 @@
 #pragma once
+#include <stdint.h>
 #include "../resources/color.hpp"
 #include "../mathmatics/quat_point.hpp"
 
+namespace gu {
+// returns a light version that's greater than any returned before,
+// so no two lights or changes of a light share a version.
+uint64_t next_light_version();
+} // namespace gu
+
 namespace {
 class LightColor : public gu::Color {
 private:
-	bool _color_is_new = true;
-	bool *_light_is_modified_indicator = nullptr;
+	uint64_t *_light_version = nullptr;
 
 public:
 LightColor(
 	const float &red,
 	const float &green,
 	const float &blue,
-	bool light_is_modified_indicator
+	uint64_t &light_version
 ) : gu::Color(red, green, blue, 1.0f),
-    _light_is_modified_indicator(&light_is_modified_indicator)
+    _light_version(&light_version)
+{}
+
+// copies the color of <other> for the light with the given <light_version>,
+// since the copy belongs to a different light than <other> does.
+LightColor(const LightColor &other, uint64_t &light_version)
+  : gu::Color(other),
+    _light_version(&light_version)
 {}
 
+// a LightColor is only copied along with the light it belongs to.
+LightColor(const LightColor &) = delete;
+
+// copies only the color of <other>, still giving this light a new version.
+LightColor &operator=(const LightColor &other) {
+	gu::Color::operator=(other);
+	*_light_version = gu::next_light_version();
+	return *this;
+}
+
 virtual void set(
 	const float &red,
 	const float &green,
@@ -28,11 +51,8 @@ virtual void set(
 	_g = green;
 	_b = blue;
 	_a = alpha;
-	_color_is_new = true;
-	*_light_is_modified_indicator = true;
+	*_light_version = gu::next_light_version();
 }
-inline bool needs_GL_update() const { return _color_is_new; }
-inline void set_as_GL_updated() { _color_is_new = false; }
 };
 
 /**
@@ -40,58 +60,84 @@ inline void set_as_GL_updated() { _color_is_new = false; }
  * ---
  * this class defines the Color properties of a light source.
  *
+ * ---
+ * every change to a light gives it a new version.
+ * whatever sends lights to the videocard remembers the version
+ * it last sent for each of its light slots, so a light is only
+ * sent again once it's changed, and it's sent once to every consumer
+ * instead of just to the first one that reads it.
+ *
  */
 class LightColors {
 protected:
-	bool _is_new = true; // true if any attribute of the Light is changed
-	LightColor _diffuse = LightColor(1.0f, 1.0f, 1.0f, _is_new);
-	LightColor _specular = LightColor(1.0f, 1.0f, 1.0f, _is_new);
+	uint64_t _version = gu::next_light_version(); // of the last change
+	LightColor _diffuse = LightColor(1.0f, 1.0f, 1.0f, _version);
+	LightColor _specular = LightColor(1.0f, 1.0f, 1.0f, _version);
 
 	// instances of this base class cannot be directly created.
 	inline LightColors() {}
+
+	// copies the colors of <other> into a light with its own version,
+	// so that the LightColors point to the copy's version.
+	// moves make copies too.
+	inline LightColors(const LightColors &other)
+		: _diffuse(other._diffuse, _version),
+		  _specular(other._specular, _version)
+	{}
+	inline LightColors &operator=(const LightColors &other) {
+		_diffuse = other._diffuse;
+		_specular = other._specular;
+		return *this;
+	}
+
+	// gives the light a new version after any of its attributes has changed.
+	inline void _set_light_as_modified() {
+		_version = gu::next_light_version();
+	}
+
 public:
 	inline LightColor &get_diffuse() { return _diffuse; }
 	inline LightColor &get_specular() { return _specular; }
-	inline bool needs_any_GL_update() const { return _is_new; }
-	inline void set_as_entirely_GL_updated() {
-		_is_new = false;
-	}
+
+	// returns the version of the light's last change, which is never 0.
+	inline const uint64_t &get_version() const { return _version; }
 };
 
 /**
  * FloatUniform
  * ---
- * this class defines a float value that will report
- * when it's been modified.
+ * this class defines a float value that gives its light
+ * a new version when it's modified.
  *
  */
 class FloatUniform {
 protected:
 	float _value;
-	bool _needs_GL_update = true;
-	bool *_external_update_indicator = nullptr;
-	bool *_light_is_modified_indicator = nullptr;
+	uint64_t *_light_version = nullptr;
 
 public:
-	inline FloatUniform(
-		const float &value,
-		bool &external_update_indicator,
-		bool &light_is_modified_indicator
-	)
-		: _value(value),
-		  _external_update_indicator(&external_update_indicator),
-		  _light_is_modified_indicator(&light_is_modified_indicator)
+	inline FloatUniform(const float &value, uint64_t &light_version)
+		: _value(value), _light_version(&light_version)
 	{}
+
+	// copies the value of <other> for the light with the given <light_version>.
+	inline FloatUniform(const FloatUniform &other, uint64_t &light_version)
+		: _value(other._value), _light_version(&light_version)
+	{}
+
+	// a FloatUniform is only copied along with the light it belongs to.
+	FloatUniform(const FloatUniform &) = delete;
+
+	// copies only the value of <other>, still giving this light a new version.
+	inline FloatUniform &operator=(const FloatUniform &other) {
+		set(other._value);
+		return *this;
+	}
+
 	const float &get_value() const { return _value; }
-	bool needs_GL_update() const { return _needs_GL_update; }
 	inline void set(const float &value) {
 		_value = value;
-		_needs_GL_update = true;
-		*_external_update_indicator = true;
-		*_light_is_modified_indicator = true;
-	}
-	inline void set_as_GL_updated() {
-		_needs_GL_update = false;
+		*_light_version = gu::next_light_version();
 	}
 };
 
@@ -104,29 +150,31 @@ public:
  */
 class AttenuatedLightColors : public LightColors {
 protected:
-	bool _attenuation_needs_GL_update = true;
-
-	FloatUniform _constant = FloatUniform(
-		1.0f, _attenuation_needs_GL_update, _is_new
-	);
-	FloatUniform _linear = FloatUniform(
-		0.09f, _attenuation_needs_GL_update, _is_new
-	);
-	FloatUniform _quadratic = FloatUniform(
-		0.032f, _attenuation_needs_GL_update, _is_new
-	);
+	FloatUniform _constant = FloatUniform(1.0f, _version);
+	FloatUniform _linear = FloatUniform(0.09f, _version);
+	FloatUniform _quadratic = FloatUniform(0.032f, _version);
 
 	// instances of this base class cannot be directly created.
 	inline AttenuatedLightColors() {}
 
-public:
-	inline bool attenuation_needs_GL_update() const {
-		return _attenuation_needs_GL_update;
+	// copies the factors of <other> into a light with its own version.
+	inline AttenuatedLightColors(const AttenuatedLightColors &other)
+		: LightColors(other),
+		  _constant(other._constant, _version),
+		  _linear(other._linear, _version),
+		  _quadratic(other._quadratic, _version)
+	{}
+	inline AttenuatedLightColors &operator=(
+		const AttenuatedLightColors &other
+	) {
+		LightColors::operator=(other);
+		_constant = other._constant;
+		_linear = other._linear;
+		_quadratic = other._quadratic;
+		return *this;
 	}
 
-	inline void set_attenuation_as_GL_updated() {
-		_attenuation_needs_GL_update = false;
-	}
+public:
 	inline FloatUniform &get_constant() { return _constant; }
 	inline FloatUniform &get_linear() { return _linear; }
 	inline FloatUniform &get_quadratic() { return _quadratic; }
@@ -142,18 +190,6 @@ namespace gu {
  *
  */
 class DirLight : public LightColors, public Orientation {
-protected:
-	bool _direction_needs_GL_update = true;
-
-public:
-	inline bool direction_needs_GL_update() const {
-		return _direction_needs_GL_update;
-	}
-
-	inline void set_direction_as_GL_updated() {
-		_direction_needs_GL_update = false;
-	}
-
 protected:
 	// this is called by any method that modifies the rotation quaternion.
 	void _set_orientation_as_modified() override;
@@ -166,17 +202,6 @@ protected:
  *
  */
 class PointLight : public AttenuatedLightColors, public Point {
-protected:
-	bool _position_needs_GL_update = true;
-
-public:
-	inline bool position_needs_GL_update() const {
-		return _position_needs_GL_update;
-	}
-	inline void set_position_as_GL_updated() {
-		_position_needs_GL_update = false;
-	}
-
 protected:
 	// this is called by any method that modifies the position.
 	void _set_position_as_modified() override;
@@ -191,33 +216,34 @@ protected:
  */
 class SpotLight : public AttenuatedLightColors, public QuatPoint {
 protected:
-	bool _cutoff_was_changed = true;
 	FloatUniform _inner_cutoff = FloatUniform(
-		glm::cos(glm::radians(7.0f)), _cutoff_was_changed, _is_new
+		glm::cos(glm::radians(7.0f)), _version
 	);
 	FloatUniform _outer_cutoff = FloatUniform(
-		glm::cos(glm::radians(17.0f)), _cutoff_was_changed, _is_new
+		glm::cos(glm::radians(17.0f)), _version
 	);
-	bool _direction_needs_GL_update = true;
-	bool _position_needs_GL_update = true;
+	int _shadow_layer = -1; // set by the ShadowMaps
 
 public:
-	inline FloatUniform &get_inner_cutoff() { return _inner_cutoff; }
-	inline FloatUniform &get_outer_cutoff() { return _outer_cutoff; }
-	inline bool direction_needs_GL_update() const {
-		return _direction_needs_GL_update;
-	}
+	inline SpotLight() {}
 
-	inline bool position_needs_GL_update() const {
-		return _position_needs_GL_update;
-	}
+	// copies the <other> SpotLight into one with its own version.
+	// the copy has no shadow layer until the ShadowMaps give it one.
+	inline SpotLight(const SpotLight &other)
+		: AttenuatedLightColors(other),
+		  QuatPoint(other),
+		  _inner_cutoff(other._inner_cutoff, _version),
+		  _outer_cutoff(other._outer_cutoff, _version)
+	{}
 
-	inline void set_direction_as_GL_updated() {
-		_direction_needs_GL_update = false;
-	}
+	inline FloatUniform &get_inner_cutoff() { return _inner_cutoff; }
+	inline FloatUniform &get_outer_cutoff() { return _outer_cutoff; }
 
-	inline void set_position_as_GL_updated() {
-		_position_needs_GL_update = false;
+	// returns the layer of the ShadowMaps' spot maps
+	// that the SpotLight's shadows are in, or -1 if it has none.
+	inline const int &get_shadow_layer() const { return _shadow_layer; }
+	inline void set_shadow_layer(const int &layer) {
+		_shadow_layer = layer;
 	}
 
 protected:
@@ -0,0 +1,249 @@
+#include "occlusion_culler.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// the corners of a box, with each bit choosing the min or max of an axis.
+static glm::vec3 get_corner(
+	const glm::vec3 &min, const glm::vec3 &max, const int &corner
+) {
+	return glm::vec3(
+		corner & 1 ? max.x : min.x,
+		corner & 2 ? max.y : min.y,
+		corner & 4 ? max.z : min.z
+	);
+}
+
+// the 12 triangles of a box's faces, indexing the corners of get_corner(...).
+static const uint32_t BOX_INDICES[36] = {
+	0, 1, 3, 0, 3, 2, // -z
+	4, 6, 7, 4, 7, 5, // +z
+	0, 4, 5, 0, 5, 1, // -y
+	2, 3, 7, 2, 7, 6, // +y
+	0, 2, 6, 0, 6, 4, // -x
+	1, 5, 7, 1, 7, 3, // +x
+};
+
+// returns twice the signed area of the triangle of the points <a>, <b>, <c>.
+static inline float get_edge(
+	const float &ax, const float &ay,
+	const float &bx, const float &by,
+	const float &cx, const float &cy
+) {
+	return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+namespace gu {
+OcclusionCuller::OcclusionCuller(const size_t &width, const size_t &height) :
+	_width(std::max(width, size_t(1))),
+	_height(std::max(height, size_t(1)))
+{
+	// each level halves the one below it, down to a single texel.
+	size_t level_w = _width;
+	size_t level_h = _height;
+	while (true) {
+		_level_widths.push_back(level_w);
+		_level_heights.push_back(level_h);
+		_levels.emplace_back(level_w * level_h, 1.0f);
+		if (level_w == 1 and level_h == 1)
+			break;
+		level_w = std::max((level_w + 1) / 2, size_t(1));
+		level_h = std::max((level_h + 1) / 2, size_t(1));
+	}
+}
+
+void OcclusionCuller::begin(const Camera &camera) {
+	_projview = camera.get_projview();
+	std::fill(_levels[0].begin(), _levels[0].end(), 1.0f);
+	_stats = Stats();
+}
+
+void OcclusionCuller::add_occluder(
+	const Bounds &bounds, const glm::mat4 &model_mat
+) {
+	if (bounds.is_empty())
+		return;
+
+	glm::vec3 corners[8];
+	for (int i = 0; i < 8; ++i)
+		corners[i] = get_corner(bounds.min, bounds.max, i);
+	add_occluder(corners, BOX_INDICES, 36, model_mat);
+}
+
+void OcclusionCuller::add_occluder(
+	const glm::vec3 *positions,
+	const uint32_t *indices,
+	const size_t &n_indices,
+	const glm::mat4 &model_mat
+) {
+	glm::mat4 mat = _projview * model_mat;
+	for (size_t i = 0; i + 2 < n_indices; i += 3) {
+		_rasterize_clipped(
+			mat * glm::vec4(positions[indices[i]], 1.0f),
+			mat * glm::vec4(positions[indices[i + 1]], 1.0f),
+			mat * glm::vec4(positions[indices[i + 2]], 1.0f)
+		);
+		++_stats.n_occluder_triangles;
+	}
+}
+
+void OcclusionCuller::build() {
+	for (size_t level = 1; level < _levels.size(); ++level) {
+		const std::vector<float> &below = _levels[level - 1];
+		std::vector<float> &depths = _levels[level];
+		size_t below_w = _level_widths[level - 1];
+		size_t below_h = _level_heights[level - 1];
+		size_t level_w = _level_widths[level];
+		size_t level_h = _level_heights[level];
+
+		// keeps the farthest of each 2x2 block,
+		// which is clamped at the edges of odd-sized levels.
+		for (size_t y = 0; y < level_h; ++y) {
+			size_t y_0 = std::min(y * 2, below_h - 1);
+			size_t y_1 = std::min(y * 2 + 1, below_h - 1);
+			for (size_t x = 0; x < level_w; ++x) {
+				size_t x_0 = std::min(x * 2, below_w - 1);
+				size_t x_1 = std::min(x * 2 + 1, below_w - 1);
+				depths[y * level_w + x] = std::max(
+					std::max(below[y_0 * below_w + x_0], below[y_0 * below_w + x_1]),
+					std::max(below[y_1 * below_w + x_0], below[y_1 * below_w + x_1])
+				);
+			}
+		}
+	}
+}
+
+bool OcclusionCuller::is_visible(const Bounds &bounds) {
+	++_stats.n_tested;
+	if (bounds.is_empty())
+		return true;
+
+	// finds the screen rectangle and nearest depth of the box.
+	// a box crossing the near plane is always visible.
+	float min_x = FLT_MAX, min_y = FLT_MAX, min_z = FLT_MAX;
+	float max_x = -FLT_MAX, max_y = -FLT_MAX;
+	for (int i = 0; i < 8; ++i) {
+		glm::vec4 clip = _projview * glm::vec4(
+			get_corner(bounds.min, bounds.max, i), 1.0f
+		);
+		if (clip.z < -clip.w or clip.w <= 0.0f)
+			return true;
+
+		float x = (clip.x / clip.w * 0.5f + 0.5f) * _width;
+		float y = (clip.y / clip.w * 0.5f + 0.5f) * _height;
+		float z = clip.z / clip.w * 0.5f + 0.5f;
+		min_x = std::min(min_x, x);
+		min_y = std::min(min_y, y);
+		min_z = std::min(min_z, z);
+		max_x = std::max(max_x, x);
+		max_y = std::max(max_y, y);
+	}
+
+	// boxes off of the screen are left to the frustum test.
+	if (
+		   max_x < 0.0f or max_y < 0.0f
+		or min_x >= _width or min_y >= _height
+	)
+		return true;
+	min_x = std::max(min_x, 0.0f);
+	min_y = std::max(min_y, 0.0f);
+	max_x = std::min(max_x, _width - 1.0f);
+	max_y = std::min(max_y, _height - 1.0f);
+
+	// picks the level where the rectangle covers about two texels
+	// across its longer side.
+	float size = std::max(max_x - min_x, max_y - min_y);
+	size_t level = static_cast<size_t>(
+		std::max(0.0f, std::ceil(std::log2(std::max(size, 1.0f))))
+	);
+	level = std::min(level, _levels.size() - 1);
+
+	const std::vector<float> &depths = _levels[level];
+	size_t level_w = _level_widths[level];
+	size_t level_h = _level_heights[level];
+	size_t x_0 = std::min(static_cast<size_t>(min_x) >> level, level_w - 1);
+	size_t x_1 = std::min(static_cast<size_t>(max_x) >> level, level_w - 1);
+	size_t y_0 = std::min(static_cast<size_t>(min_y) >> level, level_h - 1);
+	size_t y_1 = std::min(static_cast<size_t>(max_y) >> level, level_h - 1);
+	for (size_t y = y_0; y <= y_1; ++y)
+		for (size_t x = x_0; x <= x_1; ++x)
+			if (min_z <= depths[y * level_w + x])
+				return true;
+
+	++_stats.n_occluded;
+	return false;
+}
+
+void OcclusionCuller::_rasterize_clipped(
+	const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c
+) {
+	// clips the triangle against the near plane (z = -w),
+	// which leaves a polygon of up to four points.
+	const glm::vec4 in_points[3] = {a, b, c};
+	glm::vec4 points[4];
+	size_t n_points = 0;
+	for (int i = 0; i < 3; ++i) {
+		const glm::vec4 &current = in_points[i];
+		const glm::vec4 &next = in_points[(i + 1) % 3];
+		float current_dist = current.z + current.w;
+		float next_dist = next.z + next.w;
+		if (current_dist >= 0.0f)
+			points[n_points++] = current;
+		if ((current_dist >= 0.0f) != (next_dist >= 0.0f)) {
+			float t = current_dist / (current_dist - next_dist);
+			points[n_points++] = current + (next - current) * t;
+		}
+	}
+
+	for (size_t i = 1; i + 1 < n_points; ++i)
+		_rasterize(points[0], points[i], points[i + 1]);
+}
+
+void OcclusionCuller::_rasterize(
+	const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c
+) {
+	// converts the points to screen space, where depth is linear.
+	const glm::vec4 *clip_points[3] = {&a, &b, &c};
+	float xs[3], ys[3], zs[3];
+	for (int i = 0; i < 3; ++i) {
+		const glm::vec4 &point = *clip_points[i];
+		float inv_w = 1.0f / std::max(point.w, 1e-6f);
+		xs[i] = (point.x * inv_w * 0.5f + 0.5f) * _width;
+		ys[i] = (point.y * inv_w * 0.5f + 0.5f) * _height;
+		zs[i] = std::clamp(point.z * inv_w * 0.5f + 0.5f, 0.0f, 1.0f);
+	}
+
+	float area = get_edge(xs[0], ys[0], xs[1], ys[1], xs[2], ys[2]);
+	if (area == 0.0f)
+		return;
+
+	// both windings are rasterized, since occluders are solid.
+	float sign = area > 0.0f ? 1.0f : -1.0f;
+	float inv_area = 1.0f / (area * sign);
+
+	float min_x = std::max(std::min({xs[0], xs[1], xs[2]}), 0.0f);
+	float min_y = std::max(std::min({ys[0], ys[1], ys[2]}), 0.0f);
+	float max_x = std::min(std::max({xs[0], xs[1], xs[2]}), _width - 1.0f);
+	float max_y = std::min(std::max({ys[0], ys[1], ys[2]}), _height - 1.0f);
+	if (min_x > max_x or min_y > max_y)
+		return;
+
+	// fills every texel whose center is inside of the triangle.
+	std::vector<float> &depths = _levels[0];
+	for (size_t y = size_t(min_y); y <= size_t(max_y); ++y) {
+		float p_y = y + 0.5f;
+		for (size_t x = size_t(min_x); x <= size_t(max_x); ++x) {
+			float p_x = x + 0.5f;
+			float w_0 = sign * get_edge(xs[1], ys[1], xs[2], ys[2], p_x, p_y);
+			float w_1 = sign * get_edge(xs[2], ys[2], xs[0], ys[0], p_x, p_y);
+			float w_2 = sign * get_edge(xs[0], ys[0], xs[1], ys[1], p_x, p_y);
+			if (w_0 < 0.0f or w_1 < 0.0f or w_2 < 0.0f)
+				continue;
+
+			float z = (w_0 * zs[0] + w_1 * zs[1] + w_2 * zs[2]) * inv_area;
+			float &depth = depths[y * _width + x];
+			depth = std::min(depth, z);
+		}
+	}
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * occlusion_culler.hpp
+ * ---
+ * this file defines the OcclusionCuller class, which finds instances
+ * that are hidden behind large occluders before they're drawn.
+ * the occluders are rasterized on the CPU into a small depth buffer,
+ * which is reduced into a hierarchical depth (Hi-Z) pyramid
+ * where every texel holds the farthest depth of the texels below it.
+ * an instance's box is hidden if its nearest depth is behind
+ * the farthest depth of every texel it covers on a level of the pyramid
+ * where it covers only a few texels.
+ *
+ * ---
+ * every frame, the OcclusionCuller is given the Camera with begin(...),
+ * then the occluders (e.g. walls, floors and large props),
+ * and then build() is called before any instance is tested.
+ * occluders must be solid wherever they're rasterized,
+ * so an occluder's box should fit inside of its geometry.
+ * a RenderQueue given an OcclusionCuller skips the packets it hides.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <glm/mat4x4.hpp>
+#include "camera.hpp"
+#include "../mathmatics/bounds.hpp"
+
+namespace gu {
+class OcclusionCuller {
+public:
+	/**
+	 * OcclusionCuller::Stats
+	 * ---
+	 * this struct counts the work done since the last call to begin(...).
+	 *
+	 */
+	struct Stats {
+		size_t n_occluder_triangles = 0;
+		size_t n_tested = 0;
+		size_t n_occluded = 0;
+	};
+
+private:
+	size_t _width;
+	size_t _height;
+	glm::mat4 _projview = glm::mat4(1.0f);
+
+	// the depths of each level of the pyramid, with level 0 being
+	// the rasterized depth buffer. depths are from 0 (near) to 1 (far).
+	std::vector<std::vector<float>> _levels;
+	std::vector<size_t> _level_widths;
+	std::vector<size_t> _level_heights;
+	Stats _stats;
+
+public:
+	// ctor. sets the resolution of the depth buffer,
+	// which doesn't have to match the Camera's.
+	OcclusionCuller(const size_t &width = 256, const size_t &height = 128);
+
+	// clears the depth buffer and sets the <camera> whose view is tested.
+	void begin(const Camera &camera);
+
+	// rasterizes the box of the <bounds> transformed by the <model_mat>.
+	void add_occluder(const Bounds &bounds, const glm::mat4 &model_mat);
+
+	// rasterizes the triangles of the <n_indices> <indices>
+	// into the <positions>, transformed by the <model_mat>.
+	void add_occluder(
+		const glm::vec3 *positions,
+		const uint32_t *indices,
+		const size_t &n_indices,
+		const glm::mat4 &model_mat
+	);
+
+	// builds the depth pyramid from the rasterized occluders.
+	// this must be called after the last occluder and before any tests.
+	void build();
+
+	// returns false if the world-space <bounds> are entirely hidden
+	// behind the occluders. the result is counted in the Stats.
+	bool is_visible(const Bounds &bounds);
+
+	// returns the counts since the last call to begin(...).
+	inline const Stats &get_stats() const { return _stats; }
+
+	inline size_t get_width() const { return _width; }
+	inline size_t get_height() const { return _height; }
+
+	// returns the rasterized depth buffer (level 0 of the pyramid),
+	// row by row from the bottom of the screen.
+	inline const std::vector<float> &get_depths() const { return _levels[0]; }
+
+private:
+	// rasterizes the triangle of the clip-space positions <a>, <b> and <c>,
+	// first clipping it against the near plane.
+	void _rasterize_clipped(
+		const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c
+	);
+
+	// rasterizes the triangle of the clip-space positions <a>, <b> and <c>,
+	// which are all in front of the near plane.
+	void _rasterize(
+		const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c
+	);
+};
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "render_queue.hpp"
+#include <algorithm>
+#include <cstring>
+#include "../shader/uniform_blocks.hpp"
+
+// bit widths of the parts of a sort key after its transparency bit.
+static const uint64_t SHADER_BITS = 8;
+static const uint64_t MATERIAL_BITS = 23;
+static const uint64_t DEPTH_BITS = 32;
+
+// returns the bits of a non-negative <value>,
+// which are in the same order as the floats themselves.
+static uint32_t get_depth_bits(const float &value) {
+	uint32_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+namespace gu {
+void RenderQueue::submit(
+	const ModelShader &shader,
+	const ModelResource &model,
+	const size_t &mesh_index,
+	const Material &material,
+	const glm::mat4 &model_mat
+) {
+	if (model.is_loading() or mesh_index >= model.get_n_meshes())
+		return;
+
+	Packet packet;
+	packet.shader = &shader;
+	packet.mesh = &model.get_mesh(mesh_index);
+	packet.material = &material;
+	packet.model_mat = model_mat;
+	packet.transparent = material.is_transparent();
+	packet.face_cull_option = (
+		packet.transparent ? GL_NONE : model.get_face_cull_option()
+	);
+	packet.shader_index = _get_shader_index(&shader);
+	packet.material_index = _get_material_index(&material);
+	_packets.push_back(packet);
+}
+
+void RenderQueue::submit(
+	const ModelShader &shader,
+	const ModelResource &model,
+	const glm::mat4 &model_mat,
+	const std::vector<Material::Override> &material_overrides,
+	const std::vector<Mesh::Override> &mesh_overrides
+) {
+	if (model.is_loading())
+		return;
+
+	size_t mesh_overrides_index = 0;
+	for (size_t i = 0; i < model.get_n_meshes(); ++i) {
+		const Material *material = nullptr;
+		if (
+			    mesh_overrides_index < mesh_overrides.size()
+			and mesh_overrides[mesh_overrides_index].mesh_index == i
+		) {
+			// applies Mesh Material overriding if given.
+			material = mesh_overrides[mesh_overrides_index].material.get();
+			++mesh_overrides_index;
+		} else {
+			// applies Material overriding if given.
+			size_t material_index = model.get_mesh(i).get_material_index();
+			material = model.get_material(material_index).get();
+			for (const auto &mat_override : material_overrides) {
+				if (mat_override.material_index == material_index) {
+					material = mat_override.material.get();
+					break;
+				}
+			}
+		}
+		if (material)
+			submit(shader, model, i, *material, model_mat);
+	}
+}
+
+void RenderQueue::execute(const Camera &camera) {
+	_stats = Stats();
+	_stats.n_packets = _packets.size();
+
+	// sorts the packets in view by key.
+	const glm::vec3 view_pos = static_cast<glm::vec3>(camera.get_position());
+	_keys.clear();
+	_keys.reserve(_packets.size());
+	for (uint32_t i = 0; i < _packets.size(); ++i) {
+		const Packet &packet = _packets[i];
+		const Bounds &bounds = packet.mesh->get_bounds();
+		if (not camera.is_mesh_visible(bounds, packet.model_mat)) {
+			++_stats.n_culled;
+			continue;
+		}
+		if (
+			_occlusion_culler
+			and not _occlusion_culler->is_visible(
+				bounds.transformed(packet.model_mat)
+			)
+		) {
+			++_stats.n_occluded;
+			continue;
+		}
+		glm::vec3 offset = glm::vec3(packet.model_mat[3]) - view_pos;
+		_keys.emplace_back(_make_key(packet, glm::dot(offset, offset)), i);
+	}
+	std::sort(_keys.begin(), _keys.end());
+
+	// draws the packets, only binding what has changed since the last one.
+	const glm::mat4 &projview = camera.get_projview();
+	UniformBlocks::update_camera(camera);
+	UniformBlocks::upload_lights();
+	const ModelShader *bound_shader = nullptr;
+	const Material *bound_material = nullptr;
+	res::GeometryArena::geometry_arena.bind();
+	for (const auto &key : _keys) {
+		const Packet &packet = _packets[key.second];
+		if (packet.shader != bound_shader) {
+			packet.shader->use();
+			bound_shader = packet.shader;
+			bound_material = nullptr;
+			++_stats.n_shader_binds;
+		}
+
+		if (packet.material != bound_material) {
+			packet.material->bind_to_GL();
+			bound_material = packet.material;
+			++_stats.n_material_binds;
+		}
+
+		GLState::set_cull_face(packet.face_cull_option);
+
+		bound_shader->set_PVM_mat(projview * packet.model_mat);
+		bound_shader->set_model_mat(packet.model_mat);
+		packet.mesh->draw();
+		++_stats.n_draws;
+	}
+	clear();
+}
+
+void RenderQueue::clear() {
+	_packets.clear();
+	_shader_indices.clear();
+	_material_indices.clear();
+}
+
+uint32_t RenderQueue::_get_shader_index(const ModelShader *shader) {
+	auto result = _shader_indices.emplace(
+		shader, static_cast<uint32_t>(_shader_indices.size())
+	);
+	return result.first->second;
+}
+
+uint32_t RenderQueue::_get_material_index(const Material *material) {
+	auto result = _material_indices.emplace(
+		material, static_cast<uint32_t>(_material_indices.size())
+	);
+	return result.first->second;
+}
+
+uint64_t RenderQueue::_make_key(const Packet &packet, const float &dist_sq) {
+	// indices past the width of their part of the key only weaken the
+	// grouping of packets, since each packet is still drawn with its own
+	// ModelShader and Material.
+	const uint64_t shader = packet.shader_index & ((1ull << SHADER_BITS) - 1);
+	const uint64_t material = (
+		packet.material_index & ((1ull << MATERIAL_BITS) - 1)
+	);
+	const uint64_t depth = get_depth_bits(std::max(dist_sq, 0.0f));
+
+	// opaque: [0][shader][material][depth], drawn front-to-back per group.
+	if (not packet.transparent)
+		return (
+			  (shader << (MATERIAL_BITS + DEPTH_BITS))
+			| (material << DEPTH_BITS)
+			| depth
+		);
+
+	// transparent: [1][inverted depth][shader][material], back-to-front.
+	const uint64_t inverted_depth = (~depth) & ((1ull << DEPTH_BITS) - 1);
+	return (
+		  (1ull << 63)
+		| (inverted_depth << (SHADER_BITS + MATERIAL_BITS))
+		| (shader << MATERIAL_BITS)
+		| material
+	);
+}
+} // namespace gu
\ No newline at end of file
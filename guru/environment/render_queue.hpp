@@ -0,0 +1,141 @@
+/**
+ * render_queue.hpp
+ * ---
+ * this file defines the RenderQueue class, which collects draw packets
+ * over a frame and sorts them with 64-bit keys before drawing them,
+ * so that ModelShaders and Materials are rebound as rarely as possible.
+ *
+ * ---
+ * opaque packets are drawn first, grouped by ModelShader and then
+ * by Material, with each group drawn front-to-back.
+ * transparent packets are drawn afterwards back-to-front.
+ * the RenderQueue sends the Camera's "CameraBlock" and then sets
+ * "_PVM_mat" and "_model_mat" per packet, so any other uniforms
+ * should be set beforehand.
+ * packets whose Mesh is outside of the Camera's view aren't drawn,
+ * which is counted in the Camera's CullingStats.
+ * if an OcclusionCuller is set, packets that it finds hidden
+ * behind its occluders aren't drawn either.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "camera.hpp"
+#include "occlusion_culler.hpp"
+#include "../resources/model/model_resource.hpp"
+#include "../shader/model_shader.hpp"
+
+namespace gu {
+class RenderQueue {
+public:
+	/**
+	 * RenderQueue::Packet
+	 * ---
+	 * this struct holds everything needed to draw one Mesh.
+	 * the pointers must stay valid until the RenderQueue is executed.
+	 *
+	 */
+	struct Packet {
+		const ModelShader *shader = nullptr;
+		const Mesh *mesh = nullptr;
+		const Material *material = nullptr;
+		glm::mat4 model_mat = glm::mat4(1.0f);
+		GLenum face_cull_option = GL_BACK; // GL_NONE if transparent
+		bool transparent = false;
+		uint32_t shader_index = 0; // order of first submission this frame
+		uint32_t material_index = 0; // order of first submission this frame
+	};
+
+	/**
+	 * RenderQueue::Stats
+	 * ---
+	 * this struct counts the OpenGL work done by the last execution.
+	 *
+	 */
+	struct Stats {
+		size_t n_packets = 0;
+		size_t n_culled = 0;
+		size_t n_occluded = 0;
+		size_t n_draws = 0;
+		size_t n_shader_binds = 0;
+		size_t n_material_binds = 0;
+	};
+
+private:
+	std::vector<Packet> _packets;
+	std::vector<std::pair<uint64_t, uint32_t>> _keys; // sort key, packet
+	std::unordered_map<const ModelShader *, uint32_t> _shader_indices;
+	std::unordered_map<const Material *, uint32_t> _material_indices;
+	OcclusionCuller *_occlusion_culler = nullptr;
+	Stats _stats;
+
+public:
+	// sets the <occlusion_culler> that packets are tested against
+	// after they pass the Camera's frustum, or nullptr to test none.
+	// it must be built for the Camera before each execution.
+	inline void set_occlusion_culler(OcclusionCuller *occlusion_culler) {
+		_occlusion_culler = occlusion_culler;
+	}
+
+	// adds a packet that draws the Mesh at <mesh_index> of the <model>
+	// with the <shader>, the <material> and the <model_mat>.
+	// nothing is added if the <model> is still loading.
+	void submit(
+		const ModelShader &shader,
+		const ModelResource &model,
+		const size_t &mesh_index,
+		const Material &material,
+		const glm::mat4 &model_mat
+	);
+
+	// adds a packet for every Mesh of the <model>.
+	// ---
+	// <material_overrides> and <mesh_overrides> are used
+	// like in ModelResource::draw_meshes(...),
+	// with the <mesh_overrides> being sorted by their mesh index.
+	void submit(
+		const ModelShader &shader,
+		const ModelResource &model,
+		const glm::mat4 &model_mat,
+		const std::vector<Material::Override> &material_overrides = (
+			std::vector<Material::Override>()
+		),
+		const std::vector<Mesh::Override> &mesh_overrides = (
+			std::vector<Mesh::Override>()
+		)
+	);
+
+	// culls the submitted packets outside of the <camera>'s view
+	// or hidden by the OcclusionCuller,
+	// sorts the rest by their distance to the <camera>
+	// and by their ModelShader and Material, then draws them.
+	// the RenderQueue is cleared afterwards.
+	void execute(const Camera &camera);
+
+	// removes every submitted packet.
+	void clear();
+
+	// returns the number of packets waiting to be executed.
+	inline size_t get_n_packets() const { return _packets.size(); }
+
+	// returns the counts of the last call to execute(...).
+	inline const Stats &get_stats() const { return _stats; }
+
+private:
+	// returns the index of the <shader> in the current frame,
+	// giving it the next index if it hasn't been submitted yet.
+	uint32_t _get_shader_index(const ModelShader *shader);
+
+	// returns the index of the <material> in the current frame,
+	// giving it the next index if it hasn't been submitted yet.
+	uint32_t _get_material_index(const Material *material);
+
+	// returns the sort key of the <packet>, which is <dist_sq>
+	// (the squared distance) away from the Camera.
+	static uint64_t _make_key(const Packet &packet, const float &dist_sq);
+};
+} // namespace gu
\ No newline at end of file
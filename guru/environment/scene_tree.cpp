@@ -0,0 +1,441 @@
+#include "scene_tree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+// returns the surface area of the box from <min> to <max>,
+// which is the cost of a node when choosing where to insert a leaf.
+static float get_area(const glm::vec3 &min, const glm::vec3 &max) {
+	glm::vec3 size = max - min;
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+// returns true if the box from <inner_min> to <inner_max>
+// is inside of the box from <outer_min> to <outer_max>.
+static bool contains(
+	const glm::vec3 &outer_min,
+	const glm::vec3 &outer_max,
+	const glm::vec3 &inner_min,
+	const glm::vec3 &inner_max
+) {
+	return (
+		    outer_min.x <= inner_min.x and outer_min.y <= inner_min.y
+		and outer_min.z <= inner_min.z and inner_max.x <= outer_max.x
+		and inner_max.y <= outer_max.y and inner_max.z <= outer_max.z
+	);
+}
+
+// returns the squared distance from the <point> to the box
+// from <min> to <max>, which is 0 if the <point> is inside.
+static float get_dist_sq(
+	const glm::vec3 &point, const glm::vec3 &min, const glm::vec3 &max
+) {
+	glm::vec3 offset = glm::max(
+		min - point, glm::max(point - max, glm::vec3(0.0f))
+	);
+	return glm::dot(offset, offset);
+}
+
+// returns the distance along the ray at which it enters the box
+// from <min> to <max>, or a negative value if it misses it.
+// <inv_direction> is 1 divided by each component of the ray's direction.
+static float get_ray_entry(
+	const glm::vec3 &origin,
+	const glm::vec3 &inv_direction,
+	const float &max_distance,
+	const glm::vec3 &min,
+	const glm::vec3 &max
+) {
+	float t_near = 0.0f;
+	float t_far = max_distance;
+	for (int i = 0; i < 3; ++i) {
+		float t_1 = (min[i] - origin[i]) * inv_direction[i];
+		float t_2 = (max[i] - origin[i]) * inv_direction[i];
+		t_near = std::max(t_near, std::min(t_1, t_2));
+		t_far = std::min(t_far, std::max(t_1, t_2));
+	}
+	return t_near <= t_far ? t_near : -1.0f;
+}
+
+namespace gu {
+size_t SceneTree::insert(const Bounds &world_bounds, const size_t &user_data) {
+	int32_t leaf = _allocate_node();
+	Node &node = _nodes[leaf];
+	node.min = world_bounds.min - glm::vec3(_margin);
+	node.max = world_bounds.max + glm::vec3(_margin);
+	node.height = 0;
+	node.user_data = user_data;
+	node.tracked_index = -1;
+	_insert_leaf(leaf);
+	++_n_proxies;
+	return static_cast<size_t>(leaf);
+}
+
+size_t SceneTree::insert(
+	const Bounds &local_bounds,
+	const Transformation &transformation,
+	const size_t &user_data
+) {
+	size_t proxy = insert(
+		local_bounds.transformed(transformation.get_model_matrix()), user_data
+	);
+
+	Tracked tracked;
+	tracked.proxy = static_cast<int32_t>(proxy);
+	tracked.transformation = &transformation;
+	tracked.local_bounds = local_bounds;
+	tracked.version = transformation.get_model_matrix_version();
+	_nodes[proxy].tracked_index = static_cast<int32_t>(_tracked.size());
+	_tracked.push_back(tracked);
+	return proxy;
+}
+
+void SceneTree::remove(const size_t &proxy) {
+	int32_t leaf = static_cast<int32_t>(proxy);
+	int32_t tracked_index = _nodes[leaf].tracked_index;
+	if (tracked_index >= 0) {
+		// the last tracked instance takes the removed one's place.
+		_tracked[tracked_index] = _tracked.back();
+		_nodes[_tracked[tracked_index].proxy].tracked_index = tracked_index;
+		_tracked.pop_back();
+	}
+
+	_remove_leaf(leaf);
+	_free_node(leaf);
+	--_n_proxies;
+}
+
+bool SceneTree::move(const size_t &proxy, const Bounds &world_bounds) {
+	int32_t leaf = static_cast<int32_t>(proxy);
+	Node &node = _nodes[leaf];
+	if (contains(node.min, node.max, world_bounds.min, world_bounds.max))
+		return false;
+
+	_remove_leaf(leaf);
+	node.min = world_bounds.min - glm::vec3(_margin);
+	node.max = world_bounds.max + glm::vec3(_margin);
+	_insert_leaf(leaf);
+	return true;
+}
+
+void SceneTree::update() {
+	for (Tracked &tracked : _tracked) {
+		uint32_t version = tracked.transformation->get_model_matrix_version();
+		if (version == tracked.version)
+			continue;
+
+		tracked.version = version;
+		move(
+			tracked.proxy,
+			tracked.local_bounds.transformed(
+				tracked.transformation->get_model_matrix()
+			)
+		);
+	}
+}
+
+void SceneTree::clear() {
+	_nodes.clear();
+	_root = NULL_NODE;
+	_free_list = NULL_NODE;
+	_n_proxies = 0;
+	_tracked.clear();
+}
+
+void SceneTree::query(
+	const Frustum &frustum, std::vector<size_t> &results
+) const {
+	if (_root == NULL_NODE)
+		return;
+
+	_stack.clear();
+	_stack.push_back(_root);
+	while (not _stack.empty()) {
+		int32_t index = _stack.back();
+		_stack.pop_back();
+		const Node &node = _nodes[index];
+		if (not frustum.intersects_box(node.min, node.max))
+			continue;
+
+		// every leaf under a box that's entirely inside is visible.
+		if (node.is_leaf())
+			results.push_back(node.user_data);
+		else if (frustum.contains_box(node.min, node.max))
+			_collect_leaves(index, results);
+		else {
+			_stack.push_back(node.child_1);
+			_stack.push_back(node.child_2);
+		}
+	}
+}
+
+void SceneTree::query(
+	const glm::vec3 &center,
+	const float &radius,
+	std::vector<size_t> &results
+) const {
+	if (_root == NULL_NODE)
+		return;
+
+	float radius_sq = radius * radius;
+	_stack.clear();
+	_stack.push_back(_root);
+	while (not _stack.empty()) {
+		const Node &node = _nodes[_stack.back()];
+		_stack.pop_back();
+		if (get_dist_sq(center, node.min, node.max) > radius_sq)
+			continue;
+
+		if (node.is_leaf())
+			results.push_back(node.user_data);
+		else {
+			_stack.push_back(node.child_1);
+			_stack.push_back(node.child_2);
+		}
+	}
+}
+
+bool SceneTree::raycast(
+	const glm::vec3 &origin,
+	const glm::vec3 &direction,
+	const float &max_distance,
+	RayHit &hit
+) const {
+	if (_root == NULL_NODE)
+		return false;
+
+	// a zero component gives an infinite inverse,
+	// which makes the slab test of that axis depend on the <origin> alone.
+	glm::vec3 inv_direction(
+		1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z
+	);
+
+	// the nearest hit so far shortens the ray,
+	// which skips every box that's entered after it.
+	float nearest = max_distance;
+	bool found = false;
+	_stack.clear();
+	_stack.push_back(_root);
+	while (not _stack.empty()) {
+		int32_t index = _stack.back();
+		_stack.pop_back();
+		const Node &node = _nodes[index];
+		float entry = get_ray_entry(
+			origin, inv_direction, nearest, node.min, node.max
+		);
+		if (entry < 0.0f)
+			continue;
+
+		if (node.is_leaf()) {
+			nearest = entry;
+			hit.proxy = static_cast<size_t>(index);
+			hit.user_data = node.user_data;
+			hit.distance = entry;
+			found = true;
+		} else {
+			_stack.push_back(node.child_1);
+			_stack.push_back(node.child_2);
+		}
+	}
+	return found;
+}
+
+int32_t SceneTree::_allocate_node() {
+	if (_free_list == NULL_NODE) {
+		_nodes.emplace_back();
+		return static_cast<int32_t>(_nodes.size() - 1);
+	}
+
+	int32_t index = _free_list;
+	_free_list = _nodes[index].parent;
+	_nodes[index] = Node();
+	return index;
+}
+
+void SceneTree::_free_node(const int32_t &index) {
+	_nodes[index].parent = _free_list;
+	_nodes[index].height = -1;
+	_free_list = index;
+}
+
+void SceneTree::_insert_leaf(const int32_t &leaf) {
+	if (_root == NULL_NODE) {
+		_root = leaf;
+		_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// walks down toward the sibling whose box grows the least,
+	// counting the growth of every ancestor along the way.
+	glm::vec3 leaf_min = _nodes[leaf].min;
+	glm::vec3 leaf_max = _nodes[leaf].max;
+	int32_t index = _root;
+	while (not _nodes[index].is_leaf()) {
+		const Node &node = _nodes[index];
+		float area = get_area(node.min, node.max);
+		float combined_area = get_area(
+			glm::min(node.min, leaf_min), glm::max(node.max, leaf_max)
+		);
+
+		// the cost of pairing the leaf with this node,
+		// and the cost that its ancestors inherit from going deeper.
+		float cost = 2.0f * combined_area;
+		float inherited_cost = 2.0f * (combined_area - area);
+
+		auto get_child_cost = [&](const int32_t &child_index) {
+			const Node &child = _nodes[child_index];
+			float child_area = get_area(
+				glm::min(child.min, leaf_min), glm::max(child.max, leaf_max)
+			);
+			if (not child.is_leaf())
+				child_area -= get_area(child.min, child.max);
+			return child_area + inherited_cost;
+		};
+		float cost_1 = get_child_cost(node.child_1);
+		float cost_2 = get_child_cost(node.child_2);
+
+		if (cost < cost_1 and cost < cost_2)
+			break;
+		index = cost_1 < cost_2 ? node.child_1 : node.child_2;
+	}
+	int32_t sibling = index;
+
+	// a new parent takes the sibling's place, holding both.
+	int32_t old_parent = _nodes[sibling].parent;
+	int32_t new_parent = _allocate_node();
+	Node &parent = _nodes[new_parent];
+	parent.parent = old_parent;
+	parent.min = glm::min(leaf_min, _nodes[sibling].min);
+	parent.max = glm::max(leaf_max, _nodes[sibling].max);
+	parent.height = _nodes[sibling].height + 1;
+	parent.child_1 = sibling;
+	parent.child_2 = leaf;
+
+	if (old_parent == NULL_NODE)
+		_root = new_parent;
+	else if (_nodes[old_parent].child_1 == sibling)
+		_nodes[old_parent].child_1 = new_parent;
+	else
+		_nodes[old_parent].child_2 = new_parent;
+	_nodes[sibling].parent = new_parent;
+	_nodes[leaf].parent = new_parent;
+
+	_refit_upward(new_parent);
+}
+
+void SceneTree::_remove_leaf(const int32_t &leaf) {
+	if (leaf == _root) {
+		_root = NULL_NODE;
+		return;
+	}
+
+	// the sibling takes the place of the leaf's parent.
+	int32_t parent = _nodes[leaf].parent;
+	int32_t grandparent = _nodes[parent].parent;
+	int32_t sibling = (
+		_nodes[parent].child_1 == leaf
+		? _nodes[parent].child_2
+		: _nodes[parent].child_1
+	);
+	_free_node(parent);
+
+	if (grandparent == NULL_NODE) {
+		_root = sibling;
+		_nodes[sibling].parent = NULL_NODE;
+		return;
+	}
+
+	if (_nodes[grandparent].child_1 == parent)
+		_nodes[grandparent].child_1 = sibling;
+	else
+		_nodes[grandparent].child_2 = sibling;
+	_nodes[sibling].parent = grandparent;
+	_refit_upward(grandparent);
+}
+
+void SceneTree::_refit_upward(int32_t index) {
+	while (index != NULL_NODE) {
+		index = _balance(index);
+		Node &node = _nodes[index];
+		const Node &child_1 = _nodes[node.child_1];
+		const Node &child_2 = _nodes[node.child_2];
+		node.height = 1 + std::max(child_1.height, child_2.height);
+		node.min = glm::min(child_1.min, child_2.min);
+		node.max = glm::max(child_1.max, child_2.max);
+		index = node.parent;
+	}
+}
+
+int32_t SceneTree::_balance(const int32_t &index_a) {
+	Node &a = _nodes[index_a];
+	if (a.is_leaf() or a.height < 2)
+		return index_a;
+
+	int32_t index_b = a.child_1;
+	int32_t index_c = a.child_2;
+	int32_t balance = _nodes[index_c].height - _nodes[index_b].height;
+	if (balance >= -1 and balance <= 1)
+		return index_a;
+
+	// the taller child is moved up into A's place,
+	// and A takes the shorter of that child's children.
+	// <index_up> is the taller child and <index_other> is A's other child.
+	int32_t index_up = balance > 1 ? index_c : index_b;
+	int32_t index_other = balance > 1 ? index_b : index_c;
+	Node &up = _nodes[index_up];
+	int32_t index_f = up.child_1;
+	int32_t index_g = up.child_2;
+	Node &f = _nodes[index_f];
+	Node &g = _nodes[index_g];
+	Node &other = _nodes[index_other];
+
+	up.child_1 = index_a;
+	up.parent = a.parent;
+	a.parent = index_up;
+	if (up.parent == NULL_NODE)
+		_root = index_up;
+	else if (_nodes[up.parent].child_1 == index_a)
+		_nodes[up.parent].child_1 = index_up;
+	else
+		_nodes[up.parent].child_2 = index_up;
+
+	// the taller of F and G stays under the moved-up node.
+	int32_t index_kept = f.height > g.height ? index_f : index_g;
+	int32_t index_given = f.height > g.height ? index_g : index_f;
+	Node &kept = _nodes[index_kept];
+	Node &given = _nodes[index_given];
+	up.child_2 = index_kept;
+	if (balance > 1)
+		a.child_2 = index_given;
+	else
+		a.child_1 = index_given;
+	given.parent = index_a;
+
+	a.min = glm::min(other.min, given.min);
+	a.max = glm::max(other.max, given.max);
+	a.height = 1 + std::max(other.height, given.height);
+	up.min = glm::min(a.min, kept.min);
+	up.max = glm::max(a.max, kept.max);
+	up.height = 1 + std::max(a.height, kept.height);
+	return index_up;
+}
+
+void SceneTree::_collect_leaves(
+	const int32_t &index, std::vector<size_t> &results
+) const {
+	// uses the end of the shared stack so the caller's traversal continues.
+	size_t base = _stack.size();
+	_stack.push_back(index);
+	while (_stack.size() > base) {
+		const Node &node = _nodes[_stack.back()];
+		_stack.pop_back();
+		if (node.is_leaf())
+			results.push_back(node.user_data);
+		else {
+			_stack.push_back(node.child_1);
+			_stack.push_back(node.child_2);
+		}
+	}
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * scene_tree.hpp
+ * ---
+ * this file defines the SceneTree class, which is a bounding volume
+ * hierarchy of model instances placed by their world-space bounding boxes.
+ * it answers frustum, sphere and ray queries by skipping
+ * every branch whose box misses, so culling and picking
+ * don't have to test every instance.
+ *
+ * ---
+ * each instance is a leaf with a proxy ID and a <user_data> value
+ * (e.g. an index into the caller's instances), which the queries return.
+ * leaves are given boxes grown by a margin, so an instance that moves
+ * only a little stays in its leaf and the tree doesn't change.
+ * an instance that leaves its box is removed and reinserted,
+ * and the tree is rebalanced with rotations along the way.
+ *
+ * ---
+ * an instance can also follow a Transformation,
+ * in which case update() moves it whenever the Transformation's
+ * model matrix has changed since the last update().
+ * the SceneTree only holds pointers to those Transformations,
+ * so an instance must be removed before its Transformation is destroyed.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "frustum.hpp"
+#include "../mathmatics/bounds.hpp"
+#include "../mathmatics/transformation.hpp"
+
+namespace gu {
+class SceneTree {
+public:
+	/**
+	 * SceneTree::RayHit
+	 * ---
+	 * this struct describes the nearest box that a ray enters.
+	 *
+	 */
+	struct RayHit {
+		size_t proxy = 0;
+		size_t user_data = 0;
+		float distance = 0.0f; // along the ray to the box
+	};
+
+private:
+	static const int32_t NULL_NODE = -1;
+
+	struct Node {
+		glm::vec3 min = glm::vec3(0.0f);
+		glm::vec3 max = glm::vec3(0.0f);
+		int32_t parent = NULL_NODE; // the next free node if unused
+		int32_t child_1 = NULL_NODE;
+		int32_t child_2 = NULL_NODE;
+		int32_t height = -1; // 0 for leaves, -1 if unused
+		size_t user_data = 0; // leaves only
+		int32_t tracked_index = -1; // in <_tracked>, leaves only
+
+		inline bool is_leaf() const { return child_1 == NULL_NODE; }
+	};
+
+	// an instance that follows a Transformation.
+	struct Tracked {
+		int32_t proxy = NULL_NODE;
+		const Transformation *transformation = nullptr;
+		Bounds local_bounds;
+		uint32_t version = 0; // of the model matrix when last moved
+	};
+
+	std::vector<Node> _nodes;
+	int32_t _root = NULL_NODE;
+	int32_t _free_list = NULL_NODE;
+	size_t _n_proxies = 0;
+	float _margin = 0.1f; // added to every side of a leaf's box
+	std::vector<Tracked> _tracked;
+	mutable std::vector<int32_t> _stack; // reused by queries
+
+public:
+	// sets the distance that each leaf's box is grown by.
+	// larger margins let instances move farther before they're reinserted
+	// but make the queries less tight.
+	// this only applies to leaves that are inserted afterwards.
+	inline void set_margin(const float &margin) { _margin = margin; }
+
+	inline size_t get_n_proxies() const { return _n_proxies; }
+
+	// returns the height of the tree, which is 0 for a single leaf.
+	inline int32_t get_height() const {
+		return _root == NULL_NODE ? 0 : _nodes[_root].height;
+	}
+
+	// adds an instance with the given <world_bounds>
+	// and returns its proxy ID.
+	size_t insert(const Bounds &world_bounds, const size_t &user_data);
+
+	// adds an instance whose <local_bounds> are placed by the
+	// <transformation>'s model matrix and returns its proxy ID.
+	size_t insert(
+		const Bounds &local_bounds,
+		const Transformation &transformation,
+		const size_t &user_data
+	);
+
+	// removes the instance with the given <proxy> ID.
+	void remove(const size_t &proxy);
+
+	// sets the world bounds of the instance with the given <proxy> ID,
+	// reinserting it only if it left its leaf's box.
+	// returns true if it was reinserted.
+	bool move(const size_t &proxy, const Bounds &world_bounds);
+
+	// moves every instance whose Transformation's model matrix
+	// has changed since the last update().
+	void update();
+
+	// removes every instance.
+	void clear();
+
+	// returns the <user_data> of the instance with the given <proxy> ID.
+	inline const size_t &get_user_data(const size_t &proxy) const {
+		return _nodes[proxy].user_data;
+	}
+
+	// pushes back the <user_data> of every instance
+	// whose box is at least partly inside of the <frustum>.
+	void query(const Frustum &frustum, std::vector<size_t> &results) const;
+
+	// pushes back the <user_data> of every instance
+	// whose box touches the sphere at the <center> with the <radius>.
+	void query(
+		const glm::vec3 &center,
+		const float &radius,
+		std::vector<size_t> &results
+	) const;
+
+	// returns true if the ray from the <origin> along the <direction>
+	// enters any instance's box within the <max_distance>,
+	// setting the <hit> to the nearest one.
+	// the boxes are grown by the margin, so the caller should test
+	// the instance's geometry to pick exactly.
+	bool raycast(
+		const glm::vec3 &origin,
+		const glm::vec3 &direction,
+		const float &max_distance,
+		RayHit &hit
+	) const;
+
+private:
+	// returns the index of an unused node.
+	int32_t _allocate_node();
+
+	// returns the node at <index> to the free list.
+	void _free_node(const int32_t &index);
+
+	// places the <leaf> next to the sibling that grows the tree the least.
+	void _insert_leaf(const int32_t &leaf);
+
+	// takes the <leaf> out of the tree, removing its parent.
+	void _remove_leaf(const int32_t &leaf);
+
+	// fixes the heights and boxes of every ancestor from <index> upward,
+	// balancing each of them along the way.
+	void _refit_upward(int32_t index);
+
+	// rotates the node at <index> if one of its children
+	// is more than one level taller than the other,
+	// and returns the index of the node now in its place.
+	int32_t _balance(const int32_t &index);
+
+	// pushes back the <user_data> of every leaf under the node at <index>.
+	void _collect_leaves(
+		const int32_t &index, std::vector<size_t> &results
+	) const;
+};
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,421 @@
+#include "shadow_maps.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/matrix.hpp>
+#include "frustum.hpp"
+#include "light_clusters.hpp"
+#include "../system/gl_state.hpp"
+
+static const std::filesystem::path DEPTH_SHADER_V_PATH = (
+	"guru/shader/default_glsl/depth_shader.v_shader"
+);
+static const std::filesystem::path DEPTH_SHADER_F_PATH = (
+	"guru/shader/default_glsl/depth_shader.f_shader"
+);
+
+// the FNV-1a offset basis and prime, which hash what a map was rendered with.
+static const uint64_t HASH_BASIS = 14695981039346656037ull;
+static const uint64_t HASH_PRIME = 1099511628211ull;
+
+// returns the <hash> continued over the <n_bytes> of the <data>.
+static uint64_t hash_bytes(
+	uint64_t hash, const void *data, const size_t &n_bytes
+) {
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	for (size_t i = 0; i < n_bytes; ++i) {
+		hash ^= bytes[i];
+		hash *= HASH_PRIME;
+	}
+	return hash;
+}
+
+// returns an up vector that isn't parallel to the <forward>.
+static glm::vec3 get_light_up(const glm::vec3 &forward) {
+	return (
+		std::abs(forward.y) > 0.99f
+		? glm::vec3(1.0f, 0.0f, 0.0f)
+		: glm::vec3(0.0f, 1.0f, 0.0f)
+	);
+}
+
+namespace gu {
+ShadowMaps::~ShadowMaps() {
+	deallocate();
+}
+
+bool ShadowMaps::init(const int &cascade_size, const int &spot_size) {
+	if (cascade_size <= 0 or spot_size <= 0)
+		return false;
+	deallocate();
+	if (not _depth_shader.build_from_files(
+		DEPTH_SHADER_V_PATH, DEPTH_SHADER_F_PATH
+	))
+		return false;
+
+	_create_maps(_cascades, static_cast<GLsizei>(cascade_size), N_CASCADES);
+	_create_maps(_spot_maps, static_cast<GLsizei>(spot_size), MAX_SPOT_SHADOWS);
+
+	// the framebuffer only has a depth attachment,
+	// which is switched to the layer that's being rendered.
+	glGenFramebuffers(1, &_framebuffer_ID);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _framebuffer_ID);
+	glFramebufferTextureLayer(
+		GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, _cascades.texture_ID, 0, 0
+	);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	// checks if the build was successful.
+	GLenum buffer_status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
+	if (buffer_status != GL_FRAMEBUFFER_COMPLETE) {
+		std::cerr
+			<< "ShadowMaps: the Framebuffer of "
+			<< "<_framebuffer_ID> failed to be created."
+			<< std::endl;
+		deallocate();
+		return false;
+	}
+
+	glGenBuffers(1, &_shadow_UBO_ID);
+	return true;
+}
+
+bool ShadowMaps::add_spot_light(SpotLight *spot_light) {
+	if (
+		not spot_light
+		or _spot_lights.size() >= MAX_SPOT_SHADOWS
+		or std::find(
+			_spot_lights.begin(), _spot_lights.end(), spot_light
+		) != _spot_lights.end()
+	)
+		return false;
+	_spot_lights.push_back(spot_light);
+	return true;
+}
+
+void ShadowMaps::clear_spot_lights() {
+	for (SpotLight *spot_light : _spot_lights)
+		spot_light->set_shadow_layer(-1);
+	_spot_lights.clear();
+}
+
+void ShadowMaps::set_n_cascades(const size_t &n_cascades) {
+	_n_cascades = std::clamp(n_cascades, static_cast<size_t>(1), N_CASCADES);
+}
+
+void ShadowMaps::update(
+	const Camera &camera, const std::vector<Caster> &casters
+) {
+	_stats = Stats();
+	if (not is_initialized())
+		return;
+
+	// the maps are rendered depth-only. the depth is pushed back
+	// by the slope of each triangle, which hides most shadow acne.
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _framebuffer_ID);
+	GLState::set_blend(false);
+	GLState::set_cull_face(GL_NONE);
+	GLState::set_depth_test(true);
+	GLState::set_depth_func(GL_LESS);
+	glDepthMask(GL_TRUE);
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	glPolygonOffset(2.0f, 4.0f);
+	_depth_shader.use();
+	res::GeometryArena::geometry_arena.bind();
+
+	// splits the view between an even and a logarithmic spacing,
+	// rendering a cascade for each split.
+	size_t n_cascades = _dir_light ? _n_cascades : 0;
+	_shadow_data.view_mat = camera.get_view();
+	if (n_cascades > 0) {
+		glViewport(0, 0, _cascades.size, _cascades.size);
+		glm::vec3 light_dir = glm::normalize(
+			static_cast<glm::vec3>(_dir_light->get_forward())
+		);
+		float near = std::max(camera.get_min_render_distance(), 1e-4f);
+		float far = std::max(
+			std::min(camera.get_max_render_distance(), _shadow_distance),
+			near * 2.0f
+		);
+		float split_near = near;
+		for (size_t i = 0; i < n_cascades; ++i) {
+			float t = static_cast<float>(i + 1) / n_cascades;
+			float even_split = near + (far - near) * t;
+			float log_split = near * std::pow(far / near, t);
+			float split_far = (
+				even_split + (log_split - even_split) * _split_lambda
+			);
+
+			glm::mat4 light_PV_mat = _fit_cascade(
+				camera, light_dir, split_near, split_far
+			);
+			_shadow_data.cascade_mats[i] = light_PV_mat;
+			_shadow_data.cascade_splits[i] = split_far;
+			_render_layer(
+				_cascades, static_cast<GLsizei>(i), light_PV_mat, casters
+			);
+			split_near = split_far;
+		}
+	}
+
+	// renders each SpotLight's cone from its position.
+	glViewport(0, 0, _spot_maps.size, _spot_maps.size);
+	for (size_t i = 0; i < _spot_lights.size(); ++i) {
+		SpotLight &spot_light = *_spot_lights[i];
+		spot_light.set_shadow_layer(static_cast<int>(i));
+
+		glm::vec3 diffuse = spot_light.get_diffuse().as_rgb();
+		glm::vec3 specular = spot_light.get_specular().as_rgb();
+		float range = LightClusters::calc_range(
+			glm::vec3(
+				spot_light.get_constant().get_value(),
+				spot_light.get_linear().get_value(),
+				spot_light.get_quadratic().get_value()
+			),
+			std::max({
+				diffuse.x, diffuse.y, diffuse.z,
+				specular.x, specular.y, specular.z
+			}),
+			_light_threshold
+		);
+		float far = std::max(
+			std::min(range, camera.get_max_render_distance()), 0.2f
+		);
+
+		float outer_cutoff = std::clamp(
+			spot_light.get_outer_cutoff().get_value(), 0.01f, 1.0f
+		);
+		float fov = std::min(
+			2.0f * std::acos(outer_cutoff) + glm::radians(2.0f),
+			glm::radians(170.0f)
+		);
+		glm::vec3 position = static_cast<glm::vec3>(spot_light.get_position());
+		glm::vec3 forward = glm::normalize(
+			static_cast<glm::vec3>(spot_light.get_forward())
+		);
+		glm::mat4 light_PV_mat = (
+			glm::perspective(fov, 1.0f, std::max(far * 1e-3f, 0.05f), far)
+			* glm::lookAt(position, position + forward, get_light_up(forward))
+		);
+		_shadow_data.spot_mats[i] = light_PV_mat;
+		_render_layer(
+			_spot_maps, static_cast<GLsizei>(i), light_PV_mat, casters
+		);
+	}
+
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
+	glm::ivec4 viewport = camera.get_viewport();
+	glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+
+	// sends the matrices to the "ShadowBlock".
+	_shadow_data.info = glm::ivec4(
+		static_cast<int>(n_cascades),
+		static_cast<int>(_spot_lights.size()),
+		_dir_light_index,
+		0
+	);
+	glBindBuffer(GL_UNIFORM_BUFFER, _shadow_UBO_ID);
+	glBufferData(
+		GL_UNIFORM_BUFFER,
+		sizeof(UniformBlocks::ShadowData),
+		&_shadow_data,
+		GL_DYNAMIC_DRAW
+	);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	bind();
+}
+
+void ShadowMaps::bind() const {
+	if (not is_initialized())
+		return;
+	GLState::bind_texture(
+		CASCADES_TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, _cascades.texture_ID
+	);
+	GLState::bind_texture(
+		SPOT_TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, _spot_maps.texture_ID
+	);
+	glBindBufferBase(
+		GL_UNIFORM_BUFFER, UniformBlocks::SHADOW_BINDING, _shadow_UBO_ID
+	);
+}
+
+void ShadowMaps::deallocate() {
+	for (MapArray *maps : {&_cascades, &_spot_maps}) {
+		if (maps->texture_ID != 0) {
+			glDeleteTextures(1, &maps->texture_ID);
+			GLState::forget_texture(maps->texture_ID);
+		}
+		*maps = MapArray();
+	}
+
+	if (_framebuffer_ID != 0) {
+		glDeleteFramebuffers(1, &_framebuffer_ID);
+		GLState::forget_framebuffer(_framebuffer_ID);
+	}
+	_framebuffer_ID = 0;
+
+	// the shaders go back to reading no shadows.
+	if (_shadow_UBO_ID != 0) {
+		glDeleteBuffers(1, &_shadow_UBO_ID);
+		UniformBlocks::bind_no_shadows();
+	}
+	_shadow_UBO_ID = 0;
+}
+
+glm::mat4 ShadowMaps::_fit_cascade(
+	const Camera &camera,
+	const glm::vec3 &light_dir,
+	const float &near,
+	const float &far
+) const {
+	// finds the corners of the slice by moving along the edges
+	// of the view volume, from its near corners to its far corners.
+	glm::mat4 inv_proj_mat = glm::inverse(camera.get_projection());
+	glm::mat4 inv_view_mat = glm::inverse(camera.get_view());
+	float view_near = camera.get_min_render_distance();
+	float view_depth = std::max(
+		camera.get_max_render_distance() - view_near, 1e-4f
+	);
+	float t_near = (near - view_near) / view_depth;
+	float t_far = (far - view_near) / view_depth;
+
+	glm::vec3 corners[8];
+	glm::vec3 center = glm::vec3(0.0f);
+	for (int i = 0; i < 4; ++i) {
+		float x = (i & 1) ? 1.0f : -1.0f;
+		float y = (i & 2) ? 1.0f : -1.0f;
+		glm::vec4 near_corner = inv_proj_mat * glm::vec4(x, y, -1.0f, 1.0f);
+		glm::vec4 far_corner = inv_proj_mat * glm::vec4(x, y, 1.0f, 1.0f);
+		near_corner /= near_corner.w;
+		far_corner /= far_corner.w;
+		glm::vec4 edge = far_corner - near_corner;
+		corners[i] = glm::vec3(inv_view_mat * (near_corner + edge * t_near));
+		corners[i + 4] = glm::vec3(inv_view_mat * (near_corner + edge * t_far));
+		center += corners[i] + corners[i + 4];
+	}
+	center /= 8.0f;
+
+	// the slice is fit by its bounding sphere, so the projection's size
+	// doesn't change as the Camera turns.
+	float radius = 0.0f;
+	for (const glm::vec3 &corner : corners)
+		radius = std::max(radius, glm::length(corner - center));
+	radius = std::ceil(radius * 16.0f) / 16.0f;
+
+	// the near plane is pulled toward the light by the shadow distance,
+	// so that casters outside of the slice still cast into it.
+	glm::mat4 light_view_mat = glm::lookAt(
+		center - light_dir * radius, center, get_light_up(light_dir)
+	);
+	glm::mat4 light_proj_mat = glm::ortho(
+		-radius, radius, -radius, radius, -_shadow_distance, 2.0f * radius
+	);
+
+	// moves the projection so that the world origin lands on a texel,
+	// which keeps the shadows' edges still as the slice moves.
+	float half_size = static_cast<float>(_cascades.size) * 0.5f;
+	glm::vec4 origin = (
+		light_proj_mat * light_view_mat * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)
+	);
+	float origin_x = origin.x * half_size;
+	float origin_y = origin.y * half_size;
+	light_proj_mat[3][0] += (std::round(origin_x) - origin_x) / half_size;
+	light_proj_mat[3][1] += (std::round(origin_y) - origin_y) / half_size;
+	return light_proj_mat * light_view_mat;
+}
+
+void ShadowMaps::_render_layer(
+	MapArray &maps,
+	const GLsizei &layer,
+	const glm::mat4 &light_PV_mat,
+	const std::vector<Caster> &casters
+) {
+	// culls the casters and hashes the matrix with what's left.
+	Frustum frustum;
+	frustum.set(light_PV_mat);
+	_visible_casters.clear();
+	uint64_t hash = hash_bytes(HASH_BASIS, &light_PV_mat, sizeof(glm::mat4));
+	for (const Caster &caster : casters) {
+		if (not caster.model or caster.model->is_loading())
+			continue;
+		if (not frustum.intersects(
+			caster.model->get_bounds().transformed(caster.model_mat)
+		)) {
+			++_stats.n_casters_culled;
+			continue;
+		}
+		_visible_casters.push_back(&caster);
+
+		size_t n_meshes = caster.model->get_n_meshes();
+		hash = hash_bytes(hash, &caster.model, sizeof(caster.model));
+		hash = hash_bytes(hash, &n_meshes, sizeof(n_meshes));
+		hash = hash_bytes(hash, &caster.model_mat, sizeof(glm::mat4));
+	}
+
+	if (hash == maps.hashes[layer]) {
+		++_stats.n_maps_reused;
+		return;
+	}
+	maps.hashes[layer] = hash;
+
+	glFramebufferTextureLayer(
+		GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, maps.texture_ID, 0, layer
+	);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	for (const Caster *caster : _visible_casters) {
+		_depth_shader.set_PVM_mat(light_PV_mat * caster->model_mat);
+		for (size_t i = 0; i < caster->model->get_n_meshes(); ++i)
+			caster->model->get_mesh(i).draw();
+	}
+	++_stats.n_maps_rendered;
+	_stats.n_casters_drawn += _visible_casters.size();
+}
+
+void ShadowMaps::_create_maps(
+	MapArray &maps, const GLsizei &size, const GLsizei &n_layers
+) {
+	maps.size = size;
+	maps.hashes.assign(static_cast<size_t>(n_layers), 0);
+	glGenTextures(1, &maps.texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D_ARRAY, maps.texture_ID);
+	glTexImage3D(
+		GL_TEXTURE_2D_ARRAY,
+		0,
+		GL_DEPTH_COMPONENT24,
+		size,
+		size,
+		n_layers,
+		0,
+		GL_DEPTH_COMPONENT,
+		GL_FLOAT,
+		nullptr
+	);
+
+	// the maps are compared against with linear filtering,
+	// which softens the shadows' edges, and anything outside of them is lit.
+	static const GLfloat BORDER_COLOR[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(
+		GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER
+	);
+	glTexParameteri(
+		GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER
+	);
+	glTexParameterfv(
+		GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, BORDER_COLOR
+	);
+	glTexParameteri(
+		GL_TEXTURE_2D_ARRAY,
+		GL_TEXTURE_COMPARE_MODE,
+		GL_COMPARE_REF_TO_TEXTURE
+	);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	GLState::bind_texture(GL_TEXTURE_2D_ARRAY, 0);
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,211 @@
+/**
+ * shadow_maps.hpp
+ * ---
+ * this file defines the ShadowMaps class, which renders the depth
+ * of the shadow casters from the view of one DirLight and of
+ * up to UniformBlocks::MAX_SPOT_SHADOWS SpotLights,
+ * so that the light shaders can tell which fragments are in shadow.
+ *
+ * ---
+ * the DirLight's shadows are split into cascades along the view
+ * of a Camera. each cascade covers a slice of the view up to the
+ * shadow distance and is fit with an orthographic projection
+ * that's snapped to its texels, so the shadows don't shimmer
+ * as the Camera moves. a SpotLight's shadows are rendered with
+ * a perspective projection from its position along its forward,
+ * wide enough for its outer cutoff and as deep as its range.
+ *
+ * the maps are layers of two depth textures that are compared
+ * against in the shaders (sampler2DArrayShadow):
+ *
+ * uniform sampler2DArrayShadow _cascade_shadow_maps;
+ * uniform sampler2DArrayShadow _spot_shadow_maps;
+ *
+ * with their matrices in the "ShadowBlock" (see "uniform_blocks.hpp").
+ * a SpotLight finds its layer with SpotLight::get_shadow_layer().
+ *
+ * ---
+ * the casters are drawn with a depth-only ModelShader built from
+ * "depth_shader.v_shader" and "depth_shader.f_shader",
+ * and each map only draws the casters that are inside of it.
+ * a map is only rendered again if its light's projection
+ * or the casters inside of it have changed since it was last rendered.
+ * skinned casters aren't supported, since they're drawn unposed.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <glad/gl.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include "camera.hpp"
+#include "lights.hpp"
+#include "../resources/model/model_resource.hpp"
+#include "../shader/model_shader.hpp"
+#include "../shader/uniform_blocks.hpp"
+
+namespace gu {
+class ShadowMaps {
+public:
+	static constexpr size_t N_CASCADES = UniformBlocks::N_CASCADES;
+	static constexpr size_t MAX_SPOT_SHADOWS = UniformBlocks::MAX_SPOT_SHADOWS;
+
+	// the texture units the maps are bound to,
+	// which follow the DeferredShader's.
+	static constexpr GLuint CASCADES_TEXTURE_UNIT = 14;
+	static constexpr GLuint SPOT_TEXTURE_UNIT = 15;
+
+	// a model that casts shadows with its <model_mat>.
+	struct Caster {
+		const ModelResource *model = nullptr;
+		glm::mat4 model_mat = glm::mat4(1.0f);
+	};
+
+	/**
+	 * ShadowMaps::Stats
+	 * ---
+	 * this struct counts the work done by the last call to update(...).
+	 *
+	 */
+	struct Stats {
+		size_t n_maps_rendered = 0;
+		size_t n_maps_reused = 0; // skipped for not having changed
+		size_t n_casters_drawn = 0;
+		size_t n_casters_culled = 0;
+	};
+
+private:
+	// a depth texture with a layer per map.
+	struct MapArray {
+		GLuint texture_ID = 0;
+		GLsizei size = 0;
+		std::vector<uint64_t> hashes; // of what each layer was rendered with
+	};
+
+	ModelShader _depth_shader;
+	GLuint _framebuffer_ID = 0;
+	MapArray _cascades;
+	MapArray _spot_maps;
+	DirLight *_dir_light = nullptr;
+	int _dir_light_index = 0; // in the "LightBlock"
+	std::vector<SpotLight *> _spot_lights;
+	size_t _n_cascades = N_CASCADES;
+	float _shadow_distance = 100.0f;
+	float _split_lambda = 0.75f;
+	float _light_threshold = 1.0f / 256.0f;
+	UniformBlocks::ShadowData _shadow_data;
+	GLuint _shadow_UBO_ID = 0;
+	std::vector<const Caster *> _visible_casters;
+	Stats _stats;
+
+public:
+	// ctor. sets the default bias.
+	inline ShadowMaps() { set_bias(0.0005f, 0.02f); }
+
+	// dtor. deletes the textures and buffers.
+	~ShadowMaps();
+
+	ShadowMaps(const ShadowMaps &) = delete;
+	ShadowMaps &operator=(const ShadowMaps &) = delete;
+
+	// returns true if the depth shader was built and the textures
+	// were created, with each cascade being <cascade_size> texels across
+	// and each SpotLight's map being <spot_size> texels across.
+	bool init(const int &cascade_size = 2048, const int &spot_size = 1024);
+
+	// returns true if the ShadowMaps have been initialized.
+	inline bool is_initialized() const { return _framebuffer_ID != 0; }
+
+	// sets the DirLight whose shadows are cascaded, or nullptr for none.
+	// the <index> is the DirLight's index in the "LightBlock",
+	// which tells the shaders which DirLight is shadowed.
+	inline void set_dir_light(DirLight *dir_light, const int &index = 0) {
+		_dir_light = dir_light;
+		_dir_light_index = index;
+	}
+
+	// adds the <spot_light> to those with shadows, returning false
+	// if it already has shadows or there are MAX_SPOT_SHADOWS already.
+	bool add_spot_light(SpotLight *spot_light);
+
+	// removes every SpotLight from those with shadows.
+	void clear_spot_lights();
+
+	// sets the number of cascades, from 1 to N_CASCADES.
+	void set_n_cascades(const size_t &n_cascades);
+
+	// sets how far the cascades reach along the Camera's view,
+	// which is limited to the Camera's max render distance.
+	inline void set_shadow_distance(const float &distance) {
+		_shadow_distance = distance;
+	}
+
+	// sets how the cascades are split, from 0 (evenly)
+	// to 1 (logarithmically, with more detail up close).
+	inline void set_split_lambda(const float &lambda) {
+		_split_lambda = lambda;
+	}
+
+	// sets the <depth> bias subtracted from a fragment's depth
+	// and the <normal_offset> that the fragment is moved along its normal
+	// before being compared against the maps, which hide shadow acne.
+	inline void set_bias(const float &depth, const float &normal_offset) {
+		_shadow_data.bias.x = depth;
+		_shadow_data.bias.y = normal_offset;
+	}
+
+	// sets the fraction of a SpotLight's brightest color
+	// below which its light is cut off, which decides how deep its map is.
+	inline void set_light_threshold(const float &threshold) {
+		_light_threshold = threshold;
+	}
+
+	// fits the cascades to the <camera>'s view, renders every map
+	// whose light or <casters> have changed and binds the maps
+	// and the "ShadowBlock". this should be called once per frame per Camera,
+	// after the Camera, the lights and the casters have been updated
+	// and before the frame is drawn, since it changes the framebuffer.
+	// the SpotLights' shadow layers are set here, so this should also
+	// be called before their texels are built by the LightClusters
+	// or the DeferredRenderer.
+	void update(const Camera &camera, const std::vector<Caster> &casters);
+
+	// binds the maps and the "ShadowBlock" of the last update(...),
+	// for when another ShadowMaps was bound since.
+	void bind() const;
+
+	// returns the counts of the last update(...).
+	inline const Stats &get_stats() const { return _stats; }
+
+	// deletes the textures and buffers, and turns off the shadows
+	// in the shaders.
+	void deallocate();
+
+private:
+	// returns the projection * view matrix that fits the cascade
+	// between the view depths <near> and <far> of the <camera>.
+	glm::mat4 _fit_cascade(
+		const Camera &camera,
+		const glm::vec3 &light_dir,
+		const float &near,
+		const float &far
+	) const;
+
+	// renders the casters inside of the <light_PV_mat> to the <layer>
+	// of the <maps> if they or the matrix have changed.
+	void _render_layer(
+		MapArray &maps,
+		const GLsizei &layer,
+		const glm::mat4 &light_PV_mat,
+		const std::vector<Caster> &casters
+	);
+
+	// creates the depth texture of the <maps>
+	// with the given <size> and <n_layers>.
+	static void _create_maps(
+		MapArray &maps, const GLsizei &size, const GLsizei &n_layers
+	);
+};
+} // namespace gu
\ No newline at end of file
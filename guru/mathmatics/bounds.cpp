@@ -0,0 +1,95 @@
+#include "bounds.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace gu {
+void Bounds::expand(const glm::vec3 &point) {
+	min = glm::min(min, point);
+	max = glm::max(max, point);
+}
+
+void Bounds::merge(const Bounds &other) {
+	if (other.is_empty())
+		return;
+	if (is_empty()) {
+		*this = other;
+		return;
+	}
+
+	min = glm::min(min, other.min);
+	max = glm::max(max, other.max);
+
+	// finds the smallest sphere around both spheres.
+	glm::vec3 offset = other.center - center;
+	float dist = glm::length(offset);
+	if (dist + other.radius <= radius)
+		return;
+	if (dist + radius <= other.radius) {
+		center = other.center;
+		radius = other.radius;
+		return;
+	}
+	float new_radius = (dist + radius + other.radius) * 0.5f;
+	center += offset * ((new_radius - radius) / dist);
+	radius = new_radius;
+}
+
+void Bounds::fit_sphere(
+	const glm::vec3 *positions, const size_t &n_points, const size_t &stride
+) {
+	center = (min + max) * 0.5f;
+	float max_dist_sq = 0.0f;
+	const char *bytes = reinterpret_cast<const char *>(positions);
+	for (size_t i = 0; i < n_points; ++i) {
+		const glm::vec3 &position = *reinterpret_cast<const glm::vec3 *>(
+			bytes + i * stride
+		);
+		glm::vec3 offset = position - center;
+		max_dist_sq = std::max(max_dist_sq, glm::dot(offset, offset));
+	}
+	radius = std::sqrt(max_dist_sq);
+}
+
+void Bounds::fit_sphere_to_box() {
+	center = (min + max) * 0.5f;
+	radius = glm::length(max - center);
+}
+
+void Bounds::pad(const float &margin) {
+	if (is_empty())
+		return;
+	min -= glm::vec3(margin);
+	max += glm::vec3(margin);
+	radius += margin;
+}
+
+Bounds Bounds::transformed(const glm::mat4 &mat) const {
+	if (is_empty())
+		return *this;
+
+	// the transformed box is centered on the transformed center of the box,
+	// with each of its extents being the sum of the absolute values
+	// of the matrix's row multiplied by the box's extents.
+	glm::vec3 box_center = (min + max) * 0.5f;
+	glm::vec3 extents = max - box_center;
+	glm::vec3 new_box_center = glm::vec3(mat * glm::vec4(box_center, 1.0f));
+	glm::vec3 new_extents(0.0f);
+	for (int col = 0; col < 3; ++col)
+		for (int row = 0; row < 3; ++row)
+			new_extents[row] += std::abs(mat[col][row]) * extents[col];
+
+	Bounds result;
+	result.min = new_box_center - new_extents;
+	result.max = new_box_center + new_extents;
+	result.center = glm::vec3(mat * glm::vec4(center, 1.0f));
+	float max_scale_sq = std::max({
+		glm::dot(glm::vec3(mat[0]), glm::vec3(mat[0])),
+		glm::dot(glm::vec3(mat[1]), glm::vec3(mat[1])),
+		glm::dot(glm::vec3(mat[2]), glm::vec3(mat[2])),
+	});
+	result.radius = radius * std::sqrt(max_scale_sq);
+	return result;
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * bounds.hpp
+ * ---
+ * this file defines the Bounds struct, which holds
+ * an axis-aligned bounding box and a bounding sphere
+ * that both enclose the same geometry.
+ *
+ * ---
+ * the sphere is tested first since it's cheaper,
+ * and the box is only tested when the sphere can't decide.
+ *
+ */
+
+#pragma once
+#include <cfloat>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace gu {
+struct Bounds {
+	glm::vec3 min = glm::vec3(FLT_MAX); // box
+	glm::vec3 max = glm::vec3(-FLT_MAX); // box
+	glm::vec3 center = glm::vec3(0.0f); // sphere
+	float radius = 0.0f; // sphere
+
+	// returns true if the Bounds don't enclose anything.
+	inline bool is_empty() const { return min.x > max.x; }
+
+	// grows the box to enclose the <point>.
+	// fit_sphere(...) or fit_sphere_to_box() should be called afterwards.
+	void expand(const glm::vec3 &point);
+
+	// grows the box and sphere to enclose the <other> Bounds.
+	void merge(const Bounds &other);
+
+	// centers the sphere on the box and sets its radius
+	// to the farthest of the <n_points> <positions> from it,
+	// with each position being <stride> bytes after the last.
+	void fit_sphere(
+		const glm::vec3 *positions, const size_t &n_points, const size_t &stride
+	);
+
+	// sets the sphere to the one that encloses the box.
+	void fit_sphere_to_box();
+
+	// grows the box and sphere by the <margin> in every direction.
+	void pad(const float &margin);
+
+	// returns the Bounds transformed by the <mat>.
+	// the box is the one that encloses the transformed box,
+	// and the sphere's radius is scaled by the largest scaling of the <mat>.
+	Bounds transformed(const glm::mat4 &mat) const;
+};
+} // namespace gu
\ No newline at end of file
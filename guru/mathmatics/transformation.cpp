@@ -24,6 +24,7 @@ void Transformation::_update_model_matrix() {
 		for (uint8_t i = 0; i < 3; ++i)
 			_model_mat[3][i] = static_cast<float>(_position[i]);
 		_position_is_new = false;
+		++_model_mat_version;
 		return;
 	}
 
@@ -61,5 +62,6 @@ void Transformation::_update_model_matrix() {
 	_orientation_is_new = false;
 	_position_is_new = false;
 	_scaling_is_new = false;
+	++_model_mat_version;
 }
 } // namespace gu
\ No newline at end of file
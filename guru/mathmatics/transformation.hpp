@@ -4,6 +4,11 @@
  * this file defines the Transformation class, which represents
  * a point in 3D space with rotation and scaling.
  *
+ * ---
+ * every change to the model matrix increases its version,
+ * so other objects (e.g. a SceneTree) can tell that it moved
+ * after update() has already cleared the "_is_new" flags.
+ *
  */
 
 #pragma once
@@ -15,6 +20,7 @@ protected:
 	glm::mat4 _model_mat = glm::mat4(1.0);
 	glm::vec3 _scaling = glm::vec3(1.0);
 	bool _scaling_is_new = true;
+	uint32_t _model_mat_version = 0; // increased when <_model_mat> changes
 
 public:
 	// ctor. the function <_update_relative_directions()>
@@ -25,6 +31,11 @@ public:
 	}
 	inline const glm::vec3 &get_scaling() const { return _scaling; }
 
+	// returns the number of times the model matrix has changed.
+	inline const uint32_t &get_model_matrix_version() const {
+		return _model_mat_version;
+	}
+
 	// sets consistent scaling across all three axes.
 	void set_scaling(const float &absolute_scale);
 
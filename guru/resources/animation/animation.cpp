@@ -7,7 +7,9 @@
 
 namespace gu {
 Animation::Animation(
-	const std::filesystem::path &animation_path, ModelResource &model_res
+	const std::filesystem::path &animation_path,
+	ModelResource &model_res,
+	const ClipCompression::Tolerances &tolerances
 ) {
 	Assimp::Importer importer;
 	const aiScene *scene = importer.ReadFile(
@@ -33,7 +35,19 @@ Animation::Animation(
 	set_mat4(_global_inverse_transform, global_transformation);
 
 	_read_hierarchy_data(_root_node, scene->mRootNode);
-	_create_bones(ai_animation, model_res);
+	_create_bones(ai_animation, model_res, tolerances);
+	_flatten_hierarchy();
+
+	#if defined(GURU_PRINT_RESOURCE_DEBUG_MESSAGES)
+	std::cout
+		<< animation_path << " kept " << _compression_stats.n_kept_keys
+		<< " of " << _compression_stats.n_source_keys << " keys ("
+		<< _compression_stats.get_ratio() << "x smaller). max errors: "
+		<< _compression_stats.max_position_error << " (position), "
+		<< _compression_stats.max_orientation_error << " rad (orientation), "
+		<< _compression_stats.max_scaling_error << " (scaling)."
+		<< std::endl;
+	#endif
 }
 
 Animation::Bone *Animation::find_bone(const std::string &name) {
@@ -44,6 +58,22 @@ Animation::Bone *Animation::find_bone(const std::string &name) {
 	return nullptr;
 }
 
+int Animation::find_channel_index(const std::string &name) const {
+	for (size_t i = 0; i < _bones.size(); ++i)
+		if (_bones[i].get_name() == name)
+			return static_cast<int>(i);
+
+	return -1;
+}
+
+int Animation::find_node_index(const std::string &name) const {
+	for (size_t i = 0; i < _skeleton.size(); ++i)
+		if (_skeleton[i].name == name)
+			return static_cast<int>(i);
+
+	return -1;
+}
+
 void Animation::_read_hierarchy_data(AssimpNodeData &node, const aiNode *src) {
 	assert(src);
 	node.name = src->mName.data;
@@ -60,7 +90,9 @@ void Animation::_read_hierarchy_data(AssimpNodeData &node, const aiNode *src) {
 }
 
 void Animation::_create_bones(
-	const aiAnimation *ai_animation, ModelResource &model
+	const aiAnimation *ai_animation,
+	ModelResource &model,
+	const ClipCompression::Tolerances &tolerances
 ) {
 	const size_t &n_channels = ai_animation->mNumChannels;
 	auto &name_to_rig_info = model.name_to_rig_info();
@@ -75,7 +107,14 @@ void Animation::_create_bones(
 			++n_bones;
 		}
 		_bones.push_back(
-			Bone(bone_name, name_to_rig_info[bone_name].bone_ID, channel)
+			Bone(
+				bone_name,
+				name_to_rig_info[bone_name].bone_ID,
+				channel,
+				_duration,
+				tolerances,
+				_compression_stats
+			)
 		);
 	}
 
@@ -83,4 +122,52 @@ void Animation::_create_bones(
 	// of the rigging map from the ModelResource.
 	_name_to_rig_info = name_to_rig_info;
 }
+
+void Animation::_flatten_hierarchy() {
+	std::map<std::string, int> name_to_channel_index;
+	for (size_t i = 0; i < _bones.size(); ++i)
+		name_to_channel_index[_bones[i].get_name()] = static_cast<int>(i);
+
+	_skeleton.clear();
+	_append_skeleton_node(_root_node, -1, name_to_channel_index);
+}
+
+// recursive method.
+void Animation::_append_skeleton_node(
+	const AssimpNodeData &node,
+	const int &parent_index,
+	const std::map<std::string, int> &name_to_channel_index
+) {
+	SkeletonNode skeleton_node;
+	skeleton_node.name = node.name;
+	skeleton_node.rel_transform_mat = node.rel_transform_mat;
+	skeleton_node.parent_index = parent_index;
+
+	// splits the relative transform into position, orientation and scaling.
+	const glm::mat4 &mat = node.rel_transform_mat;
+	glm::mat3 rot_mat(mat);
+	for (uint8_t c = 0; c < 3; ++c) {
+		float scaling = glm::length(rot_mat[c]);
+		skeleton_node.bind_scaling[c] = scaling;
+		if (scaling > 0.0f)
+			rot_mat[c] /= scaling;
+	}
+	skeleton_node.bind_position = glm::vec3(mat[3]);
+	skeleton_node.bind_orientation = glm::normalize(glm::quat_cast(rot_mat));
+
+	auto channel_it = name_to_channel_index.find(node.name);
+	if (channel_it != name_to_channel_index.end())
+		skeleton_node.channel_index = channel_it->second;
+
+	auto rig_it = _name_to_rig_info.find(node.name);
+	if (rig_it != _name_to_rig_info.end()) {
+		skeleton_node.bone_ID = rig_it->second.bone_ID;
+		skeleton_node.local_space_to_bone = rig_it->second.local_space_to_bone;
+	}
+
+	int index = static_cast<int>(_skeleton.size());
+	_skeleton.push_back(skeleton_node);
+	for (const auto &child : node.children)
+		_append_skeleton_node(child, index, name_to_channel_index);
+}
 } // namespace gu
\ No newline at end of file
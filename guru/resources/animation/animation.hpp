@@ -9,6 +9,7 @@
 #include <vector>
 #include <string>
 #include "../model/model_resource.hpp"
+#include "clip_compression.hpp"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 
@@ -24,24 +25,70 @@ public:
 		std::vector<AssimpNodeData> children;
 	};
 
+	// a node of the rigging hierarchy flattened into an array
+	// in which every parent comes before its children.
+	struct SkeletonNode {
+		std::string name; // only used when setting up, never while animating
+		glm::mat4 rel_transform_mat = glm::mat4(1.0); // relative to parent
+		int parent_index = -1; // index in <_skeleton>, -1 for the root
+		int channel_index = -1; // index in <_bones>, -1 if not animated
+		int bone_ID = -1; // index in the final bone matrices, -1 if unused
+		glm::mat4 local_space_to_bone = glm::mat4(1.0f);
+
+		// the <rel_transform_mat> split into its parts, which is used
+		// as the pose of the node when it's blended with a clip
+		// that doesn't animate it.
+		glm::vec3 bind_position = glm::vec3(0.0f);
+		glm::quat bind_orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		glm::vec3 bind_scaling = glm::vec3(1.0f);
+	};
+
 	double _duration = 0.0;
 	double _ticks_per_second = 0.0;
 	AssimpNodeData _root_node;
 	glm::mat4 _global_inverse_transform = glm::mat4(1.0f);
 	std::vector<Bone> _bones;
 	std::map<std::string, Mesh::RigInfo> _name_to_rig_info; // ModelResource copy
+	std::vector<SkeletonNode> _skeleton; // <_root_node> in topological order
+	ClipCompression::Stats _compression_stats;
 
-	Animation(const std::filesystem::path &animation_path, ModelResource &model_res);
+	// ctor. loads the first animation of the file at <animation_path>
+	// for the rig of the <model_res>, compressing its keyframes
+	// within the given <tolerances>.
+	Animation(
+		const std::filesystem::path &animation_path,
+		ModelResource &model_res,
+		const ClipCompression::Tolerances &tolerances
+			= ClipCompression::Tolerances()
+	);
 
 	Bone *find_bone(const std::string& name);
 
+	// returns the index in <_bones> of the Bone with the given <name>,
+	// or -1 if this Animation doesn't animate it.
+	int find_channel_index(const std::string &name) const;
+
+	// returns the index in <_skeleton> of the node with the given <name>,
+	// or -1 if there's no such node.
+	int find_node_index(const std::string &name) const;
+
 	inline const double &get_duration() const { return _duration; }
 	inline const double &get_ticks_per_second() const { return _ticks_per_second; }
 	inline const AssimpNodeData &get_root_node() const { return _root_node; }
+	inline const std::vector<SkeletonNode> &get_skeleton() const {
+		return _skeleton;
+	}
+	inline const std::vector<Bone> &get_bones() const { return _bones; }
 	inline std::map<std::string, Mesh::RigInfo> &get_name_to_rig_info() {
 		return _name_to_rig_info;
 	}
 
+	// returns how much the keyframes were compressed
+	// and the largest errors the compression caused.
+	inline const ClipCompression::Stats &get_compression_stats() const {
+		return _compression_stats;
+	}
+
 	inline const glm::mat4 &get_global_inverse_transform() const {
 		return _global_inverse_transform;
 	}
@@ -49,7 +96,23 @@ public:
 private:
 	void _read_hierarchy_data(AssimpNodeData &node, const aiNode *src);
 
-	void _create_bones(const aiAnimation *ai_animation, ModelResource &model);
+	void _create_bones(
+		const aiAnimation *ai_animation,
+		ModelResource &model,
+		const ClipCompression::Tolerances &tolerances
+	);
+
+	// bakes the <_root_node> hierarchy into the <_skeleton>,
+	// resolving each node's Bone and rigging info by name once
+	// so that no names are looked up while animating.
+	void _flatten_hierarchy();
+
+	// appends the <node> and all of its descendants to the <_skeleton>.
+	void _append_skeleton_node(
+		const AssimpNodeData &node,
+		const int &parent_index,
+		const std::map<std::string, int> &name_to_channel_index
+	);
 };
 } // namespace gu
 
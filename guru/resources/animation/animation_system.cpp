@@ -0,0 +1,63 @@
+#include "animation_system.hpp"
+#include <algorithm>
+#include "bone_palette.hpp"
+#include "../../system/thread_pool.hpp"
+
+namespace gu {
+void AnimationSystem::add(Animator &animator) {
+	auto it = std::find(_animators.begin(), _animators.end(), &animator);
+	if (it == _animators.end())
+		_animators.push_back(&animator);
+}
+
+void AnimationSystem::remove(Animator &animator) {
+	_animators.erase(
+		std::remove(_animators.begin(), _animators.end(), &animator),
+		_animators.end()
+	);
+}
+
+void AnimationSystem::update() {
+	_update(nullptr);
+}
+
+void AnimationSystem::update(const Camera &camera) {
+	_update(&camera);
+}
+
+void AnimationSystem::_update(const Camera *camera) {
+	auto &bone_palette = res::BonePalette::bone_palette;
+
+	// places every Animator's matrices in the palette before any are written,
+	// since allocating can move the palette's storage.
+	for (Animator *animator : _animators) {
+		size_t offset = bone_palette.allocate(animator->get_n_bones());
+		animator->set_palette_offset(offset);
+	}
+
+	_bone_mats.resize(_animators.size());
+	for (size_t i = 0; i < _animators.size(); ++i) {
+		_bone_mats[i] = bone_palette.get_matrices(
+			_animators[i]->get_palette_offset()
+		);
+	}
+
+	// each Animator only writes to its own matrices and state,
+	// and the Animations they read are never modified.
+	ThreadPool::thread_pool.run_parallel(
+		_animators.size(),
+		[this, camera](size_t i) {
+			if (camera)
+				_animators[i]->update_lod(*camera);
+			_animators[i]->update_animation(_bone_mats[i]);
+		}
+	);
+
+	_n_bones_evaluated = 0;
+	_n_bones_saved = 0;
+	for (const Animator *animator : _animators) {
+		_n_bones_evaluated += animator->get_n_bones_evaluated();
+		_n_bones_saved += animator->get_n_bones_saved();
+	}
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * animation_system.hpp
+ * ---
+ * this file defines the AnimationSystem class, which updates
+ * many Animators at once across the ThreadPool's threads
+ * and writes their final bone matrices straight into the BonePalette,
+ * so they're ready to be sent to the videocard with one upload.
+ *
+ * ---
+ * an AnimationSystem only holds pointers to its Animators,
+ * so an Animator must be removed before it's destroyed.
+ *
+ * ---
+ * when updated with a Camera, each Animator with an enabled LODPolicy
+ * first picks its LOD_LEVEL, and the bone evaluations made and saved
+ * by every Animator are totaled for the frame.
+ *
+ */
+
+#pragma once
+#include <vector>
+#include "animator.hpp"
+
+namespace gu {
+class AnimationSystem {
+private:
+	std::vector<Animator *> _animators;
+	std::vector<glm::mat4 *> _bone_mats; // per Animator, reused every update
+	size_t _n_bones_evaluated = 0; // during the last update
+	size_t _n_bones_saved = 0; // during the last update
+
+public:
+	// adds the <animator> to be updated by this AnimationSystem.
+	void add(Animator &animator);
+
+	// stops the <animator> from being updated by this AnimationSystem.
+	void remove(Animator &animator);
+
+	// stops every Animator from being updated by this AnimationSystem.
+	inline void clear() { _animators.clear(); }
+
+	inline size_t get_n_animators() const { return _animators.size(); }
+
+	// advances every Animator and calculates their final bone matrices
+	// in parallel, writing them to the BonePalette.
+	// afterwards, each Animator's matrices begin at its palette offset
+	// and the BonePalette can be uploaded.
+	// this must be called from the main thread after the palette is cleared.
+	void update();
+
+	// updates every Animator like above after each one picks
+	// its LOD_LEVEL from how it appears to the <camera>.
+	void update(const Camera &camera);
+
+	// returns the total number of bones evaluated and the total number
+	// skipped by the Animators' LOD_LEVELs during the last update.
+	inline const size_t &get_n_bones_evaluated() const {
+		return _n_bones_evaluated;
+	}
+	inline const size_t &get_n_bones_saved() const { return _n_bones_saved; }
+
+private:
+	// updates every Animator, first updating its LOD_LEVEL
+	// if a <camera> is given.
+	void _update(const Camera *camera);
+};
+} // namespace gu
\ No newline at end of file
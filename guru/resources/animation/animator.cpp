@@ -1,62 +1,387 @@
 #include "animator.hpp"
 #include "../../system/time.hpp"
+#include <algorithm>
 #include <iostream>
+#include <glm/geometric.hpp>
 
 namespace gu {
-Animator::Animator() {
-	_setup_bone_matrices();
-}
+Animator::Animator() {}
 
 Animator::Animator(Animation &animation) {
-	_setup_bone_matrices();
 	set_animation(animation);
 }
 
 void Animator::_setup_bone_matrices() {
-	_final_bone_matrices.reserve(Settings::MAX_BONES);
-	for (size_t i = 0; i < Settings::MAX_BONES; ++i)
-		_final_bone_matrices.push_back(glm::mat4(1.0f));
+	size_t n_bones = 0;
+	for (const auto &[name, rig_info] : _animation->get_name_to_rig_info())
+		n_bones = std::max(n_bones, static_cast<size_t>(rig_info.bone_ID + 1));
+	_final_bone_matrices.assign(n_bones, glm::mat4(1.0f));
+
+	size_t n_nodes = _animation->get_skeleton().size();
+	_global_transforms.assign(n_nodes, glm::mat4(1.0f));
+	_node_animated.assign(n_nodes, 0);
+
+	// a node is a leaf if no other node names it as a parent.
+	const auto &skeleton = _animation->get_skeleton();
+	_leaf_nodes.assign(n_nodes, 1);
+	for (const Animation::SkeletonNode &node : skeleton)
+		if (node.parent_index >= 0)
+			_leaf_nodes[node.parent_index] = 0;
+	_n_leaf_nodes = std::count(_leaf_nodes.begin(), _leaf_nodes.end(), 1);
+
+	_lod_prev_mats.assign(n_bones, glm::mat4(1.0f));
+	_lod_curr_mats.assign(n_bones, glm::mat4(1.0f));
+	_lod_has_evaluated = false;
 }
 
 void Animator::set_animation(Animation &animation) {
-	_current_time = 0.0;
 	_animation = &animation;
+	_fading = false;
+	_setup_bone_matrices();
+	_setup_layer(_base, animation);
+
+	// the layers are mapped onto the new skeleton.
+	for (Layer &layer : _layers)
+		_setup_layer(layer, *layer.animation);
+	_update_animated_nodes();
+}
+
+void Animator::cross_fade(Animation &animation, const double &duration) {
+	if (not _animation or duration <= 0.0) {
+		if (not _animation)
+			set_animation(animation);
+		else {
+			_fading = false;
+			_setup_layer(_base, animation);
+			_update_animated_nodes();
+		}
+		return;
+	}
+
+	// the current clip becomes the one being faded out of.
+	std::swap(_base, _fade_source);
+	_setup_layer(_base, animation);
+	_fading = true;
+	_fade_elapsed = 0.0;
+	_fade_duration = duration;
+	_update_animated_nodes();
+}
+
+size_t Animator::add_layer(
+	Animation &animation,
+	const BLEND_MODE &blend_mode,
+	const float &weight,
+	const BoneMask *mask
+) {
+	if (not _animation) {
+		std::cerr
+			<< "a layer can't be added to an Animator without an Animation."
+			<< std::endl;
+		return _layers.size();
+	}
+
+	_layers.emplace_back();
+	Layer &layer = _layers.back();
+	layer.blend_mode = blend_mode;
+	layer.weight = weight;
+	layer.mask = mask;
+	_setup_layer(layer, animation);
+	_update_animated_nodes();
+	return _layers.size() - 1;
+}
+
+void Animator::clear_layers() {
+	_layers.clear();
+	if (_animation)
+		_update_animated_nodes();
+}
+
+void Animator::_setup_layer(Layer &layer, Animation &animation) {
+	const auto &skeleton = _animation->get_skeleton();
+	layer.animation = &animation;
+	layer.time = 0.0;
+	layer.cursors.assign(
+		animation.get_bones().size(), Animation::Bone::Cursor()
+	);
+
+	// every node starts in its bind pose, which is kept
+	// for the nodes (and channels) the clip doesn't animate.
+	layer.node_channels.resize(skeleton.size());
+	layer.batch.resize(skeleton.size());
+	for (size_t i = 0; i < skeleton.size(); ++i) {
+		const Animation::SkeletonNode &node = skeleton[i];
+		layer.node_channels[i] = (
+			&animation == _animation
+			? node.channel_index
+			: animation.find_channel_index(node.name)
+		);
+		layer.batch.set_constant(
+			i, node.bind_position, node.bind_orientation, node.bind_scaling
+		);
+	}
+
+	if (layer.blend_mode == ADDITIVE) {
+		_sample_layer(layer);
+		layer.reference = layer.batch;
+	}
+}
+
+void Animator::_advance_layer(Layer &layer, const double &delta) {
+	const Animation &animation = *layer.animation;
+	layer.time += animation.get_ticks_per_second() * delta;
+	layer.time = fmod(layer.time, animation.get_duration());
+}
+
+void Animator::_sample_layer(Layer &layer, const uint8_t *skipped_nodes) {
+	const auto &bones = layer.animation->get_bones();
+	float animation_time = static_cast<float>(layer.time);
+	for (size_t i = 0; i < layer.node_channels.size(); ++i) {
+		int channel = layer.node_channels[i];
+		if (channel >= 0 and not (skipped_nodes and skipped_nodes[i]))
+			bones[channel].sample(
+				animation_time, layer.cursors[channel], layer.batch, i
+			);
+	}
+	layer.batch.interpolate();
+}
+
+void Animator::_update_animated_nodes() {
+	std::fill(_node_animated.begin(), _node_animated.end(), 0);
+	auto mark = [this](const Layer &layer) {
+		for (size_t i = 0; i < layer.node_channels.size(); ++i)
+			if (layer.node_channels[i] >= 0)
+				_node_animated[i] = 1;
+	};
+
+	mark(_base);
+	if (_fading)
+		mark(_fade_source);
+	for (const Layer &layer : _layers)
+		mark(layer);
 }
 
 void Animator::update_animation() {
+	update_animation(_final_bone_matrices.data());
+}
+
+void Animator::update_animation(glm::mat4 *bone_mats) {
+	if (not _animation)
+		return;
+	double delta = gu::Delta::get();
+	if (_lod_policy.enabled) {
+		_update_with_lod(bone_mats, delta);
+	} else {
+		_update(bone_mats, delta);
+		_n_bones_evaluated = _global_transforms.size();
+		_n_bones_saved = 0;
+	}
+
+	// keeps the final bone matrices in sync
+	// when they were written somewhere else (e.g. the BonePalette).
+	if (bone_mats != _final_bone_matrices.data()) {
+		std::copy(
+			bone_mats,
+			bone_mats + _final_bone_matrices.size(),
+			_final_bone_matrices.begin()
+		);
+	}
+}
+
+void Animator::sample_at(const double &seconds, glm::mat4 *bone_mats) {
 	if (not _animation)
 		return;
-	_current_time += _animation->get_ticks_per_second() * gu::Delta::get();
-	_current_time = fmod(_current_time, _animation->get_duration());
-	_calc_bone_transforms(&_animation->get_root_node(), glm::mat4(1.0f));
+	const Animation &animation = *_base.animation;
+	_base.time = fmod(
+		seconds * animation.get_ticks_per_second(), animation.get_duration()
+	);
+	_update(bone_mats, 0.0);
+}
+
+// returns the fraction of the screen's height covered by the sphere
+// at the <center> with the <radius>, or -1 if it's entirely outside the view
+// of the <projview> matrix.
+static float get_screen_size(
+	const glm::mat4 &projview,
+	const glm::mat4 &projection,
+	const glm::vec3 &center,
+	const float &radius
+) {
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; ++i)
+		rows[i] = glm::vec4(
+			projview[0][i], projview[1][i], projview[2][i], projview[3][i]
+		);
+
+	// tests the sphere against each plane of the view frustum.
+	glm::vec4 point(center, 1.0f);
+	for (int i = 0; i < 3; ++i) {
+		for (float sign : {1.0f, -1.0f}) {
+			glm::vec4 plane = rows[3] + sign * rows[i];
+			float length = glm::length(glm::vec3(plane));
+			if (glm::dot(plane, point) < -radius * length)
+				return -1.0f;
+		}
+	}
+
+	// the projected radius shrinks with the clip-space w,
+	// which is always 1 for orthographic projections.
+	float w = glm::dot(rows[3], point);
+	if (w <= radius)
+		return 1.0f;
+	return radius * projection[1][1] / w;
+}
+
+void Animator::update_lod(const Camera &camera) {
+	if (not _lod_policy.enabled)
+		return;
+
+	float screen_size = get_screen_size(
+		camera.get_projview(),
+		camera.get_projection(),
+		_bounds_center,
+		_bounds_radius
+	);
+	if (screen_size < 0.0f)
+		_lod_level = _lod_policy.freeze_off_screen ? LOD_FROZEN : LOD_LOW;
+	else if (screen_size < _lod_policy.low_screen_size)
+		_lod_level = LOD_LOW;
+	else if (screen_size < _lod_policy.reduced_screen_size)
+		_lod_level = LOD_REDUCED;
+	else
+		_lod_level = LOD_FULL;
+}
+
+void Animator::_update_with_lod(glm::mat4 *bone_mats, const double &delta) {
+	size_t n_nodes = _global_transforms.size();
+	size_t n_bones = _final_bone_matrices.size();
+	_n_bones_evaluated = 0;
+	_n_bones_saved = 0;
+
+	// a frozen Animator keeps its time and shows its last evaluation,
+	// so the time that passes while frozen is dropped
+	// and it resumes where it stopped once it's unfrozen.
+	// it's still evaluated once if it never has been.
+	if (_lod_level == LOD_FROZEN and _lod_has_evaluated) {
+		std::copy(_lod_curr_mats.begin(), _lod_curr_mats.end(), bone_mats);
+		_n_bones_saved = n_nodes;
+		return;
+	}
+	_pending_delta += delta;
+
+	uint8_t interval = 1;
+	if (_lod_level == LOD_REDUCED)
+		interval = std::max(_lod_policy.reduced_interval, uint8_t(1));
+	else if (_lod_level == LOD_LOW)
+		interval = std::max(_lod_policy.low_interval, uint8_t(1));
+
+	// evaluates the time that passed since the last evaluation.
+	if (not _lod_has_evaluated or _frames_since_evaluation + 1 >= interval) {
+		bool skip_leaves = (
+			    _lod_level == LOD_LOW
+			and _lod_policy.skip_leaf_bones
+			and _lod_has_evaluated
+		);
+		std::swap(_lod_prev_mats, _lod_curr_mats);
+		_update(_lod_curr_mats.data(), _pending_delta, skip_leaves);
+		if (not _lod_has_evaluated)
+			_lod_prev_mats = _lod_curr_mats;
+
+		_lod_has_evaluated = true;
+		_pending_delta = 0.0;
+		_frames_since_evaluation = 0;
+		_n_bones_evaluated = n_nodes - (skip_leaves ? _n_leaf_nodes : 0);
+		_n_bones_saved = n_nodes - _n_bones_evaluated;
+	} else {
+		++_frames_since_evaluation;
+		_n_bones_saved = n_nodes;
+	}
+
+	if (interval == 1) {
+		std::copy(_lod_curr_mats.begin(), _lod_curr_mats.end(), bone_mats);
+		return;
+	}
+
+	// moves from the previous evaluation to the last one
+	// over the frames until the next evaluation.
+	float t = static_cast<float>(_frames_since_evaluation + 1) / interval;
+	for (size_t i = 0; i < n_bones; ++i)
+		bone_mats[i] = _lod_prev_mats[i] + (
+			_lod_curr_mats[i] - _lod_prev_mats[i]
+		) * t;
 }
 
-// recursive method.
-void Animator::_calc_bone_transforms(
-	const Animation::AssimpNodeData *node,
-	const glm::mat4 &parent_transform
+void Animator::_update(
+	glm::mat4 *bone_mats, const double &delta, const bool &skip_leaves
 ) {
-	glm::mat4 global_tf = parent_transform;
-	glm::mat4 node_tf = node->rel_transform_mat;
-	Animation::Bone *bone = _animation->find_bone(node->name);
+	const uint8_t *skipped_nodes = skip_leaves ? _leaf_nodes.data() : nullptr;
+
+	// interpolates the local pose of the main clip.
+	_advance_layer(_base, delta);
+	_sample_layer(_base, skipped_nodes);
 
-	if (bone) {
-		bone->update_matrix(_current_time);
-		node_tf = bone->get_local_transform_mat();
+	// blends out of the previous clip.
+	if (_fading) {
+		_fade_elapsed += delta;
+		if (_fade_elapsed >= _fade_duration) {
+			_fading = false;
+			_update_animated_nodes();
+		} else {
+			_advance_layer(_fade_source, delta);
+			_sample_layer(_fade_source, skipped_nodes);
+			float progress = static_cast<float>(_fade_elapsed / _fade_duration);
+			_base.batch.blend(_fade_source.batch, 1.0f - progress);
+		}
 	}
 
-	global_tf = global_tf * node_tf;
+	// blends each layer on top.
+	size_t n_nodes = _global_transforms.size();
+	for (Layer &layer : _layers) {
+		_advance_layer(layer, delta);
+		if (layer.weight <= 0.0f)
+			continue;
 
-	auto &name_to_rig_info = _animation->get_name_to_rig_info();
-	if (name_to_rig_info.find(node->name) != name_to_rig_info.end()) {
-		const Mesh::RigInfo &rig_info = name_to_rig_info[node->name];
-		_final_bone_matrices[rig_info.bone_ID] = (
-			global_tf * rig_info.local_space_to_bone
+		_sample_layer(layer, skipped_nodes);
+		const float *node_weights = (
+			layer.mask and layer.mask->size() == n_nodes
+			? layer.mask->get_weights()
+			: nullptr
 		);
+		if (layer.blend_mode == ADDITIVE)
+			_base.batch.add(
+				layer.batch, layer.reference, layer.weight, node_weights
+			);
+		else
+			_base.batch.blend(layer.batch, layer.weight, node_weights);
 	}
 
-	for (size_t i = 0; i < node->n_children; ++i)
-		_calc_bone_transforms(&node->children[i], global_tf);
+	_base.batch.compose();
+	_calc_bone_transforms(bone_mats);
+}
+
+void Animator::_calc_bone_transforms(glm::mat4 *bone_mats) {
+	const auto &skeleton = _animation->get_skeleton();
+	const auto &local_mats = _base.batch.get_local_mats();
+
+	// every parent comes before its children,
+	// so its global transform is always already calculated.
+	for (size_t i = 0; i < skeleton.size(); ++i) {
+		const Animation::SkeletonNode &node = skeleton[i];
+		const glm::mat4 &node_tf = (
+			_node_animated[i] ? local_mats[i] : node.rel_transform_mat
+		);
+
+		_global_transforms[i] = (
+			node.parent_index < 0
+			? node_tf
+			: _global_transforms[node.parent_index] * node_tf
+		);
+
+		if (node.bone_ID >= 0) {
+			bone_mats[node.bone_ID] = (
+				_global_transforms[i] * node.local_space_to_bone
+			);
+		}
+	}
 }
 
 void Animator::_print_assimp_node_info(
@@ -1,43 +1,247 @@
 /**
  * animator.hpp
  * ---
- * this file defines the Animator class.
+ * this file defines the Animator class, which plays an Animation.
+ * everything that changes during playback is held by the Animator,
+ * so many Animators can play the same Animation on different threads.
+ *
+ * ---
+ * an Animator can cross-fade from its current Animation to another,
+ * and can play extra Animations as layers on top of it.
+ * OVERRIDE layers blend toward their clip's pose by their weight,
+ * ADDITIVE layers add their clip's motion relative to its first frame,
+ * and either can be limited to certain bones with a BoneMask.
+ * blending happens in local space before the hierarchy is walked,
+ * and every buffer is allocated when a clip or layer is set,
+ * so updating never allocates.
+ *
+ * ---
+ * an Animator can also follow an LODPolicy, which picks an LOD_LEVEL
+ * from how large its bounding sphere appears to a Camera.
+ * farther Animators are evaluated every Nth frame
+ * (with the bone matrices interpolated in between, one interval behind),
+ * the farthest ones also stop sampling their leaf bones,
+ * and Animators outside of the Camera's view are frozen.
+ * every update counts how many bone evaluations were made and saved,
+ * with each node of the skeleton counting as one bone.
  *
  */
 
 #pragma once
 #include "animation.hpp"
 #include "bone.hpp"
+#include "bone_mask.hpp"
+#include "pose_batch.hpp"
+#include "../../environment/camera.hpp"
 
 namespace gu {
 class Animator {
+public:
+	enum BLEND_MODE : uint8_t {
+		OVERRIDE,
+		ADDITIVE,
+	};
+
+	enum LOD_LEVEL : uint8_t {
+		LOD_FULL, // evaluated every frame
+		LOD_REDUCED, // evaluated every <reduced_interval> frames
+		LOD_LOW, // evaluated every <low_interval> frames without leaf bones
+		LOD_FROZEN, // not evaluated
+	};
+
+	// describes when an Animator lowers its LOD_LEVEL.
+	// screen sizes are the fraction of the screen's height
+	// covered by the Animator's bounding sphere.
+	struct LODPolicy {
+		bool enabled = false;
+		float reduced_screen_size = 0.25f; // LOD_REDUCED below this
+		float low_screen_size = 0.08f; // LOD_LOW below this
+		uint8_t reduced_interval = 2;
+		uint8_t low_interval = 4;
+		bool skip_leaf_bones = true; // stops sampling leaf bones at LOD_LOW
+		bool freeze_off_screen = true; // LOD_FROZEN outside of the view
+	};
+
 private:
+	// an Animation being played on the skeleton.
+	struct Layer {
+		Animation *animation = nullptr;
+		double time = 0.0;
+		float weight = 1.0f;
+		BLEND_MODE blend_mode = OVERRIDE;
+		const BoneMask *mask = nullptr;
+		std::vector<int> node_channels; // per skeleton node, -1 if not animated
+		std::vector<Animation::Bone::Cursor> cursors; // per Animation::Bone
+		PoseBatch batch; // the sampled pose
+		PoseBatch reference; // the pose at time 0 used by ADDITIVE layers
+	};
+
 	std::vector<glm::mat4> _final_bone_matrices;
-	Animation *_animation;
-	double _current_time;
+	std::vector<glm::mat4> _global_transforms; // per Animation::SkeletonNode
+	std::vector<uint8_t> _node_animated; // per node, 1 if any clip moves it
+	Animation *_animation = nullptr; // provides the skeleton
+	Layer _base; // the main clip, which every other Layer is blended onto
+	Layer _fade_source; // the clip being faded out of
+	bool _fading = false;
+	double _fade_elapsed = 0.0;
+	double _fade_duration = 0.0;
+	std::vector<Layer> _layers;
+	size_t _palette_offset = 0; // set by an AnimationSystem
+
+	LODPolicy _lod_policy;
+	LOD_LEVEL _lod_level = LOD_FULL;
+	glm::vec3 _bounds_center = glm::vec3(0.0f); // world space
+	float _bounds_radius = 1.0f;
+	std::vector<uint8_t> _leaf_nodes; // per node, 1 if it has no children
+	size_t _n_leaf_nodes = 0;
+	std::vector<glm::mat4> _lod_prev_mats; // the evaluation before the last
+	std::vector<glm::mat4> _lod_curr_mats; // the last evaluation
+	bool _lod_has_evaluated = false;
+	uint8_t _frames_since_evaluation = 0;
+	double _pending_delta = 0.0; // seconds not yet evaluated
+	size_t _n_bones_evaluated = 0; // during the last update
+	size_t _n_bones_saved = 0; // during the last update
 
 public:
 	Animator();
 	Animator(Animation &animation);
 
 private:
+	// sizes the final bone matrices to the number of bones
+	// used by the rig of the current Animation.
 	void _setup_bone_matrices();
 
 public:
+	// returns the final bone matrices of the last update,
+	// including those written to the BonePalette by an AnimationSystem.
 	inline const std::vector<glm::mat4> &get_final_bone_matrices() const {
 		return _final_bone_matrices;
 	}
+
+	// returns the number of final bone matrices.
+	inline size_t get_n_bones() const { return _final_bone_matrices.size(); }
+
+	// returns the offset of this Animator's matrices in the BonePalette
+	// that were written by the last AnimationSystem update.
+	inline const size_t &get_palette_offset() const { return _palette_offset; }
+	inline void set_palette_offset(const size_t &offset) {
+		_palette_offset = offset;
+	}
+
+	inline bool has_animation() const { return _animation != nullptr; }
+
+	// immediately switches to the <animation>, starting it from the beginning.
+	// its skeleton is used for every clip played afterwards.
 	void set_animation(Animation &animation);
+
+	// fades from the current clip to the <animation> over the <duration>
+	// (seconds), starting it from the beginning.
+	// the <animation> must be for the same rig as the current one.
+	void cross_fade(Animation &animation, const double &duration);
+
+	inline bool is_fading() const { return _fading; }
+
+	// plays the <animation> on top of the current clip
+	// and returns the index of the new layer.
+	// a <mask> limits the layer to the bones it weighs,
+	// and must be made from the Animation given to set_animation(...).
+	// returns get_n_layers() if there's no current clip.
+	size_t add_layer(
+		Animation &animation,
+		const BLEND_MODE &blend_mode,
+		const float &weight = 1.0f,
+		const BoneMask *mask = nullptr
+	);
+
+	inline size_t get_n_layers() const { return _layers.size(); }
+	inline const float &get_layer_weight(const size_t &index) const {
+		return _layers[index].weight;
+	}
+	inline void set_layer_weight(const size_t &index, const float &weight) {
+		_layers[index].weight = weight;
+	}
+	inline void set_layer_mask(const size_t &index, const BoneMask *mask) {
+		_layers[index].mask = mask;
+	}
+
+	// removes every layer.
+	void clear_layers();
+
+	// advances the time of the Animation and calculates the
+	// final bone matrices.
 	void update_animation();
 
+	// advances the time of the Animation and writes the final bone matrices
+	// to the given <bone_mats>, which must hold get_n_bones() matrices.
+	// they're also copied to the Animator's own final bone matrices.
+	// this is safe to run on a ThreadPool thread.
+	void update_animation(glm::mat4 *bone_mats);
+
+	// sets the time of the current clip to the given <seconds>
+	// and writes the final bone matrices of that moment to the <bone_mats>
+	// without advancing any fade or layer.
+	void sample_at(const double &seconds, glm::mat4 *bone_mats);
+
+	inline const LODPolicy &get_lod_policy() const { return _lod_policy; }
+	inline void set_lod_policy(const LODPolicy &policy) {
+		_lod_policy = policy;
+		_lod_has_evaluated = false;
+	}
+
+	// sets the world-space bounding sphere used to pick the LOD_LEVEL.
+	inline void set_bounds(const glm::vec3 &center, const float &radius) {
+		_bounds_center = center;
+		_bounds_radius = radius;
+	}
+
+	inline const LOD_LEVEL &get_lod_level() const { return _lod_level; }
+
+	// picks the LOD_LEVEL from how the bounding sphere appears
+	// to the <camera>. this does nothing if the LODPolicy isn't enabled.
+	void update_lod(const Camera &camera);
+
+	// returns the number of bones that were evaluated
+	// and the number that were skipped by the LOD_LEVEL
+	// during the last update.
+	inline const size_t &get_n_bones_evaluated() const {
+		return _n_bones_evaluated;
+	}
+	inline const size_t &get_n_bones_saved() const { return _n_bones_saved; }
+
 private:
-	// calculates the final bone matrices
-	// for every bone in the rigging hierarchy by recursion.
-	void _calc_bone_transforms(
-		const Animation::AssimpNodeData *node,
-		const glm::mat4 &parent_transform
+	// updates the animation by the LOD_LEVEL, evaluating it
+	// only on the frames the LOD_LEVEL allows
+	// and writing the final bone matrices to the given <bone_mats>.
+	void _update_with_lod(glm::mat4 *bone_mats, const double &delta);
+
+	// advances everything being played by <delta> seconds
+	// and writes the final bone matrices to the given <bone_mats>.
+	// if <skip_leaves> is true, leaf bones keep their last sampled keyframes.
+	void _update(
+		glm::mat4 *bone_mats, const double &delta, const bool &skip_leaves = false
+	);
+
+	// sets the <layer> to play the <animation> from the beginning
+	// on the skeleton of the current Animation.
+	void _setup_layer(Layer &layer, Animation &animation);
+
+	// advances the time of the <layer> by <delta> seconds.
+	static void _advance_layer(Layer &layer, const double &delta);
+
+	// samples and interpolates the <layer>'s pose at its time.
+	// the nodes marked in <skipped_nodes> aren't sampled if it's given.
+	static void _sample_layer(
+		Layer &layer, const uint8_t *skipped_nodes = nullptr
 	);
 
+	// marks which nodes are moved by any of the played clips.
+	void _update_animated_nodes();
+
+	// calculates the final bone matrices into the given <bone_mats>
+	// for every bone in the rigging hierarchy
+	// by walking the Animation's flattened skeleton in order.
+	void _calc_bone_transforms(glm::mat4 *bone_mats);
+
 
 public:
 	inline void print_rig_hierarchy() {
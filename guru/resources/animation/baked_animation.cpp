@@ -0,0 +1,92 @@
+#include "baked_animation.hpp"
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "animator.hpp"
+#include "../../system/gl_state.hpp"
+
+namespace gu {
+namespace res {
+BakedAnimation::BakedAnimation(
+	Animation &animation, const float &frames_per_second
+) {
+	if (frames_per_second <= 0.0f) {
+		std::cerr << "a BakedAnimation needs a positive frame rate."
+			<< std::endl;
+		return;
+	}
+	Animator animator(animation);
+	_n_bones = animator.get_n_bones();
+	if (_n_bones == 0)
+		return;
+
+	// the last frame is left out since it's the same as the first
+	// when the clip loops. the frames are spread evenly over the clip,
+	// so the shader's loop of <_n_frames> frames lasts as long as the clip.
+	double seconds = animation.get_duration() / animation.get_ticks_per_second();
+	_n_frames = static_cast<size_t>(std::ceil(seconds * frames_per_second));
+	if (_n_frames == 0)
+		_n_frames = 1;
+	_frames_per_second = (
+		seconds > 0.0 ? static_cast<float>(_n_frames / seconds) : frames_per_second
+	);
+
+	// rejects the bake before sampling if it won't fit in a texture.
+	size_t width = _n_bones * 3;
+	GLint max_size = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+	if (width > size_t(max_size) or _n_frames > size_t(max_size)) {
+		std::cerr << "the baked animation of " << _n_bones << " bones and "
+			<< _n_frames << " frames is too large for a texture." << std::endl;
+		_n_bones = 0;
+		_n_frames = 0;
+		return;
+	}
+
+	// samples each frame and keeps the first three rows of each matrix.
+	std::vector<glm::mat4> bone_mats(_n_bones);
+	std::vector<float> texels(width * _n_frames * 4);
+	float *texel = texels.data();
+	for (size_t frame = 0; frame < _n_frames; ++frame) {
+		animator.sample_at(frame / _frames_per_second, bone_mats.data());
+		for (const glm::mat4 &mat : bone_mats) {
+			for (int row = 0; row < 3; ++row) {
+				for (int col = 0; col < 4; ++col)
+					*texel++ = mat[col][row];
+			}
+		}
+	}
+
+	glGenTextures(1, &_texture_ID);
+	GLState::bind_texture(TEXTURE_UNIT, GL_TEXTURE_2D, _texture_ID);
+	glTexImage2D(
+		GL_TEXTURE_2D,
+		0,
+		GL_RGBA32F,
+		static_cast<GLsizei>(width),
+		static_cast<GLsizei>(_n_frames),
+		0,
+		GL_RGBA,
+		GL_FLOAT,
+		texels.data()
+	);
+
+	// the shader reads exact texels and blends the frames itself.
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+BakedAnimation::~BakedAnimation() {
+	if (_texture_ID != 0) {
+		glDeleteTextures(1, &_texture_ID);
+		GLState::forget_texture(_texture_ID);
+	}
+}
+
+void BakedAnimation::bind() const {
+	GLState::bind_texture(TEXTURE_UNIT, GL_TEXTURE_2D, _texture_ID);
+}
+} // namespace res
+} // namespace gu
\ No newline at end of file
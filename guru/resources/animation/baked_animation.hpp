@@ -0,0 +1,65 @@
+/**
+ * baked_animation.hpp
+ * ---
+ * this file defines the BakedAnimation class, which samples an Animation
+ * at a fixed rate ahead of time and stores every frame's final bone matrices
+ * in a texture, so that a crowd of instances can be skinned on the videocard
+ * without an Animator or a BonePalette range per instance.
+ *
+ * ---
+ * the texture is GL_RGBA32F, with one row per frame
+ * and three texels per bone holding the first three rows
+ * of the bone's matrix (the last row is always 0, 0, 0, 1).
+ * each instance is given its own time through
+ * ModelResource::draw_meshes_instanced(<model_mats>, <anim_times>, ...),
+ * and "baked_anim_light_shader.v_shader" blends the two frames around it.
+ * the clip is played as is, with no cross-fades or layers.
+ * the frame rate is adjusted so that a whole number of frames
+ * spans the clip, which keeps the loop from drifting.
+ * if the frames don't fit in a texture, nothing is baked
+ * and the instances are drawn in their bind pose.
+ *
+ */
+
+#pragma once
+#include <glad/gl.h>
+#include "animation.hpp"
+
+namespace gu {
+namespace res {
+class BakedAnimation {
+public:
+	// the texture unit the baked frames are bound to,
+	// which follows the BonePalette's.
+	static constexpr GLuint TEXTURE_UNIT = 9;
+
+private:
+	GLuint _texture_ID = 0;
+	size_t _n_bones = 0;
+	size_t _n_frames = 0;
+	float _frames_per_second = 0.0f;
+
+public:
+	// bakes every frame of the <animation>
+	// sampled about <frames_per_second> times per second of playback.
+	BakedAnimation(Animation &animation, const float &frames_per_second = 30.0f);
+
+	// dtor. deletes the texture.
+	~BakedAnimation();
+
+	BakedAnimation(const BakedAnimation &) = delete;
+	BakedAnimation &operator=(const BakedAnimation &) = delete;
+
+	// returns true if the frames were baked into the texture.
+	inline bool is_baked() const { return _texture_ID != 0; }
+
+	inline GLuint get_texture_ID() const { return _texture_ID; }
+	inline size_t get_n_bones() const { return _n_bones; }
+	inline size_t get_n_frames() const { return _n_frames; }
+	inline float get_frames_per_second() const { return _frames_per_second; }
+
+	// binds the texture to the TEXTURE_UNIT.
+	void bind() const;
+};
+} // namespace res
+} // namespace gu
\ No newline at end of file
@@ -5,143 +5,309 @@
 #include <assimp/postprocess.h>
 #include "../model/assimp_to_glm.hpp"
 
-namespace gu {
-Animation::Bone::Bone(
-	const std::string &name, int bone_ID, const aiNodeAnim *channel
-) : _name(name),
-    _bone_ID(bone_ID),
-    _transform_mat(1.0f)
-{
-	// loads a Bone's PositionKeyframes from the given <*channel>.
-	_n_position_keyframes = channel->mNumPositionKeys;
-	for (size_t i = 0; i < _n_position_keyframes; ++i) {
-		PositionKeyframe position_keyframe;
-		const aiVector3D &ai_position = channel->mPositionKeys[i].mValue;
-		set_vec3(position_keyframe.position, ai_position);
-		position_keyframe.time_stamp = channel->mPositionKeys[i].mTime;
-		_position_keyframes.push_back(position_keyframe);
+// the size of an Assimp vector or quaternion key,
+// which is a double time stamp followed by the value.
+static const size_t SOURCE_KEY_BYTES = 24;
+
+// returns the value of the track with the given <time_stamps>
+// at the 16-bit <key_time> by interpolating the values
+// that <get_value(index)> returns with <mix(a, b, factor)>.
+template <typename T, typename GetValue, typename Mix>
+static T sample_track(
+	const std::vector<uint16_t> &time_stamps,
+	const float &key_time,
+	GetValue get_value,
+	Mix mix
+) {
+	if (time_stamps.size() == 1 or key_time <= time_stamps.front())
+		return get_value(0);
+	for (size_t i = 1; i < time_stamps.size(); ++i) {
+		if (key_time <= time_stamps[i]) {
+			float duration = static_cast<float>(
+				time_stamps[i] - time_stamps[i - 1]
+			);
+			float factor = (
+				duration > 0.0f ? (key_time - time_stamps[i - 1]) / duration : 1.0f
+			);
+			return mix(get_value(i - 1), get_value(i), factor);
+		}
 	}
+	return get_value(time_stamps.size() - 1);
+}
+
+// loads the <n_keys> Assimp <keys> into the <keyframes>,
+// removing the keys that can be interpolated within the <tolerance>
+// and setting <max_error> to the largest error that the removal
+// and quantization cause.
+static void load_vec3_keys(
+	const aiVectorKey *keys,
+	const size_t &n_keys,
+	const double &duration,
+	const float &tolerance,
+	Vec3Keyframes &keyframes,
+	float &max_error,
+	gu::ClipCompression::Stats &stats
+) {
+	std::vector<glm::vec3> values(n_keys);
+	for (size_t i = 0; i < n_keys; ++i)
+		set_vec3(values[i], keys[i].mValue);
 
-	// loads a Bone's OrientationKeyframes from the given <*channel>.
-	_n_orientation_keyframes = channel->mNumRotationKeys;
-	for (size_t i = 0; i < _n_orientation_keyframes; ++i) {
-		OrientationKeyframe orientation_keyframe;
-		const aiQuaternion &ai_quat = channel->mRotationKeys[i].mValue;
-		set_quat(orientation_keyframe.orientation, ai_quat);
-		orientation_keyframe.time_stamp = channel->mRotationKeys[i].mTime;
-		_orientation_keyframes.push_back(orientation_keyframe);
+	auto get_error = [&](size_t first, size_t last, size_t index) {
+		double span = keys[last].mTime - keys[first].mTime;
+		float factor = static_cast<float>(
+			span > 0.0 ? (keys[index].mTime - keys[first].mTime) / span : 0.0
+		);
+		glm::vec3 interpolated = glm::mix(values[first], values[last], factor);
+		return glm::length(interpolated - values[index]);
+	};
+	std::vector<size_t> kept = gu::ClipCompression::reduce_keys(
+		n_keys, tolerance, get_error
+	);
+
+	for (const size_t &i : kept) {
+		keyframes.time_stamps.push_back(
+			gu::ClipCompression::pack_time_stamp(keys[i].mTime, duration)
+		);
+		keyframes.x.push_back(values[i].x);
+		keyframes.y.push_back(values[i].y);
+		keyframes.z.push_back(values[i].z);
 	}
 
-	// loads a Bone's ScalingKeyframes from the given <*channel>.
-	_n_scaling_keyframes = channel->mNumScalingKeys;
-	for (size_t i = 0; i < _n_scaling_keyframes; ++i) {
-		ScalingKeyframe scaling_keyframe;
-		const aiVector3D &ai_scaling = channel->mScalingKeys[i].mValue;
-		set_vec3(scaling_keyframe.scaling, ai_scaling);
-		scaling_keyframe.time_stamp = channel->mScalingKeys[i].mTime;
-		_scaling_keyframes.push_back(scaling_keyframe);
+	// measures the error of the compressed track at every source key.
+	for (size_t i = 0; i < n_keys; ++i) {
+		float key_time = static_cast<float>(
+			duration > 0.0
+			? keys[i].mTime / duration * gu::ClipCompression::MAX_TIME_STAMP
+			: 0.0
+		);
+		glm::vec3 value = sample_track<glm::vec3>(
+			keyframes.time_stamps,
+			key_time,
+			[&](size_t k) {
+				return glm::vec3(keyframes.x[k], keyframes.y[k], keyframes.z[k]);
+			},
+			[](const glm::vec3 &a, const glm::vec3 &b, float t) {
+				return glm::mix(a, b, t);
+			}
+		);
+		max_error = std::max(max_error, glm::length(value - values[i]));
 	}
-}
 
-void Animation::Bone::update_matrix(const double &animation_time) {
-	glm::vec3 position = _interpolated_position(animation_time);
-	glm::quat orientation = _interpolated_orientation(animation_time);
-	glm::vec3 scaling = _interpolated_scaling(animation_time);
-
-	_transform_mat = glm::mat4(1.0f);
-	_transform_mat = glm::translate(_transform_mat, position);
-	_transform_mat = _transform_mat * glm::toMat4(orientation);
-	_transform_mat = glm::scale(_transform_mat, scaling);
-
-	/*
-	OPTIMIZATION:
-	for (uint8_t i = 0; i < 3; ++i)
-		_transform_mat[3][i] = position[i];
-
-	glm::mat4 rot_mat = glm::toMat4(orientation);
-	for (uint8_t i = 0; i < 3; ++i)
-		for (uint8_t j = 0; j < 3; ++j)
-			_transform_mat[i][j] = rot_mat[i][j];
-
-	for (uint8_t i = 0; i < 3; ++i)
-		for (uint8_t j = 0; j < 3; ++j)
-			_transform_mat[i][j] = _transform_mat[i][j] * scaling[j];
-	*/
+	stats.n_source_keys += n_keys;
+	stats.n_kept_keys += kept.size();
+	stats.source_bytes += n_keys * SOURCE_KEY_BYTES;
+	stats.compressed_bytes += kept.size() * (sizeof(uint16_t) + 3 * sizeof(float));
 }
 
-static double calc_progress_factor(
-	const double &prev_time_stamp,
-	const double &next_time_stamp,
-	const double &animation_time
+// loads the <n_keys> Assimp <keys> into the <keyframes>,
+// removing the keys that can be interpolated within the <tolerance>
+// and setting <max_error> to the largest error (radians) that the removal
+// and quantization cause.
+static void load_orientation_keys(
+	const aiQuatKey *keys,
+	const size_t &n_keys,
+	const double &duration,
+	const float &tolerance,
+	QuatKeyframes &keyframes,
+	float &max_error,
+	gu::ClipCompression::Stats &stats
 ) {
-	double progression = animation_time - prev_time_stamp;
-	double duration = next_time_stamp - prev_time_stamp;
-	return progression / duration;
-}
+	auto nlerp = [](const glm::quat &a, const glm::quat &b, float t) {
+		glm::quat to = glm::dot(a, b) < 0.0f ? -b : b;
+		return glm::normalize(a * (1.0f - t) + to * t);
+	};
 
-glm::vec3 Animation::Bone::_interpolated_position(const double &animation_time) {
-	if (_n_position_keyframes == 1)
-		return _position_keyframes[0].position;
+	std::vector<glm::quat> values(n_keys);
+	for (size_t i = 0; i < n_keys; ++i)
+		set_quat(values[i], keys[i].mValue);
 
-	size_t k0_index = find_keyframe_index(
-		_position_keyframes, _n_position_keyframes, animation_time
-	);
-	size_t k1_index = k0_index + 1;
-	double progress_factor = calc_progress_factor(
-		_position_keyframes[k0_index].time_stamp,
-		_position_keyframes[k1_index].time_stamp,
-		animation_time
+	auto get_error = [&](size_t first, size_t last, size_t index) {
+		double span = keys[last].mTime - keys[first].mTime;
+		float factor = static_cast<float>(
+			span > 0.0 ? (keys[index].mTime - keys[first].mTime) / span : 0.0
+		);
+		glm::quat interpolated = nlerp(values[first], values[last], factor);
+		return gu::ClipCompression::get_angle_between(
+			interpolated, values[index]
+		);
+	};
+	std::vector<size_t> kept = gu::ClipCompression::reduce_keys(
+		n_keys, tolerance, get_error
 	);
 
-	glm::vec3 interpolated_position = glm::mix(
-		_position_keyframes[k0_index].position,
-		_position_keyframes[k1_index].position,
-		progress_factor
-	);
-	return interpolated_position;
-}
+	for (const size_t &i : kept) {
+		keyframes.time_stamps.push_back(
+			gu::ClipCompression::pack_time_stamp(keys[i].mTime, duration)
+		);
+		keyframes.packed.resize(keyframes.packed.size() + 3);
+		gu::ClipCompression::pack_orientation(
+			values[i], &keyframes.packed[keyframes.packed.size() - 3]
+		);
+	}
 
-glm::quat Animation::Bone::_interpolated_orientation(const double &animation_time) {
-	if (_n_orientation_keyframes == 1)
-		return glm::normalize(_orientation_keyframes[0].orientation);
+	// measures the error of the compressed track at every source key.
+	for (size_t i = 0; i < n_keys; ++i) {
+		float key_time = static_cast<float>(
+			duration > 0.0
+			? keys[i].mTime / duration * gu::ClipCompression::MAX_TIME_STAMP
+			: 0.0
+		);
+		glm::quat value = sample_track<glm::quat>(
+			keyframes.time_stamps,
+			key_time,
+			[&](size_t k) {
+				return gu::ClipCompression::unpack_orientation(
+					&keyframes.packed[k * 3]
+				);
+			},
+			nlerp
+		);
+		max_error = std::max(
+			max_error,
+			gu::ClipCompression::get_angle_between(value, values[i])
+		);
+	}
 
-	size_t k0_index = find_keyframe_index(
-		_orientation_keyframes, _n_orientation_keyframes, animation_time
+	stats.n_source_keys += n_keys;
+	stats.n_kept_keys += kept.size();
+	stats.source_bytes += n_keys * SOURCE_KEY_BYTES;
+	stats.compressed_bytes += kept.size() * 4 * sizeof(uint16_t);
+}
+
+namespace gu {
+Animation::Bone::Bone(
+	const std::string &name,
+	int bone_ID,
+	const aiNodeAnim *channel,
+	const double &duration,
+	const ClipCompression::Tolerances &tolerances,
+	ClipCompression::Stats &stats
+) : _name(name),
+    _bone_ID(bone_ID),
+    _time_scale(
+		duration > 0.0
+		? static_cast<float>(ClipCompression::MAX_TIME_STAMP / duration)
+		: 0.0f
+	)
+{
+	load_vec3_keys(
+		channel->mPositionKeys,
+		channel->mNumPositionKeys,
+		duration,
+		tolerances.position,
+		_position_keyframes,
+		stats.max_position_error,
+		stats
 	);
-	size_t k1_index = k0_index + 1;
-	double progress_factor = calc_progress_factor(
-		_orientation_keyframes[k0_index].time_stamp,
-		_orientation_keyframes[k1_index].time_stamp,
-		animation_time
+	load_orientation_keys(
+		channel->mRotationKeys,
+		channel->mNumRotationKeys,
+		duration,
+		tolerances.orientation,
+		_orientation_keyframes,
+		stats.max_orientation_error,
+		stats
 	);
-
-	glm::quat interpolated_orientation = glm::slerp(
-		_orientation_keyframes[k0_index].orientation,
-		_orientation_keyframes[k1_index].orientation,
-		static_cast<float>(progress_factor)
+	load_vec3_keys(
+		channel->mScalingKeys,
+		channel->mNumScalingKeys,
+		duration,
+		tolerances.scaling,
+		_scaling_keyframes,
+		stats.max_scaling_error,
+		stats
 	);
-	return glm::normalize(interpolated_orientation);
 }
 
-glm::vec3 Animation::Bone::_interpolated_scaling(const double &animation_time) {
-	if (_n_scaling_keyframes == 1)
-		return _scaling_keyframes[0].scaling;
+void Animation::Bone::find_span(
+	const std::vector<uint16_t> &time_stamps,
+	const float &key_time,
+	size_t &cursor,
+	size_t &k0_index,
+	size_t &k1_index,
+	float &progress_factor
+) {
+	if (time_stamps.size() < 2) {
+		k0_index = 0;
+		k1_index = 0;
+		progress_factor = 0.0f;
+		return;
+	}
 
-	size_t k0_index = find_keyframe_index(
-		_scaling_keyframes, _n_scaling_keyframes, animation_time
+	k0_index = find_keyframe_index(time_stamps, key_time, cursor);
+	k1_index = k0_index + 1;
+	float progression = key_time - time_stamps[k0_index];
+	float duration = static_cast<float>(
+		time_stamps[k1_index] - time_stamps[k0_index]
 	);
-	size_t k1_index = k0_index + 1;
-	double progress_factor = calc_progress_factor(
-		_scaling_keyframes[k0_index].time_stamp,
-		_scaling_keyframes[k1_index].time_stamp,
-		animation_time
+	progress_factor = (
+		duration > 0.0f ? std::clamp(progression / duration, 0.0f, 1.0f) : 0.0f
 	);
+}
 
-	glm::vec3 interpolated_scaling = glm::mix(
-		_scaling_keyframes[k0_index].scaling,
-		_scaling_keyframes[k1_index].scaling,
-		progress_factor
-	);
-	return interpolated_scaling;
+void Animation::Bone::sample(
+	const float &animation_time,
+	Cursor &cursor,
+	PoseBatch &batch,
+	const size_t &lane
+) const {
+	float key_time = animation_time * _time_scale;
+	size_t k0, k1;
+	float factor;
+
+	const Vec3Keyframes &positions = _position_keyframes;
+	if (not positions.time_stamps.empty()) {
+		find_span(
+			positions.time_stamps, key_time, cursor.position, k0, k1, factor
+		);
+		batch.get_lane(PoseBatch::POS_0_X)[lane] = positions.x[k0];
+		batch.get_lane(PoseBatch::POS_0_Y)[lane] = positions.y[k0];
+		batch.get_lane(PoseBatch::POS_0_Z)[lane] = positions.z[k0];
+		batch.get_lane(PoseBatch::POS_1_X)[lane] = positions.x[k1];
+		batch.get_lane(PoseBatch::POS_1_Y)[lane] = positions.y[k1];
+		batch.get_lane(PoseBatch::POS_1_Z)[lane] = positions.z[k1];
+		batch.get_lane(PoseBatch::POS_FACTOR)[lane] = factor;
+	}
+
+	const QuatKeyframes &orientations = _orientation_keyframes;
+	if (not orientations.time_stamps.empty()) {
+		find_span(
+			orientations.time_stamps,
+			key_time,
+			cursor.orientation,
+			k0,
+			k1,
+			factor
+		);
+		glm::quat q0 = ClipCompression::unpack_orientation(
+			&orientations.packed[k0 * 3]
+		);
+		glm::quat q1 = ClipCompression::unpack_orientation(
+			&orientations.packed[k1 * 3]
+		);
+		batch.get_lane(PoseBatch::ROT_0_X)[lane] = q0.x;
+		batch.get_lane(PoseBatch::ROT_0_Y)[lane] = q0.y;
+		batch.get_lane(PoseBatch::ROT_0_Z)[lane] = q0.z;
+		batch.get_lane(PoseBatch::ROT_0_W)[lane] = q0.w;
+		batch.get_lane(PoseBatch::ROT_1_X)[lane] = q1.x;
+		batch.get_lane(PoseBatch::ROT_1_Y)[lane] = q1.y;
+		batch.get_lane(PoseBatch::ROT_1_Z)[lane] = q1.z;
+		batch.get_lane(PoseBatch::ROT_1_W)[lane] = q1.w;
+		batch.get_lane(PoseBatch::ROT_FACTOR)[lane] = factor;
+	}
+
+	const Vec3Keyframes &scalings = _scaling_keyframes;
+	if (not scalings.time_stamps.empty()) {
+		find_span(
+			scalings.time_stamps, key_time, cursor.scaling, k0, k1, factor
+		);
+		batch.get_lane(PoseBatch::SCL_0_X)[lane] = scalings.x[k0];
+		batch.get_lane(PoseBatch::SCL_0_Y)[lane] = scalings.y[k0];
+		batch.get_lane(PoseBatch::SCL_0_Z)[lane] = scalings.z[k0];
+		batch.get_lane(PoseBatch::SCL_1_X)[lane] = scalings.x[k1];
+		batch.get_lane(PoseBatch::SCL_1_Y)[lane] = scalings.y[k1];
+		batch.get_lane(PoseBatch::SCL_1_Z)[lane] = scalings.z[k1];
+		batch.get_lane(PoseBatch::SCL_FACTOR)[lane] = factor;
+	}
 }
 } // namespace gu
\ No newline at end of file
@@ -2,26 +2,35 @@
  * bone.hpp
  * ---
  * this file defines the Bone class that's within the Animation class.
+ * a Bone's keyframes are stored as structure-of-arrays:
+ * the time stamps of each channel are one contiguous array
+ * and each component of the values is its own array.
+ * a Bone is never modified once it's loaded, so one Animation
+ * can be played by many Animators at the same time.
+ *
+ * ---
+ * the keyframes are compressed by ClipCompression when they're loaded.
+ * time stamps are 16-bit fractions of the Animation's duration
+ * and orientations are 48-bit smallest-three quaternions,
+ * which are decoded as they're sampled.
  *
  */
 
 #pragma once
+#include <algorithm>
 #include "animation.hpp"
+#include "clip_compression.hpp"
+#include "pose_batch.hpp"
 
 namespace {
-struct PositionKeyframe {
-	glm::vec3 position = glm::vec3(0.0f);
-	double time_stamp = 0.0;
+struct Vec3Keyframes {
+	std::vector<uint16_t> time_stamps;
+	std::vector<float> x, y, z;
 };
 
-struct OrientationKeyframe {
-	glm::quat orientation = glm::quat();
-	double time_stamp = 0.0;
-};
-
-struct ScalingKeyframe {
-	glm::vec3 scaling = glm::vec3(1.0f);
-	double time_stamp = 0.0;
+struct QuatKeyframes {
+	std::vector<uint16_t> time_stamps;
+	std::vector<uint16_t> packed; // three values per keyframe
 };
 } // blank namespace
 
@@ -30,40 +39,83 @@ class Animation::Bone {
 private:
 	int _bone_ID;
 	std::string _name;
-	std::vector<PositionKeyframe> _position_keyframes;
-	std::vector<OrientationKeyframe> _orientation_keyframes;
-	std::vector<ScalingKeyframe> _scaling_keyframes;
-	size_t _n_position_keyframes = 0;
-	size_t _n_orientation_keyframes = 0;
-	size_t _n_scaling_keyframes = 0;
-	glm::mat4 _transform_mat;
+	float _time_scale; // converts animation time to the 16-bit time stamps
+	Vec3Keyframes _position_keyframes;
+	QuatKeyframes _orientation_keyframes;
+	Vec3Keyframes _scaling_keyframes;
 
 public:
-	Bone(const std::string & name, int bone_ID, const aiNodeAnim * channel);
+	// the index of the keyframe found by the last sample for each channel.
+	// while the animation time moves forward, the next search
+	// starts here instead of at the first keyframe.
+	// every Animator keeps its own Cursor for each Bone.
+	struct Cursor {
+		size_t position = 0;
+		size_t orientation = 0;
+		size_t scaling = 0;
+	};
+
+	// ctor. loads and compresses the keyframes of the <channel>
+	// of an Animation that lasts the <duration>,
+	// adding the sizes and errors to the <stats>.
+	Bone(
+		const std::string &name,
+		int bone_ID,
+		const aiNodeAnim *channel,
+		const double &duration,
+		const ClipCompression::Tolerances &tolerances,
+		ClipCompression::Stats &stats
+	);
 	inline const int &get_bone_ID() const { return _bone_ID; }
 	inline const std::string &get_name() const { return _name; }
-	inline const glm::mat4 &get_local_transform_mat() const {
-		return _transform_mat;
-	}
-	void update_matrix(const double &animation_time);
 
-private:
-	template <typename T>
-	size_t find_keyframe_index(
-		const std::vector<T> &keyframes,
-		const size_t & n_keyframes,
-		const double &animation_time
+	// writes the keyframes surrounding the <animation_time>
+	// and the progress between them into the <lane> of the <batch>,
+	// which then interpolates every Bone at once.
+	// the <cursor> is moved to the sampled keyframes.
+	void sample(
+		const float &animation_time,
+		Cursor &cursor,
+		PoseBatch &batch,
+		const size_t &lane
+	) const;
+
+	// returns the index of the keyframe that begins the span
+	// containing the <key_time>, which is stored in the <cursor>.
+	// the span at the <cursor> and the one after it are checked first,
+	// so playing forward costs O(1). seeking or looping falls back
+	// to a binary search.
+	static size_t find_keyframe_index(
+		const std::vector<uint16_t> &time_stamps,
+		const float &key_time,
+		size_t &cursor
 	) {
-		for (size_t i = 0; i < n_keyframes - 1; ++i) {
-			if (animation_time < keyframes[i + 1].time_stamp)
-				return i;
+		const size_t last_span = time_stamps.size() - 2;
+		if (cursor <= last_span and time_stamps[cursor] <= key_time) {
+			if (key_time < time_stamps[cursor + 1])
+				return cursor;
+			if (cursor < last_span and key_time < time_stamps[cursor + 2])
+				return ++cursor;
 		}
-		assert(0);
-		return 0;
+
+		auto next = std::upper_bound(
+			time_stamps.begin(), time_stamps.end(), key_time
+		);
+		size_t index = static_cast<size_t>(next - time_stamps.begin());
+		cursor = std::min(index > 0 ? index - 1 : 0, last_span);
+		return cursor;
 	}
 
-	glm::vec3 _interpolated_position(const double &animation_time);
-	glm::quat _interpolated_orientation(const double &animation_time);
-	glm::vec3 _interpolated_scaling(const double &animation_time);
+private:
+	// finds the span of the <time_stamps> containing the <key_time>
+	// and sets the indices of its keyframes and the progress between them.
+	static void find_span(
+		const std::vector<uint16_t> &time_stamps,
+		const float &key_time,
+		size_t &cursor,
+		size_t &k0_index,
+		size_t &k1_index,
+		float &progress_factor
+	);
 };
 } // namespace gu
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "bone_mask.hpp"
+
+namespace gu {
+BoneMask::BoneMask(
+	const Animation &animation, const float &weight
+) : _animation(&animation),
+    _weights(animation.get_skeleton().size(), weight)
+{}
+
+bool BoneMask::set_weight(
+	const std::string &name,
+	const float &weight,
+	const bool &include_descendants
+) {
+	int index = _animation->find_node_index(name);
+	if (index < 0)
+		return false;
+
+	_weights[index] = weight;
+	if (not include_descendants)
+		return true;
+
+	// every parent comes before its children in the skeleton,
+	// so the descendants of a node directly follow it.
+	const auto &skeleton = _animation->get_skeleton();
+	for (size_t i = index + 1; i < skeleton.size(); ++i) {
+		if (skeleton[i].parent_index < index)
+			break;
+		_weights[i] = weight;
+	}
+	return true;
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,38 @@
+/**
+ * bone_mask.hpp
+ * ---
+ * this file defines the BoneMask class, which holds a weight (0 to 1)
+ * for every node of an Animation's skeleton. an Animator layer
+ * with a BoneMask only affects the nodes in proportion to their weights,
+ * so a clip can be played on (e.g.) only the upper body.
+ *
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include "animation.hpp"
+
+namespace gu {
+class BoneMask {
+private:
+	const Animation *_animation; // provides the skeleton
+	std::vector<float> _weights; // per Animation::SkeletonNode
+
+public:
+	// ctor. gives every node of the <animation>'s skeleton the <weight>.
+	BoneMask(const Animation &animation, const float &weight = 0.0f);
+
+	// sets the weight of the node with the given <name>
+	// and, if <include_descendants> is true, of every node below it.
+	// returns false if there's no node with the <name>.
+	bool set_weight(
+		const std::string &name,
+		const float &weight,
+		const bool &include_descendants = true
+	);
+
+	inline size_t size() const { return _weights.size(); }
+	inline const float *get_weights() const { return _weights.data(); }
+};
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "bone_palette.hpp"
+#include "../../system/gl_state.hpp"
+
+namespace gu {
+namespace res {
+BonePalette BonePalette::bone_palette;
+
+BonePalette::~BonePalette() {
+	deallocate();
+}
+
+void BonePalette::deallocate() {
+	if (_texture_ID != 0) {
+		glDeleteTextures(1, &_texture_ID);
+		GLState::forget_texture(_texture_ID);
+	}
+	if (_tbo_ID != 0)
+		glDeleteBuffers(1, &_tbo_ID);
+	_texture_ID = 0;
+	_tbo_ID = 0;
+	_capacity = 0;
+	std::vector<glm::mat4>().swap(_staged);
+}
+
+size_t BonePalette::push(const glm::mat4 *bone_mats, const size_t &n) {
+	size_t offset = _staged.size();
+	_staged.insert(_staged.end(), bone_mats, bone_mats + n);
+	return offset;
+}
+
+size_t BonePalette::allocate(const size_t &n) {
+	size_t offset = _staged.size();
+	_staged.resize(offset + n, glm::mat4(1.0f));
+	return offset;
+}
+
+void BonePalette::upload() {
+	_create();
+	while (_capacity < _staged.size())
+		_capacity *= 2;
+
+	// orphans the old storage so that the draws still reading it
+	// don't stall the upload.
+	glBindBuffer(GL_TEXTURE_BUFFER, _tbo_ID);
+	glBufferData(
+		GL_TEXTURE_BUFFER,
+		_capacity * sizeof(glm::mat4),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+	glBufferSubData(
+		GL_TEXTURE_BUFFER, 0, _staged.size() * sizeof(glm::mat4), _staged.data()
+	);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	GLState::bind_texture(TEXTURE_UNIT, GL_TEXTURE_BUFFER, _texture_ID);
+}
+
+void BonePalette::_create() {
+	if (_tbo_ID != 0)
+		return;
+
+	_capacity = MIN_CAPACITY;
+	glGenBuffers(1, &_tbo_ID);
+	glBindBuffer(GL_TEXTURE_BUFFER, _tbo_ID);
+	glBufferData(
+		GL_TEXTURE_BUFFER,
+		_capacity * sizeof(glm::mat4),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	// every texel is one column of a matrix.
+	// the texture keeps reading the buffer object after it's reallocated.
+	glGenTextures(1, &_texture_ID);
+	GLState::bind_texture(TEXTURE_UNIT, GL_TEXTURE_BUFFER, _texture_ID);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _tbo_ID);
+}
+} // namespace res
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * bone_palette.hpp
+ * ---
+ * this file defines the BonePalette class, which holds the final bone
+ * matrices of every animated instance drawn in a frame in one buffer
+ * that's read by the shaders as a texture buffer (samplerBuffer).
+ * each instance's matrices are placed at an offset in the buffer
+ * and the whole buffer is sent to the videocard with one call,
+ * so the number of bones isn't limited by the number of uniforms.
+ *
+ * ---
+ * a shader reads a bone matrix with:
+ *
+ * uniform samplerBuffer _bone_palette;
+ * uniform int _bone_offset; // first matrix of the palette
+ * uniform int _n_bones; // matrices per palette
+ *
+ * mat4 get_bone_mat(int bone_ID) {
+ *     int texel = (_bone_offset + gl_InstanceID * _n_bones + bone_ID) * 4;
+ *     return mat4(
+ *         texelFetch(_bone_palette, texel),
+ *         texelFetch(_bone_palette, texel + 1),
+ *         texelFetch(_bone_palette, texel + 2),
+ *         texelFetch(_bone_palette, texel + 3)
+ *     );
+ * }
+ *
+ * so the palettes of instances drawn together with hardware instancing
+ * have to be pushed one after another.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <glad/gl.h>
+#include <glm/mat4x4.hpp>
+
+namespace gu {
+namespace res {
+class BonePalette {
+public:
+	static BonePalette bone_palette;
+
+	// the texture unit the buffer is bound to,
+	// which follows the texture units of the Material::MAP_TYPEs.
+	static constexpr GLuint TEXTURE_UNIT = 8;
+
+private:
+	static const size_t MIN_CAPACITY = 1 << 10; // matrices
+	GLuint _tbo_ID = 0; // buffer object holding the matrices
+	GLuint _texture_ID = 0; // texture buffer reading the <_tbo_ID>
+	size_t _capacity = 0; // number of matrices the buffer holds
+	std::vector<glm::mat4> _staged; // matrices pushed since the last clear
+
+	// no other instances of this class can be created.
+	inline BonePalette() {}
+
+public:
+	// dtor. deletes the buffer and texture if they still exist.
+	~BonePalette();
+
+	// deletes the buffer and texture.
+	void deallocate();
+
+	// copies the given <n> <bone_mats> to the end of the palette
+	// and returns the offset (in matrices) that they were placed at.
+	size_t push(const glm::mat4 *bone_mats, const size_t &n);
+
+	// adds <n> matrices to the end of the palette to be written
+	// through get_matrices(...) and returns their offset.
+	size_t allocate(const size_t &n);
+
+	// returns the pushed matrices starting at the <offset>.
+	// the pointer is invalidated by the next push(...) or allocate(...).
+	inline glm::mat4 *get_matrices(const size_t &offset) {
+		return _staged.data() + offset;
+	}
+
+	// returns the offset that the next pushed matrices will be placed at.
+	inline size_t get_n_matrices() const { return _staged.size(); }
+
+	// sends every pushed matrix to the videocard with one call
+	// and binds the texture buffer to the TEXTURE_UNIT.
+	// this should be called once per frame, after every palette
+	// has been pushed and before any of them are drawn.
+	void upload();
+
+	// removes every pushed matrix.
+	// this should be called once per frame before pushing.
+	inline void clear() { _staged.clear(); }
+
+private:
+	// creates the buffer and texture if they don't exist yet.
+	void _create();
+};
+} // namespace res
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "clip_compression.hpp"
+#include <algorithm>
+#include <cmath>
+
+// the largest value of a quaternion's three smallest components.
+static const float MAX_SMALLEST_COMPONENT = 0.70710678f; // 1 / sqrt(2)
+static const uint32_t MAX_QUANTIZED_COMPONENT = (1 << 15) - 1;
+
+namespace gu {
+void ClipCompression::pack_orientation(
+	const glm::quat &orientation, uint16_t *packed
+) {
+	glm::quat q = glm::normalize(orientation);
+	float components[4] = { q.x, q.y, q.z, q.w };
+
+	uint8_t largest = 0;
+	for (uint8_t i = 1; i < 4; ++i)
+		if (std::abs(components[i]) > std::abs(components[largest]))
+			largest = i;
+
+	// q and -q are the same orientation,
+	// so the largest component is made positive and left out.
+	float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+	uint64_t bits = largest;
+	for (uint8_t i = 0; i < 4; ++i) {
+		if (i == largest)
+			continue;
+		float unit = (sign * components[i] / MAX_SMALLEST_COMPONENT) * 0.5f + 0.5f;
+		unit = std::clamp(unit, 0.0f, 1.0f);
+		uint64_t quantized = static_cast<uint64_t>(
+			std::lround(unit * MAX_QUANTIZED_COMPONENT)
+		);
+		bits = (bits << 15) | quantized;
+	}
+
+	packed[0] = static_cast<uint16_t>(bits >> 32);
+	packed[1] = static_cast<uint16_t>(bits >> 16);
+	packed[2] = static_cast<uint16_t>(bits);
+}
+
+glm::quat ClipCompression::unpack_orientation(const uint16_t *packed) {
+	uint64_t bits = (
+		  (static_cast<uint64_t>(packed[0]) << 32)
+		| (static_cast<uint64_t>(packed[1]) << 16)
+		| static_cast<uint64_t>(packed[2])
+	);
+	uint8_t largest = static_cast<uint8_t>((bits >> 45) & 0x3);
+
+	float components[4];
+	float sum_sq = 0.0f;
+	int shift = 30;
+	for (uint8_t i = 0; i < 4; ++i) {
+		if (i == largest)
+			continue;
+		uint32_t quantized = static_cast<uint32_t>(
+			(bits >> shift) & MAX_QUANTIZED_COMPONENT
+		);
+		float unit = static_cast<float>(quantized) / MAX_QUANTIZED_COMPONENT;
+		components[i] = (unit * 2.0f - 1.0f) * MAX_SMALLEST_COMPONENT;
+		sum_sq += components[i] * components[i];
+		shift -= 15;
+	}
+	components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum_sq));
+
+	return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+uint16_t ClipCompression::pack_time_stamp(
+	const double &time, const double &duration
+) {
+	if (duration <= 0.0)
+		return 0;
+	double unit = std::clamp(time / duration, 0.0, 1.0);
+	return static_cast<uint16_t>(std::lround(unit * MAX_TIME_STAMP));
+}
+
+float ClipCompression::get_angle_between(const glm::quat &a, const glm::quat &b) {
+	// atan2 keeps its precision for small angles, unlike acos.
+	glm::quat delta = a * glm::conjugate(b);
+	float sin_half = std::sqrt(
+		delta.x * delta.x + delta.y * delta.y + delta.z * delta.z
+	);
+	return 2.0f * std::atan2(sin_half, std::abs(delta.w));
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+ * clip_compression.hpp
+ * ---
+ * this file defines the ClipCompression struct, which holds
+ * the functions used to compress an Animation's keyframes when it's loaded:
+ * - keys that can be rebuilt by interpolating their neighbors
+ *   within a tolerance are removed.
+ * - orientations are quantized to 48 bits with the smallest-three method.
+ * - time stamps are quantized to 16 bits across the Animation's duration.
+ *
+ * ---
+ * a smallest-three orientation stores the index of the quaternion's
+ * largest component in 2 bits and its other three components
+ * in 15 bits each. the largest component is rebuilt from the others
+ * since the quaternion has a length of 1.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <glm/gtc/quaternion.hpp>
+
+namespace gu {
+struct ClipCompression {
+public:
+	static const uint16_t MAX_TIME_STAMP = 0xFFFF;
+
+	// the largest errors that removing a key is allowed to cause.
+	struct Tolerances {
+		float position = 0.0005f; // distance
+		float orientation = 0.0005f; // radians
+		float scaling = 0.0005f;
+	};
+
+	// describes how much an Animation was compressed.
+	struct Stats {
+		size_t n_source_keys = 0;
+		size_t n_kept_keys = 0;
+		size_t source_bytes = 0; // size of the Assimp keys
+		size_t compressed_bytes = 0; // size of the kept keys
+		float max_position_error = 0.0f; // distance
+		float max_orientation_error = 0.0f; // radians
+		float max_scaling_error = 0.0f;
+
+		// returns how many times smaller the kept keys are.
+		inline float get_ratio() const {
+			if (compressed_bytes == 0)
+				return 1.0f;
+			return static_cast<float>(source_bytes) / compressed_bytes;
+		}
+	};
+
+private:
+	// instances of this struct cannot be created.
+	ClipCompression() = delete;
+
+public:
+	// writes the <orientation> to the three 16-bit values at <packed>.
+	static void pack_orientation(const glm::quat &orientation, uint16_t *packed);
+
+	// returns the orientation stored in the three 16-bit values at <packed>.
+	static glm::quat unpack_orientation(const uint16_t *packed);
+
+	// returns the <time> as a fraction of the <duration> in 16 bits.
+	static uint16_t pack_time_stamp(const double &time, const double &duration);
+
+	// returns the angle (radians) between the orientations <a> and <b>.
+	static float get_angle_between(const glm::quat &a, const glm::quat &b);
+
+	// returns the indices of the <n_keys> keys that are kept,
+	// which always include the first and last key.
+	// <get_error(first, last, index)> must return the error of the key
+	// at <index> when it's interpolated between the keys <first> and <last>.
+	template <typename ErrorFunc>
+	static std::vector<size_t> reduce_keys(
+		const size_t &n_keys, const float &tolerance, ErrorFunc get_error
+	) {
+		std::vector<size_t> kept;
+		if (n_keys == 0)
+			return kept;
+
+		kept.push_back(0);
+		size_t first = 0;
+		for (size_t last = 2; last < n_keys; ++last) {
+			for (size_t i = first + 1; i < last; ++i) {
+				if (get_error(first, last, i) > tolerance) {
+					first = last - 1;
+					kept.push_back(first);
+					break;
+				}
+			}
+		}
+		if (n_keys > 1)
+			kept.push_back(n_keys - 1);
+		return kept;
+	}
+};
+} // namespace gu
\ No newline at end of file
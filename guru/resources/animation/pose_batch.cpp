@@ -0,0 +1,355 @@
+#include "pose_batch.hpp"
+#include <cmath>
+#if defined(GURU_SIMD_ANIMATION)
+#include <xmmintrin.h>
+#endif
+
+// returns the orientation at <index> of the given pose <lanes>.
+static inline glm::quat get_orientation(
+	const std::vector<float> *lanes, const size_t &index
+) {
+	return glm::quat(
+		lanes[gu::PoseBatch::ROT_W][index],
+		lanes[gu::PoseBatch::ROT_X][index],
+		lanes[gu::PoseBatch::ROT_Y][index],
+		lanes[gu::PoseBatch::ROT_Z][index]
+	);
+}
+
+// sets the orientation at <index> of the given pose <lanes>.
+static inline void set_orientation(
+	std::vector<float> *lanes, const size_t &index, const glm::quat &q
+) {
+	lanes[gu::PoseBatch::ROT_X][index] = q.x;
+	lanes[gu::PoseBatch::ROT_Y][index] = q.y;
+	lanes[gu::PoseBatch::ROT_Z][index] = q.z;
+	lanes[gu::PoseBatch::ROT_W][index] = q.w;
+}
+
+// returns the normalized lerp from <a> to <b> along the shortest path.
+static inline glm::quat nlerp(
+	const glm::quat &a, const glm::quat &b, const float &t
+) {
+	glm::quat to = glm::dot(a, b) < 0.0f ? -b : b;
+	return glm::normalize(a * (1.0f - t) + to * t);
+}
+
+namespace gu {
+void PoseBatch::resize(const size_t &n_nodes) {
+	_n_nodes = n_nodes;
+	_n_padded = (n_nodes + BATCH_WIDTH - 1) / BATCH_WIDTH * BATCH_WIDTH;
+	for (uint8_t i = 0; i < N_LANES; ++i)
+		_lanes[i].assign(_n_padded, 0.0f);
+	for (uint8_t i = 0; i < N_POSE_LANES; ++i)
+		_pose[i].assign(_n_padded, 0.0f);
+
+	// the orientations and scalings must not be zero
+	// so that the padding lanes are never divided by zero.
+	const LANE ONE_LANES[] = {
+		ROT_0_W, ROT_1_W,
+		SCL_0_X, SCL_0_Y, SCL_0_Z,
+		SCL_1_X, SCL_1_Y, SCL_1_Z,
+	};
+	for (const LANE &lane : ONE_LANES)
+		_lanes[lane].assign(_n_padded, 1.0f);
+
+	const POSE_LANE ONE_POSE_LANES[] = { ROT_W, SCL_X, SCL_Y, SCL_Z };
+	for (const POSE_LANE &lane : ONE_POSE_LANES)
+		_pose[lane].assign(_n_padded, 1.0f);
+
+	_local_mats.assign(_n_padded, glm::mat4(1.0f));
+}
+
+void PoseBatch::set_constant(
+	const size_t &index,
+	const glm::vec3 &position,
+	const glm::quat &orientation,
+	const glm::vec3 &scaling
+) {
+	for (uint8_t c = 0; c < 3; ++c) {
+		_lanes[POS_0_X + c][index] = position[c];
+		_lanes[POS_1_X + c][index] = position[c];
+		_lanes[SCL_0_X + c][index] = scaling[c];
+		_lanes[SCL_1_X + c][index] = scaling[c];
+	}
+	const float q[4] = {
+		orientation.x, orientation.y, orientation.z, orientation.w
+	};
+	for (uint8_t c = 0; c < 4; ++c) {
+		_lanes[ROT_0_X + c][index] = q[c];
+		_lanes[ROT_1_X + c][index] = q[c];
+	}
+	_lanes[POS_FACTOR][index] = 0.0f;
+	_lanes[ROT_FACTOR][index] = 0.0f;
+	_lanes[SCL_FACTOR][index] = 0.0f;
+}
+
+void PoseBatch::interpolate() {
+#if defined(GURU_SIMD_ANIMATION)
+	_interpolate_simd(0, _n_padded);
+#else
+	_interpolate_scalar(0, _n_nodes);
+#endif
+}
+
+void PoseBatch::compose() {
+#if defined(GURU_SIMD_ANIMATION)
+	_compose_simd(0, _n_padded);
+#else
+	_compose_scalar(0, _n_nodes);
+#endif
+}
+
+void PoseBatch::blend(
+	const PoseBatch &other, const float &weight, const float *node_weights
+) {
+	for (size_t i = 0; i < _n_nodes; ++i) {
+		float w = node_weights ? weight * node_weights[i] : weight;
+		if (w <= 0.0f)
+			continue;
+
+		for (uint8_t c = 0; c < 3; ++c) {
+			float &pos = _pose[POS_X + c][i];
+			float &scl = _pose[SCL_X + c][i];
+			pos += (other._pose[POS_X + c][i] - pos) * w;
+			scl += (other._pose[SCL_X + c][i] - scl) * w;
+		}
+		set_orientation(
+			_pose,
+			i,
+			nlerp(get_orientation(_pose, i), get_orientation(other._pose, i), w)
+		);
+	}
+}
+
+void PoseBatch::add(
+	const PoseBatch &other,
+	const PoseBatch &reference,
+	const float &weight,
+	const float *node_weights
+) {
+	const glm::quat IDENTITY = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+	for (size_t i = 0; i < _n_nodes; ++i) {
+		float w = node_weights ? weight * node_weights[i] : weight;
+		if (w <= 0.0f)
+			continue;
+
+		for (uint8_t c = 0; c < 3; ++c) {
+			float delta_pos = (
+				other._pose[POS_X + c][i] - reference._pose[POS_X + c][i]
+			);
+			float scl_ratio = (
+				other._pose[SCL_X + c][i] / reference._pose[SCL_X + c][i]
+			);
+			_pose[POS_X + c][i] += delta_pos * w;
+			_pose[SCL_X + c][i] *= 1.0f + (scl_ratio - 1.0f) * w;
+		}
+
+		// the rotation from the reference to the other orientation
+		// is applied on top of this orientation.
+		glm::quat delta_rot = (
+			get_orientation(other._pose, i)
+			* glm::conjugate(get_orientation(reference._pose, i))
+		);
+		set_orientation(
+			_pose,
+			i,
+			glm::normalize(
+				nlerp(IDENTITY, delta_rot, w) * get_orientation(_pose, i)
+			)
+		);
+	}
+}
+
+void PoseBatch::_interpolate_scalar(const size_t &start, const size_t &end) {
+	for (size_t i = start; i < end; ++i) {
+		// lerps the position and scaling.
+		float pos_t = _lanes[POS_FACTOR][i];
+		float scl_t = _lanes[SCL_FACTOR][i];
+		for (uint8_t c = 0; c < 3; ++c) {
+			float p0 = _lanes[POS_0_X + c][i];
+			float s0 = _lanes[SCL_0_X + c][i];
+			_pose[POS_X + c][i] = p0 + (_lanes[POS_1_X + c][i] - p0) * pos_t;
+			_pose[SCL_X + c][i] = s0 + (_lanes[SCL_1_X + c][i] - s0) * scl_t;
+		}
+
+		// nlerps the orientation along the shortest path.
+		float q0[4], q1[4];
+		float dot = 0.0f;
+		for (uint8_t c = 0; c < 4; ++c) {
+			q0[c] = _lanes[ROT_0_X + c][i];
+			q1[c] = _lanes[ROT_1_X + c][i];
+			dot += q0[c] * q1[c];
+		}
+		float rot_t = _lanes[ROT_FACTOR][i];
+		float sign = dot < 0.0f ? -1.0f : 1.0f;
+		float q[4];
+		float length_sq = 0.0f;
+		for (uint8_t c = 0; c < 4; ++c) {
+			q[c] = q0[c] + (sign * q1[c] - q0[c]) * rot_t;
+			length_sq += q[c] * q[c];
+		}
+		float inv_length = 1.0f / std::sqrt(length_sq);
+		for (uint8_t c = 0; c < 4; ++c)
+			_pose[ROT_X + c][i] = q[c] * inv_length;
+	}
+}
+
+void PoseBatch::_compose_scalar(const size_t &start, const size_t &end) {
+	for (size_t i = start; i < end; ++i) {
+		float x = _pose[ROT_X][i], y = _pose[ROT_Y][i];
+		float z = _pose[ROT_Z][i], w = _pose[ROT_W][i];
+		float sx = _pose[SCL_X][i], sy = _pose[SCL_Y][i], sz = _pose[SCL_Z][i];
+
+		// composes translate * rotate * scale.
+		glm::mat4 &mat = _local_mats[i];
+		mat[0][0] = (1.0f - 2.0f * (y * y + z * z)) * sx;
+		mat[0][1] = 2.0f * (x * y + w * z) * sx;
+		mat[0][2] = 2.0f * (x * z - w * y) * sx;
+		mat[0][3] = 0.0f;
+		mat[1][0] = 2.0f * (x * y - w * z) * sy;
+		mat[1][1] = (1.0f - 2.0f * (x * x + z * z)) * sy;
+		mat[1][2] = 2.0f * (y * z + w * x) * sy;
+		mat[1][3] = 0.0f;
+		mat[2][0] = 2.0f * (x * z + w * y) * sz;
+		mat[2][1] = 2.0f * (y * z - w * x) * sz;
+		mat[2][2] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+		mat[2][3] = 0.0f;
+		mat[3][0] = _pose[POS_X][i];
+		mat[3][1] = _pose[POS_Y][i];
+		mat[3][2] = _pose[POS_Z][i];
+		mat[3][3] = 1.0f;
+	}
+}
+
+#if defined(GURU_SIMD_ANIMATION)
+// returns <a> + (<b> - <a>) * <t>.
+static inline __m128 lerp(const __m128 &a, const __m128 &b, const __m128 &t) {
+	return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+// stores the column (<x>, <y>, <z>, <w>) of four matrices,
+// with each vector holding one row for every matrix.
+static inline void store_columns(
+	glm::mat4 *mats,
+	const size_t &column,
+	__m128 x,
+	__m128 y,
+	__m128 z,
+	__m128 w
+) {
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	_mm_storeu_ps(&mats[0][column][0], x);
+	_mm_storeu_ps(&mats[1][column][0], y);
+	_mm_storeu_ps(&mats[2][column][0], z);
+	_mm_storeu_ps(&mats[3][column][0], w);
+}
+
+void PoseBatch::_interpolate_simd(const size_t &start, const size_t &end) {
+	const __m128 ZERO = _mm_setzero_ps();
+	const __m128 ONE = _mm_set1_ps(1.0f);
+	const __m128 SIGN_BIT = _mm_set1_ps(-0.0f);
+	auto load = [this](const LANE &lane, const size_t &i) {
+		return _mm_loadu_ps(&_lanes[lane][i]);
+	};
+	auto store = [this](const POSE_LANE &lane, const size_t &i, __m128 v) {
+		_mm_storeu_ps(&_pose[lane][i], v);
+	};
+
+	for (size_t i = start; i < end; i += BATCH_WIDTH) {
+		// lerps the position and scaling.
+		__m128 pos_t = load(POS_FACTOR, i);
+		store(POS_X, i, lerp(load(POS_0_X, i), load(POS_1_X, i), pos_t));
+		store(POS_Y, i, lerp(load(POS_0_Y, i), load(POS_1_Y, i), pos_t));
+		store(POS_Z, i, lerp(load(POS_0_Z, i), load(POS_1_Z, i), pos_t));
+
+		__m128 scl_t = load(SCL_FACTOR, i);
+		store(SCL_X, i, lerp(load(SCL_0_X, i), load(SCL_1_X, i), scl_t));
+		store(SCL_Y, i, lerp(load(SCL_0_Y, i), load(SCL_1_Y, i), scl_t));
+		store(SCL_Z, i, lerp(load(SCL_0_Z, i), load(SCL_1_Z, i), scl_t));
+
+		// nlerps the orientation along the shortest path.
+		__m128 q0x = load(ROT_0_X, i), q0y = load(ROT_0_Y, i);
+		__m128 q0z = load(ROT_0_Z, i), q0w = load(ROT_0_W, i);
+		__m128 q1x = load(ROT_1_X, i), q1y = load(ROT_1_Y, i);
+		__m128 q1z = load(ROT_1_Z, i), q1w = load(ROT_1_W, i);
+		__m128 dot = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(q0x, q1x), _mm_mul_ps(q0y, q1y)),
+			_mm_add_ps(_mm_mul_ps(q0z, q1z), _mm_mul_ps(q0w, q1w))
+		);
+		__m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, ZERO), SIGN_BIT);
+		__m128 rot_t = load(ROT_FACTOR, i);
+		__m128 x = lerp(q0x, _mm_xor_ps(q1x, flip), rot_t);
+		__m128 y = lerp(q0y, _mm_xor_ps(q1y, flip), rot_t);
+		__m128 z = lerp(q0z, _mm_xor_ps(q1z, flip), rot_t);
+		__m128 w = lerp(q0w, _mm_xor_ps(q1w, flip), rot_t);
+		__m128 length_sq = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+			_mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))
+		);
+		__m128 inv_length = _mm_div_ps(ONE, _mm_sqrt_ps(length_sq));
+		store(ROT_X, i, _mm_mul_ps(x, inv_length));
+		store(ROT_Y, i, _mm_mul_ps(y, inv_length));
+		store(ROT_Z, i, _mm_mul_ps(z, inv_length));
+		store(ROT_W, i, _mm_mul_ps(w, inv_length));
+	}
+}
+
+void PoseBatch::_compose_simd(const size_t &start, const size_t &end) {
+	const __m128 ZERO = _mm_setzero_ps();
+	const __m128 ONE = _mm_set1_ps(1.0f);
+	const __m128 TWO = _mm_set1_ps(2.0f);
+	auto load = [this](const POSE_LANE &lane, const size_t &i) {
+		return _mm_loadu_ps(&_pose[lane][i]);
+	};
+
+	for (size_t i = start; i < end; i += BATCH_WIDTH) {
+		__m128 x = load(ROT_X, i), y = load(ROT_Y, i);
+		__m128 z = load(ROT_Z, i), w = load(ROT_W, i);
+		__m128 sx = load(SCL_X, i), sy = load(SCL_Y, i), sz = load(SCL_Z, i);
+
+		// composes translate * rotate * scale.
+		__m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y);
+		__m128 zz = _mm_mul_ps(z, z), xy = _mm_mul_ps(x, y);
+		__m128 xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+		__m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y);
+		__m128 wz = _mm_mul_ps(w, z);
+
+		glm::mat4 *mats = &_local_mats[i];
+		store_columns(
+			mats,
+			0,
+			_mm_mul_ps(
+				_mm_sub_ps(ONE, _mm_mul_ps(TWO, _mm_add_ps(yy, zz))), sx
+			),
+			_mm_mul_ps(_mm_mul_ps(TWO, _mm_add_ps(xy, wz)), sx),
+			_mm_mul_ps(_mm_mul_ps(TWO, _mm_sub_ps(xz, wy)), sx),
+			ZERO
+		);
+		store_columns(
+			mats,
+			1,
+			_mm_mul_ps(_mm_mul_ps(TWO, _mm_sub_ps(xy, wz)), sy),
+			_mm_mul_ps(
+				_mm_sub_ps(ONE, _mm_mul_ps(TWO, _mm_add_ps(xx, zz))), sy
+			),
+			_mm_mul_ps(_mm_mul_ps(TWO, _mm_add_ps(yz, wx)), sy),
+			ZERO
+		);
+		store_columns(
+			mats,
+			2,
+			_mm_mul_ps(_mm_mul_ps(TWO, _mm_add_ps(xz, wy)), sz),
+			_mm_mul_ps(_mm_mul_ps(TWO, _mm_sub_ps(yz, wx)), sz),
+			_mm_mul_ps(
+				_mm_sub_ps(ONE, _mm_mul_ps(TWO, _mm_add_ps(xx, yy))), sz
+			),
+			ZERO
+		);
+		store_columns(
+			mats, 3, load(POS_X, i), load(POS_Y, i), load(POS_Z, i), ONE
+		);
+	}
+}
+#endif
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,151 @@
+/**
+ * pose_batch.hpp
+ * ---
+ * this file defines the PoseBatch class, which holds the keyframe pairs
+ * sampled for every node of a skeleton in structure-of-arrays lanes,
+ * interpolates them into a local-space pose all at once,
+ * and composes that pose into local transform matrices.
+ * between interpolating and composing, other poses can be blended in.
+ *
+ * ---
+ * with SSE, four nodes are interpolated per batch
+ * (lerp for position and scaling, nlerp for orientation)
+ * and composed into translate * rotate * scale matrices.
+ * without SSE, or if GURU_DISABLE_SIMD_ANIMATION is defined,
+ * the same math runs one node at a time.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#if not defined(GURU_DISABLE_SIMD_ANIMATION) and ( \
+	defined(__SSE__) or defined(_M_X64) or defined(_M_AMD64) \
+	or (defined(_M_IX86_FP) and _M_IX86_FP >= 1) \
+)
+#define GURU_SIMD_ANIMATION
+#endif
+
+namespace gu {
+class PoseBatch {
+public:
+	// the number of nodes interpolated together.
+	static const size_t BATCH_WIDTH = 4;
+
+	// every lane holds one value per node.
+	// the factors are the progress (0 to 1) between the two keyframes.
+	enum LANE : uint8_t {
+		POS_0_X, POS_0_Y, POS_0_Z,
+		POS_1_X, POS_1_Y, POS_1_Z,
+		POS_FACTOR,
+		ROT_0_X, ROT_0_Y, ROT_0_Z, ROT_0_W,
+		ROT_1_X, ROT_1_Y, ROT_1_Z, ROT_1_W,
+		ROT_FACTOR,
+		SCL_0_X, SCL_0_Y, SCL_0_Z,
+		SCL_1_X, SCL_1_Y, SCL_1_Z,
+		SCL_FACTOR,
+		N_LANES,
+	};
+
+	// the lanes of the interpolated local-space pose.
+	enum POSE_LANE : uint8_t {
+		POS_X, POS_Y, POS_Z,
+		ROT_X, ROT_Y, ROT_Z, ROT_W,
+		SCL_X, SCL_Y, SCL_Z,
+		N_POSE_LANES,
+	};
+
+private:
+	size_t _n_nodes = 0;
+	size_t _n_padded = 0; // <_n_nodes> rounded up to the BATCH_WIDTH
+	std::vector<float> _lanes[N_LANES];
+	std::vector<float> _pose[N_POSE_LANES]; // the results of interpolate()
+	std::vector<glm::mat4> _local_mats; // the results of compose()
+
+public:
+	// sets the number of nodes in the batch.
+	// every lane is filled with an identity transform.
+	void resize(const size_t &n_nodes);
+
+	inline size_t size() const { return _n_nodes; }
+
+	// returns the values of the <lane> for every node.
+	inline float *get_lane(const LANE &lane) { return _lanes[lane].data(); }
+
+	// returns the values of the interpolated pose's <lane> for every node.
+	inline float *get_pose_lane(const POSE_LANE &lane) {
+		return _pose[lane].data();
+	}
+	inline const float *get_pose_lane(const POSE_LANE &lane) const {
+		return _pose[lane].data();
+	}
+
+	// sets both keyframes of the node at <index> to the given transform,
+	// so that it doesn't change when interpolated.
+	void set_constant(
+		const size_t &index,
+		const glm::vec3 &position,
+		const glm::quat &orientation,
+		const glm::vec3 &scaling
+	);
+
+	// interpolates every node's keyframe pair into the pose.
+	void interpolate();
+
+	// builds the local transform matrix of every node from the pose.
+	void compose();
+
+	// interpolates and composes every node.
+	inline void evaluate() {
+		interpolate();
+		compose();
+	}
+
+	// blends the pose of the <other> batch into this pose by the <weight>,
+	// with each node's <weight> multiplied by its <node_weights>
+	// if they're given. orientations take the shortest path.
+	void blend(
+		const PoseBatch &other,
+		const float &weight,
+		const float *node_weights = nullptr
+	);
+
+	// adds the difference between the pose of the <other> batch
+	// and the pose of the <reference> batch onto this pose by the <weight>,
+	// with each node's <weight> multiplied by its <node_weights>
+	// if they're given.
+	void add(
+		const PoseBatch &other,
+		const PoseBatch &reference,
+		const float &weight,
+		const float *node_weights = nullptr
+	);
+
+	// returns the local transform matrix of each node
+	// that was built by the last call to compose().
+	inline const std::vector<glm::mat4> &get_local_mats() const {
+		return _local_mats;
+	}
+
+private:
+	// interpolates the nodes from <start> to <end> one at a time.
+	void _interpolate_scalar(const size_t &start, const size_t &end);
+
+	// composes the nodes from <start> to <end> one at a time.
+	void _compose_scalar(const size_t &start, const size_t &end);
+
+#if defined(GURU_SIMD_ANIMATION)
+	// interpolates the nodes from <start> to <end>
+	// in batches of BATCH_WIDTH with SSE.
+	void _interpolate_simd(const size_t &start, const size_t &end);
+
+	// composes the nodes from <start> to <end>
+	// in batches of BATCH_WIDTH with SSE.
+	void _compose_simd(const size_t &start, const size_t &end);
+#endif
+};
+} // namespace gu
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "../texture/load_texture.hpp"
 #include "../texture/color_texture.hpp"
 #include "../texture/texture_list.hpp"
+#include "../../system/directory_cache.hpp"
+#include "../../system/gl_state.hpp"
 
 namespace gu {
 const Color Material::DEFAULT_COLORS[N_MAP_TYPES] = {
@@ -49,19 +51,62 @@ void Material::load_textures(const std::filesystem::path &diffuse_path) {
 }
 
 void Material::load_textures(const std::filesystem::path *paths) {
-	// diffuse will always be used by a Shader,
-	// and only the diffuse texture is used to determine transparency.
-	_texture_infos[0] = res::load_texture(paths[0], &_transparent);
-	_map_loaded[0] = true;
+	Images images;
+	find_images(images, paths);
 
-	// loads each texture map.
+	// decodes the images that haven't been loaded yet in parallel.
+	std::vector<res::ImageData *> requests;
+	for (uint8_t i = 0; i < N_MAP_TYPES; ++i) {
+		const std::filesystem::path &path = images.paths[i];
+		if (
+			not path.empty()
+			and not res::TextureList::texture_list.find_existing(path)
+		) {
+			images.decoded[i].path = path;
+			requests.push_back(&images.decoded[i]);
+		}
+	}
+	res::decode_images(requests);
+	load_textures(images);
+}
+
+void Material::load_textures(Images &images) {
+	for (uint8_t i = 0; i < N_MAP_TYPES; ++i) {
+		// diffuse will always be used by a Shader,
+		// and only the diffuse texture is used to determine transparency.
+		bool *is_transparent = i == 0 ? &_transparent : nullptr;
+		_map_loaded[i] = images.map_loaded[i];
+
+		if (i > 0 and images.paths[i].empty()) {
+			// no possible image was found for the map type,
+			// so a solid color texture is used.
+			_texture_infos[i] = res::create_solid_color(DEFAULT_COLORS[i]);
+		} else if (not images.decoded[i].path.empty()) {
+			_texture_infos[i] = res::upload_texture(
+				images.decoded[i], is_transparent
+			);
+		} else {
+			_texture_infos[i] = res::load_texture(
+				images.paths[i], is_transparent
+			);
+		}
+	}
+}
+
+void Material::find_images(Images &images, const std::filesystem::path *paths) {
+	images.paths[0] = paths[0];
+	images.map_loaded[0] = true;
+
+	// finds each texture map.
 	std::string file_stem_str = (
 		paths[0].parent_path().string() / paths[0].stem()
 	).string();
 	std::string file_extension_str = paths[0].extension().string();
 	for (int i = 1; i < N_MAP_TYPES; ++i) {
-		if (not paths[i].empty() and std::filesystem::exists(paths[i])) {
-			_texture_infos[i] = res::load_texture(paths[i]);
+		images.paths[i].clear();
+		images.map_loaded[i] = false;
+		if (not paths[i].empty() and DirectoryCache::contains(paths[i])) {
+			images.paths[i] = paths[i];
 		} else {
 			// if the image path is not found,
 			// then the program tries to find an image with the name
@@ -74,31 +119,41 @@ void Material::load_textures(const std::filesystem::path *paths) {
 			static const int N_EXTENSIONS = (
 				sizeof(EXTENSIONS) / sizeof(EXTENSIONS[0])
 			);
-			bool image_found = false;
 			for (int j = 0; j < N_EXTENSIONS; ++j) {
 				std::filesystem::path img_path = std::filesystem::path(
 					file_stem_str + '_' + MAP_TYPE_STRS[i] + EXTENSIONS[j]
 				);
-				if (std::filesystem::exists(img_path)) {
-					_texture_infos[i] = res::load_texture(img_path);
-					image_found = true;
-					_map_loaded[i] = true;
+				if (DirectoryCache::contains(img_path)) {
+					images.paths[i] = img_path;
+					images.map_loaded[i] = true;
 					break;
 				}
 			}
+		}
+	}
+}
 
-			// if no possible image is found for the map type,
-			// then a solid color texture is used.
-			if (not image_found)
-				_texture_infos[i] = res::create_solid_color(DEFAULT_COLORS[i]);
+void Material::decode_images(Images &images) {
+	decode_images(std::vector<Images *>({&images}));
+}
+
+void Material::decode_images(const std::vector<Images *> &images) {
+	std::vector<res::ImageData *> requests;
+	for (Images *material_images : images) {
+		for (uint8_t i = 0; i < N_MAP_TYPES; ++i) {
+			const std::filesystem::path &path = material_images->paths[i];
+			if (not path.empty()) {
+				material_images->decoded[i].path = path;
+				requests.push_back(&material_images->decoded[i]);
+			}
 		}
 	}
+	res::decode_images(requests);
 }
 
 void Material::bind_to_GL() const {
 	for (uint8_t i = 0; i < N_MAP_TYPES; ++i) {
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, _texture_infos[i]->texture_ID);
+		GLState::bind_texture(i, GL_TEXTURE_2D, _texture_infos[i]->texture_ID);
 	}
 }
 } // namespace gu
\ No newline at end of file
@@ -117,8 +117,11 @@
  */
 
 #pragma once
+#include <array>
 #include <filesystem>
 #include <string>
+#include <vector>
+#include "../texture/load_texture.hpp"
 #include "../texture/texture_info.hpp"
 #include "../color.hpp"
 
@@ -163,6 +166,24 @@ public:
 	// number of loaded map types.
 	static const uint8_t N_MAP_TYPES = 7;
 
+	// the image paths for each loaded map type, ordered by MAP_TYPE.
+	typedef std::array<std::filesystem::path, N_MAP_TYPES> MapPaths;
+
+	/**
+	 * Material::Images
+	 * ---
+	 * this struct holds the image path found for each map type
+	 * and the decoded images, which are prepared without any OpenGL calls
+	 * so that a Material can be loaded on another thread
+	 * before its textures are uploaded on the main thread.
+	 *
+	 */
+	struct Images {
+		MapPaths paths; // empty if a solid color is used
+		bool map_loaded[N_MAP_TYPES]; // matches Material's <_map_loaded>
+		res::ImageData decoded[N_MAP_TYPES]; // empty path if not decoded
+	};
+
 private:
 	static const Color DEFAULT_COLORS[N_MAP_TYPES]; // when no image is found
 	std::shared_ptr<res::TextureInfo> _texture_infos[N_MAP_TYPES]; // maps
@@ -202,6 +223,25 @@ public:
 	// will be created by the program.
 	void load_textures(const std::filesystem::path *paths);
 
+	// loads textures from the given <images>,
+	// uploading any images that were already decoded.
+	// this must be called from the main thread.
+	void load_textures(Images &images);
+
+	// finds the image path of each map type from the given <paths>
+	// in the same way as load_textures(...), without loading anything.
+	// the searched directories are listed once by the DirectoryCache.
+	static void find_images(Images &images, const std::filesystem::path *paths);
+
+	// decodes every image found by find_images(...) in parallel.
+	// no OpenGL calls are made, so this can be run on any thread.
+	static void decode_images(Images &images);
+
+	// decodes every image found by find_images(...) for all of the given
+	// <images> at once, e.g. for every Material of a ModelResource.
+	// no OpenGL calls are made, so this can be run on any thread.
+	static void decode_images(const std::vector<Images *> &images);
+
 	// binds the textures for OpenGL rendering.
 	void bind_to_GL() const;
 };
@@ -30,5 +30,18 @@ std::shared_ptr<Material> MaterialList::create_and_load(
 	add_entry(material);
 	return material;
 }
+
+std::shared_ptr<Material> MaterialList::create_and_load(
+	Material::Images &images
+) {
+	std::shared_ptr<Material> material = find_existing(images.paths[0]);
+	if (material)
+		return material;
+
+	material = std::make_shared<Material>();
+	material->load_textures(images);
+	add_entry(material);
+	return material;
+}
 } // namespace res
 } // namespace gu
\ No newline at end of file
@@ -35,6 +35,11 @@ public:
 	std::shared_ptr<Material> create_and_load(
 		const std::filesystem::path *paths
 	);
+
+	// returns a created a shared pointer entry for a new Material
+	// that has its textures loaded from the given found <images>.
+	// this must be called from the main thread.
+	std::shared_ptr<Material> create_and_load(Material::Images &images);
 };
 }
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "geometry_arena.hpp"
+#include <cstddef>
+#include <iterator>
+#include "../../system/gl_state.hpp"
+
+static const size_t NOT_FOUND = static_cast<size_t>(-1);
+
+// returns the offset of a block of <n> elements taken from the <free_blocks>,
+// using the first block large enough.
+// if no block is large enough, then NOT_FOUND is returned.
+static size_t take_block(std::map<size_t, size_t> &free_blocks, size_t n) {
+	for (auto iter = free_blocks.begin(); iter != free_blocks.end(); ++iter) {
+		if (iter->second < n)
+			continue;
+		size_t offset = iter->first;
+		size_t remaining = iter->second - n;
+		free_blocks.erase(iter);
+		if (remaining > 0)
+			free_blocks[offset + n] = remaining;
+		return offset;
+	}
+	return NOT_FOUND;
+}
+
+// returns the block of <n> elements at <offset> to the <free_blocks>,
+// merging it with any neighboring free blocks.
+static void return_block(
+	std::map<size_t, size_t> &free_blocks, size_t offset, size_t n
+) {
+	if (n == 0)
+		return;
+	auto next = free_blocks.lower_bound(offset);
+	if (next != free_blocks.end() and offset + n == next->first) {
+		n += next->second;
+		next = free_blocks.erase(next);
+	}
+	if (next != free_blocks.begin()) {
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == offset) {
+			prev->second += n;
+			return;
+		}
+	}
+	free_blocks[offset] = n;
+}
+
+// returns a new buffer of <new_size> bytes that contains
+// the first <old_size> bytes of the given <old_buffer_ID>,
+// which is then deleted.
+static GLuint copy_to_larger_buffer(
+	GLuint old_buffer_ID, GLsizeiptr old_size, GLsizeiptr new_size
+) {
+	GLuint new_buffer_ID;
+	glGenBuffers(1, &new_buffer_ID);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, new_buffer_ID);
+	glBufferData(GL_COPY_WRITE_BUFFER, new_size, nullptr, GL_STATIC_DRAW);
+	if (old_buffer_ID != 0) {
+		glBindBuffer(GL_COPY_READ_BUFFER, old_buffer_ID);
+		glCopyBufferSubData(
+			GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, old_size
+		);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &old_buffer_ID);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return new_buffer_ID;
+}
+
+namespace gu {
+namespace res {
+GeometryArena GeometryArena::geometry_arena;
+
+GeometryArena::~GeometryArena() {
+	deallocate();
+}
+
+void GeometryArena::deallocate() {
+	if (_vao_ID != 0) {
+		glDeleteVertexArrays(1, &_vao_ID);
+		GLState::forget_VAO(_vao_ID);
+	}
+	if (_vbo_ID != 0)
+		glDeleteBuffers(1, &_vbo_ID);
+	if (_ebo_ID != 0)
+		glDeleteBuffers(1, &_ebo_ID);
+	if (_instance_vbo_ID != 0)
+		glDeleteBuffers(1, &_instance_vbo_ID);
+	if (_instance_time_vbo_ID != 0)
+		glDeleteBuffers(1, &_instance_time_vbo_ID);
+	_vao_ID = 0;
+	_vbo_ID = 0;
+	_ebo_ID = 0;
+	_instance_vbo_ID = 0;
+	_instance_time_vbo_ID = 0;
+	_vertex_capacity = 0;
+	_index_capacity = 0;
+	_instance_capacity = 0;
+	_instance_time_capacity = 0;
+	_free_vertices.clear();
+	_free_indices.clear();
+}
+
+GeometryArena::Range GeometryArena::allocate(
+	const Vertex *vertices,
+	const size_t &n_vertices,
+	const uint32_t *indices,
+	const size_t &n_indices
+) {
+	if (_vao_ID == 0)
+		_create();
+
+	// finds free blocks for the geometry, growing the buffers if needed.
+	Range range;
+	range.n_vertices = n_vertices;
+	range.n_indices = n_indices;
+	if (n_vertices > 0) {
+		range.base_vertex = take_block(_free_vertices, n_vertices);
+		if (range.base_vertex == NOT_FOUND) {
+			_grow_vertices(_vertex_capacity + n_vertices);
+			range.base_vertex = take_block(_free_vertices, n_vertices);
+		}
+	}
+	if (n_indices > 0) {
+		range.first_index = take_block(_free_indices, n_indices);
+		if (range.first_index == NOT_FOUND) {
+			_grow_indices(_index_capacity + n_indices);
+			range.first_index = take_block(_free_indices, n_indices);
+		}
+	}
+
+	// copies the geometry into its blocks.
+	// the copy-write target is used so that no VAO state is changed.
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _vbo_ID);
+	glBufferSubData(
+		GL_COPY_WRITE_BUFFER,
+		range.base_vertex * sizeof(Vertex),
+		n_vertices * sizeof(Vertex),
+		vertices
+	);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _ebo_ID);
+	glBufferSubData(
+		GL_COPY_WRITE_BUFFER,
+		range.first_index * sizeof(uint32_t),
+		n_indices * sizeof(uint32_t),
+		indices
+	);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return range;
+}
+
+void GeometryArena::free(const Range &range) {
+	if (_vao_ID == 0)
+		return;
+	return_block(_free_vertices, range.base_vertex, range.n_vertices);
+	return_block(_free_indices, range.first_index, range.n_indices);
+}
+
+void GeometryArena::bind() const {
+	GLState::bind_VAO(_vao_ID);
+}
+
+void GeometryArena::set_instances(const glm::mat4 *model_mats, const size_t &n) {
+	if (_vao_ID == 0)
+		_create();
+	while (_instance_capacity < n)
+		_instance_capacity *= 2;
+
+	glBindBuffer(GL_ARRAY_BUFFER, _instance_vbo_ID);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		_instance_capacity * sizeof(glm::mat4),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, n * sizeof(glm::mat4), model_mats);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::set_instance_times(
+	const float *anim_times, const size_t &n
+) {
+	if (_vao_ID == 0)
+		_create();
+	while (_instance_time_capacity < n)
+		_instance_time_capacity *= 2;
+
+	glBindBuffer(GL_ARRAY_BUFFER, _instance_time_vbo_ID);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		_instance_time_capacity * sizeof(float),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, n * sizeof(float), anim_times);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::_create() {
+	glGenVertexArrays(1, &_vao_ID);
+	_grow_vertices(MIN_VERTEX_CAPACITY);
+	_grow_indices(MIN_INDEX_CAPACITY);
+	_create_instance_buffer();
+}
+
+void GeometryArena::_grow_vertices(const size_t &min_capacity) {
+	size_t old_capacity = _vertex_capacity;
+	size_t new_capacity = old_capacity > 0 ? old_capacity : MIN_VERTEX_CAPACITY;
+	while (new_capacity < min_capacity)
+		new_capacity *= 2;
+
+	_vbo_ID = copy_to_larger_buffer(
+		_vbo_ID,
+		old_capacity * sizeof(Vertex),
+		new_capacity * sizeof(Vertex)
+	);
+	_vertex_capacity = new_capacity;
+	return_block(_free_vertices, old_capacity, new_capacity - old_capacity);
+
+	// the VAO's attributes have to point to the new VBO.
+	_set_vertex_attributes();
+}
+
+void GeometryArena::_grow_indices(const size_t &min_capacity) {
+	size_t old_capacity = _index_capacity;
+	size_t new_capacity = old_capacity > 0 ? old_capacity : MIN_INDEX_CAPACITY;
+	while (new_capacity < min_capacity)
+		new_capacity *= 2;
+
+	_ebo_ID = copy_to_larger_buffer(
+		_ebo_ID,
+		old_capacity * sizeof(uint32_t),
+		new_capacity * sizeof(uint32_t)
+	);
+	_index_capacity = new_capacity;
+	return_block(_free_indices, old_capacity, new_capacity - old_capacity);
+
+	// the VAO has to use the new EBO.
+	GLState::bind_VAO(_vao_ID);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo_ID);
+	GLState::bind_VAO(0);
+}
+
+void GeometryArena::_set_vertex_attributes() {
+	GLState::bind_VAO(_vao_ID);
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo_ID);
+
+	// specifies how OpenGL should interpret the vertex data.
+	void* ptr = (void*)0;
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
+
+	ptr = (void*)offsetof(Vertex, uv);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
+
+	ptr = (void*)offsetof(Vertex, normal);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
+
+	#if not defined(GURU_DISABLE_TANGENT_SPACE)
+	ptr = (void*)offsetof(Vertex, tangent);
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
+
+	ptr = (void*)offsetof(Vertex, bitangent);
+	glEnableVertexAttribArray(4);
+	glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
+	#endif
+
+	ptr = (void*)offsetof(Vertex, bone_IDs);
+	glEnableVertexAttribArray(5);
+	glVertexAttribIPointer(
+		5, Settings::MAX_BONE_INFLUENCES, GL_INT, sizeof(Vertex), ptr
+	);
+
+	glEnableVertexAttribArray(6);
+	glVertexAttribPointer(
+		6,
+		Settings::MAX_BONE_INFLUENCES,
+		GL_FLOAT,
+		GL_FALSE,
+		sizeof(Vertex),
+		(void *)offsetof(Vertex, weights)
+	);
+
+	GLState::bind_VAO(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::_create_instance_buffer() {
+	_instance_capacity = MIN_INSTANCE_CAPACITY;
+	glGenBuffers(1, &_instance_vbo_ID);
+	GLState::bind_VAO(_vao_ID);
+	glBindBuffer(GL_ARRAY_BUFFER, _instance_vbo_ID);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		_instance_capacity * sizeof(glm::mat4),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+
+	// a mat4 attribute takes up four locations, one for each column,
+	// which advance once per instance instead of once per vertex.
+	for (GLuint i = 0; i < 4; ++i) {
+		GLuint location = INSTANCE_ATTRIBUTE_LOCATION + i;
+		glEnableVertexAttribArray(location);
+		glVertexAttribPointer(
+			location,
+			4,
+			GL_FLOAT,
+			GL_FALSE,
+			sizeof(glm::mat4),
+			(void *)(i * sizeof(glm::vec4))
+		);
+		glVertexAttribDivisor(location, 1);
+	}
+
+	// each instance's animation time is read by shaders
+	// that play baked animations and ignored by the rest.
+	_instance_time_capacity = MIN_INSTANCE_CAPACITY;
+	glGenBuffers(1, &_instance_time_vbo_ID);
+	glBindBuffer(GL_ARRAY_BUFFER, _instance_time_vbo_ID);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		_instance_time_capacity * sizeof(float),
+		nullptr,
+		GL_STREAM_DRAW
+	);
+	glEnableVertexAttribArray(INSTANCE_TIME_ATTRIBUTE_LOCATION);
+	glVertexAttribPointer(
+		INSTANCE_TIME_ATTRIBUTE_LOCATION,
+		1,
+		GL_FLOAT,
+		GL_FALSE,
+		sizeof(float),
+		(void *)0
+	);
+	glVertexAttribDivisor(INSTANCE_TIME_ATTRIBUTE_LOCATION, 1);
+
+	GLState::bind_VAO(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+} // namespace res
+} // namespace gu
\ No newline at end of file
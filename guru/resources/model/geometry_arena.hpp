@@ -0,0 +1,138 @@
+/**
+ * geometry_arena.hpp
+ * ---
+ * this file defines the GeometryArena class, which holds the geometry
+ * of every Mesh in one vertex buffer and one index buffer
+ * that are described by a single VAO.
+ * each Mesh is given a range of the buffers by a sub-allocator
+ * and is drawn with glDrawElementsBaseVertex(...),
+ * so drawing many Meshes doesn't need a VAO bind per Mesh.
+ *
+ * ---
+ * Guru has one Vertex layout (set at compile time),
+ * so there is one GeometryArena for it.
+ * the buffers grow when they're full by copying their contents
+ * to larger buffers on the videocard with glCopyBufferSubData(...).
+ *
+ * ---
+ * the VAO also has an instance buffer of model matrices,
+ * which instanced shaders read as the per-instance attribute
+ * "layout (location = 7) in mat4 attr_model_mat",
+ * and a buffer of animation times, which shaders that play
+ * baked animations read as "layout (location = 11) in float attr_anim_time".
+ *
+ */
+
+#pragma once
+#include <map>
+#include <stdint.h>
+#include <glad/gl.h>
+#include <glm/mat4x4.hpp>
+#include "vertex.hpp"
+
+namespace gu {
+namespace res {
+class GeometryArena {
+public:
+	static GeometryArena geometry_arena;
+	static const GLuint INSTANCE_ATTRIBUTE_LOCATION = 7; // uses 7 to 10
+	static const GLuint INSTANCE_TIME_ATTRIBUTE_LOCATION = 11;
+
+	/**
+	 * GeometryArena::Range
+	 * ---
+	 * this struct describes where the geometry of one Mesh
+	 * is placed inside of the GeometryArena's buffers.
+	 *
+	 */
+	struct Range {
+		size_t base_vertex = 0; // added to every index when drawn
+		size_t n_vertices = 0;
+		size_t first_index = 0;
+		size_t n_indices = 0;
+	};
+
+private:
+	static constexpr size_t MIN_VERTEX_CAPACITY = 1 << 15;
+	static constexpr size_t MIN_INDEX_CAPACITY = 1 << 17;
+	static constexpr size_t MIN_INSTANCE_CAPACITY = 1 << 10;
+	GLuint _vao_ID = 0; // vertex array object
+	GLuint _vbo_ID = 0; // vertex buffer object
+	GLuint _ebo_ID = 0; // element buffer object
+	size_t _vertex_capacity = 0; // number of Vertices the VBO holds
+	size_t _index_capacity = 0; // number of indices the EBO holds
+	GLuint _instance_vbo_ID = 0; // per-instance model matrices
+	size_t _instance_capacity = 0; // number of matrices the instance VBO holds
+	GLuint _instance_time_vbo_ID = 0; // per-instance animation times
+	size_t _instance_time_capacity = 0; // number of times the time VBO holds
+
+	// these map the offset of each free block to its number of elements.
+	std::map<size_t, size_t> _free_vertices;
+	std::map<size_t, size_t> _free_indices;
+
+	// no other instances of this class can be created.
+	inline GeometryArena() {}
+
+public:
+	// dtor. deletes the buffers if they still exist.
+	~GeometryArena();
+
+	// deletes the VAO, VBO, and EBO.
+	// every Range that was given out is no longer valid afterwards.
+	void deallocate();
+
+	// returns the Range that the given <vertices> and <indices>
+	// were copied to on the videocard.
+	Range allocate(
+		const Vertex *vertices,
+		const size_t &n_vertices,
+		const uint32_t *indices,
+		const size_t &n_indices
+	);
+
+	// returns the given <range> to the GeometryArena to be reused.
+	void free(const Range &range);
+
+	// binds the GeometryArena's VAO so that Meshes can be drawn.
+	void bind() const;
+
+	// sends the given <n> <model_mats> to the instance buffer
+	// for the next instanced draw calls.
+	// the buffer's previous contents are orphaned first
+	// so that the videocard doesn't have to finish using them.
+	void set_instances(const glm::mat4 *model_mats, const size_t &n);
+
+	// sends the given <n> <anim_times> (seconds) to the instance time buffer
+	// for the next instanced draw calls, orphaning it the same way.
+	void set_instance_times(const float *anim_times, const size_t &n);
+
+	// returns the OpenGL ID of the GeometryArena's VAO.
+	inline GLuint get_VAO_ID() const { return _vao_ID; }
+
+	// returns the number of Vertices the vertex buffer can hold.
+	inline size_t get_vertex_capacity() const { return _vertex_capacity; }
+
+	// returns the number of indices the index buffer can hold.
+	inline size_t get_index_capacity() const { return _index_capacity; }
+
+private:
+	// creates the VAO, VBO, and EBO with their minimum capacities.
+	void _create();
+
+	// replaces the VBO with one that holds at least <min_capacity> Vertices,
+	// copying the previous contents over on the videocard.
+	void _grow_vertices(const size_t &min_capacity);
+
+	// replaces the EBO with one that holds at least <min_capacity> indices,
+	// copying the previous contents over on the videocard.
+	void _grow_indices(const size_t &min_capacity);
+
+	// specifies how OpenGL should interpret the data in the VBO.
+	void _set_vertex_attributes();
+
+	// creates the instance buffers and specifies
+	// their model matrices and times as per-instance attributes.
+	void _create_instance_buffer();
+};
+} // namespace res
+} // namespace gu
\ No newline at end of file
@@ -4,12 +4,13 @@
 #include "../material/material_list.hpp"
 
 static auto &material_list = gu::res::MaterialList::material_list;
+static auto &geometry_arena = gu::res::GeometryArena::geometry_arena;
 
 // loads rigging information like bone IDs and weights to the given
 // <name_to_rig_info> and <vertices>.
 static void load_rigging_information(
 	std::map<std::string, gu::Mesh::RigInfo> &name_to_rig_info,
-	std::vector<Vertex> &vertices,
+	std::vector<gu::Vertex> &vertices,
 	aiMesh *ai_mesh,
 	const aiScene *scene
 ) {
@@ -47,11 +48,12 @@ static void load_rigging_information(
 namespace gu {
 // static function which loads the data contained in <ai_mesh>
 // to the given <vertices> and <indices> vectors,
-// and it sets the given <material> shared pointer by reference.
+// and sets the given <bounds> to enclose the vertices.
 static void load_mesh(
 	std::map<std::string, Mesh::RigInfo> &rig_info_map,
 	std::vector<Vertex> &vertices,
 	std::vector<uint32_t> &indices,
+	Bounds &bounds,
 	aiMesh *ai_mesh,
 	const aiScene *scene,
 	const std::filesystem::path &model_directory
@@ -84,12 +86,21 @@ static void load_mesh(
 		for (uint32_t j = 0; j < face.mNumIndices; ++j)
 			indices.push_back(face.mIndices[j]);
 	}
+
+	bounds = Mesh::calc_bounds(vertices.data(), vertices.size());
 }
 
 Mesh::~Mesh() {
-	glDeleteVertexArrays(1, &_vao_ID);
-	glDeleteBuffers(1, &_vbo_ID);
-	glDeleteBuffers(1, &_ebo_ID);
+	geometry_arena.free(_range);
+}
+
+Bounds Mesh::calc_bounds(const Vertex *vertices, const size_t &n_vertices) {
+	Bounds bounds;
+	for (size_t i = 0; i < n_vertices; ++i)
+		bounds.expand(vertices[i].position);
+	if (n_vertices > 0)
+		bounds.fit_sphere(&vertices[0].position, n_vertices, sizeof(Vertex));
+	return bounds;
 }
 
 void Mesh::load(
@@ -99,86 +110,87 @@ void Mesh::load(
 	const std::filesystem::path &model_directory,
 	const size_t &material_index
 ) {
-	_name = ai_mesh->mName.C_Str();
 	std::vector<Vertex> vertices;
 	std::vector<uint32_t> indices;
+	Bounds bounds;
 	load_mesh(
 		rig_info_map,
 		vertices,
 		indices,
+		bounds,
 		ai_mesh,
 		scene,
 		model_directory
 	);
-	_n_indices = static_cast<GLsizei>(indices.size());
+	load(
+		ai_mesh->mName.C_Str(),
+		material_index,
+		vertices.data(),
+		vertices.size(),
+		indices.data(),
+		indices.size(),
+		&bounds
+	);
+}
+
+void Mesh::load(
+	const std::string &name,
+	const size_t &material_index,
+	const Vertex *vertices,
+	const size_t &n_vertices,
+	const uint32_t *indices,
+	const size_t &n_indices,
+	const Bounds *bounds
+) {
+	_name = name;
 	_material_index = material_index;
-	_send_to_videocard(vertices, indices);
+	_bounds = bounds ? *bounds : calc_bounds(vertices, n_vertices);
+	_send_to_videocard(vertices, n_vertices, indices, n_indices);
 }
 
-void Mesh::_send_to_videocard(
-	const std::vector<Vertex> &vertices,
-	const std::vector<uint32_t> &indices
+void Mesh::convert(
+	std::map<std::string, Mesh::RigInfo> &rig_info_map,
+	std::vector<Vertex> &vertices,
+	std::vector<uint32_t> &indices,
+	Bounds &bounds,
+	aiMesh *ai_mesh,
+	const aiScene *scene
 ) {
-	glGenVertexArrays(1, &_vao_ID);
-	glGenBuffers(1, &_vbo_ID);
-	glGenBuffers(1, &_ebo_ID);
-	glBindVertexArray(_vao_ID);
-
-	glBindBuffer(GL_ARRAY_BUFFER, _vbo_ID);
-	GLsizeiptr verts_size = vertices.size() * sizeof(Vertex);
-	glBufferData(GL_ARRAY_BUFFER, verts_size, &vertices[0], GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo_ID);
-	GLsizeiptr inds_size = _n_indices * sizeof(uint32_t);
-	glBufferData(
-		GL_ELEMENT_ARRAY_BUFFER, inds_size, &indices[0], GL_STATIC_DRAW
-	);
+	vertices.reserve(ai_mesh->mNumVertices);
+	indices.reserve(ai_mesh->mNumFaces * 3);
+	load_mesh(rig_info_map, vertices, indices, bounds, ai_mesh, scene, "");
+}
 
-	// specifies how OpenGL should interpret the vertex data.
-	void* ptr = (void*)0;
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
-
-	ptr = (void*)offsetof(Vertex, uv);
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
-
-	ptr = (void*)offsetof(Vertex, normal);
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
-
-	#if not defined(GURU_DISABLE_TANGENT_SPACE)
-	ptr = (void*)offsetof(Vertex, tangent);
-	glEnableVertexAttribArray(3);
-	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
-
-	ptr = (void*)offsetof(Vertex, bitangent);
-	glEnableVertexAttribArray(4);
-	glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), ptr);
-	#endif
-
-	ptr = (void*)offsetof(Vertex, bone_IDs);
-	glEnableVertexAttribArray(5);
-	glVertexAttribIPointer(
-		5, Settings::MAX_BONE_INFLUENCES, GL_INT, sizeof(Vertex), ptr
-	);
+void Mesh::_send_to_videocard(
+	const Vertex *vertices,
+	const size_t &n_vertices,
+	const uint32_t *indices,
+	const size_t &n_indices
+) {
+	geometry_arena.free(_range);
+	_range = geometry_arena.allocate(vertices, n_vertices, indices, n_indices);
+}
 
-	glEnableVertexAttribArray(6);
-	glVertexAttribPointer(
-		6,
-		Settings::MAX_BONE_INFLUENCES,
-		GL_FLOAT,
-		GL_FALSE,
-		sizeof(Vertex),
-		(void *)offsetof(Vertex, weights)
+void Mesh::draw() const {
+	void *first_index = (void *)(_range.first_index * sizeof(uint32_t));
+	glDrawElementsBaseVertex(
+		GL_TRIANGLES,
+		static_cast<GLsizei>(_range.n_indices),
+		GL_UNSIGNED_INT,
+		first_index,
+		static_cast<GLint>(_range.base_vertex)
 	);
-
-	glBindVertexArray(0);
 }
 
-void Mesh::draw() const {
-	glBindVertexArray(_vao_ID);
-	glDrawElements(GL_TRIANGLES, _n_indices, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
+void Mesh::draw_instanced(const GLsizei &n_instances) const {
+	void *first_index = (void *)(_range.first_index * sizeof(uint32_t));
+	glDrawElementsInstancedBaseVertex(
+		GL_TRIANGLES,
+		static_cast<GLsizei>(_range.n_indices),
+		GL_UNSIGNED_INT,
+		first_index,
+		n_instances,
+		static_cast<GLint>(_range.base_vertex)
+	);
 }
 } // namespace gu
\ No newline at end of file
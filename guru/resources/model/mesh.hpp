@@ -1,10 +1,12 @@
 /**
  * mesh.hpp
  * ---
- * this file defines the Vertex struct and Mesh class,
+ * this file defines the Mesh class,
  * with a Mesh being a unit of a Model,
- * which is composed of vertices, indices, and
- * a shared pointer to a Material.
+ * which is composed of a range of vertices and indices
+ * in the GeometryArena and the index of a Material.
+ * each Mesh keeps the Bounds of its vertices in model space,
+ * which are of the bind pose for rigged Meshes.
  *
  */
 
@@ -13,59 +15,18 @@
 #include <stdint.h>
 #include <vector>
 #include <glm/ext/matrix_float4x4.hpp>
-#include <glm/vec2.hpp>
-#include <glm/vec3.hpp>
 #include <assimp/scene.h>
-#include "../../system/settings.hpp"
+#include "geometry_arena.hpp"
+#include "vertex.hpp"
 #include "../material/material.hpp"
-
-namespace {
-/**
- * Vertex
- * ---
- * this local struct is used to buffer geometric information
- * from a file to the video card.
- *
- */
-struct Vertex {
-	glm::vec3 position = glm::vec3(0.0f);
-	glm::vec2 uv = glm::vec2(0.0f);
-	glm::vec3 normal = glm::vec3(0.0f);
-	#if not defined(GURU_DISABLE_TANGENT_SPACE)
-	glm::vec3 tangent = glm::vec3(0.0f);
-	glm::vec3 bitangent = glm::vec3(0.0f);
-	#endif
-	int bone_IDs[gu::Settings::MAX_BONE_INFLUENCES];
-	float weights[gu::Settings::MAX_BONE_INFLUENCES];
-
-	inline Vertex() { set_bone_data_to_default(); }
-
-	// sets all rigging information in the Vertex to not be used.
-	void set_bone_data_to_default() {
-		for (uint8_t i = 0; i < gu::Settings::MAX_BONE_INFLUENCES; ++i) {
-			bone_IDs[i] = -1;
-			weights[i] = 0.0f;
-		}
-	}
-
-	// sets the next empty rigging information elements of <bone_IDs> and <weights>
-	// to the given <bone_ID> and <weight>.
-	void set_bone_data(int bone_ID, const float &weight) {
-		for (uint8_t i = 0; i < gu::Settings::MAX_BONE_INFLUENCES; ++i) {
-			if (bone_IDs[i] == -1) {
-				// a bone ID is not yet set for this influence.
-				bone_IDs[i] = bone_ID;
-				weights[i] = weight;
-				break;
-			}
-		}
-	}
-};
-} // blank namespace
+#include "../../mathmatics/bounds.hpp"
 
 namespace gu {
 class Mesh {
 public:
+	// the Material index of a Mesh that wasn't given a Material.
+	static constexpr size_t NO_MATERIAL = SIZE_MAX;
+
 	/**
 	* Mesh::RigInfo
 	* ---
@@ -110,26 +71,38 @@ public:
 private:
 	std::string _name = "";
 	size_t _material_index = 0;
-	GLuint _vao_ID = 0; // vertex array object
-	GLuint _vbo_ID = 0; // vertex buffer object
-	GLuint _ebo_ID = 0; // element buffer object
-	GLsizei _n_indices = 0; // number of indices.
+	res::GeometryArena::Range _range; // geometry in the GeometryArena
+	Bounds _bounds; // model space
 
 public:
-	// dtor. deletes the allocated VAO, VBO, and EBO.
+	// dtor. frees the Mesh's range of the GeometryArena.
 	~Mesh();
 
 	// returns the name of the Mesh that was provided upon loading.
 	inline const std::string &get_name() const { return _name; }
 
 	// returns the index of the used Material shared pointer
-	// in the ModelResource instance which contains this Mesh.
+	// in the ModelResource instance which contains this Mesh,
+	// or NO_MATERIAL if the Mesh doesn't have one.
 	inline const size_t &get_material_index() const { return _material_index; }
 
+	// returns the Mesh's range of vertices and indices in the GeometryArena.
+	inline const res::GeometryArena::Range &get_range() const { return _range; }
+
+	// returns the Bounds of the Mesh's vertices in model space.
+	inline const Bounds &get_bounds() const { return _bounds; }
+
+	// grows the Mesh's Bounds by the <margin> in every direction,
+	// which can keep an animated Mesh from being culled
+	// when it moves outside of its bind pose.
+	inline void pad_bounds(const float &margin) { _bounds.pad(margin); }
+
+	// returns the Bounds of the given <n_vertices> <vertices>.
+	static Bounds calc_bounds(const Vertex *vertices, const size_t &n_vertices);
+
 	// loads the bone information into the given map,
 	// loads the vertices and indices into local vectors from the given aiMesh,
-	// then creates the VAO, VBO, and EBO,
-	// and finally sends the data to the videocard.
+	// and then sends the data to the GeometryArena on the videocard.
 	void load(
 		std::map<std::string, Mesh::RigInfo> &rig_info_map,
 		aiMesh *ai_mesh,
@@ -138,16 +111,51 @@ public:
 		const size_t &material_index
 	);
 
+	// sets the Mesh's name and Material index,
+	// then sends the given <vertices> and <indices>
+	// directly to the GeometryArena on the videocard.
+	// the Mesh's Bounds are calculated from the <vertices>
+	// unless already calculated <bounds> are given.
+	void load(
+		const std::string &name,
+		const size_t &material_index,
+		const Vertex *vertices,
+		const size_t &n_vertices,
+		const uint32_t *indices,
+		const size_t &n_indices,
+		const Bounds *bounds = nullptr
+	);
+
+	// loads the bone information into the given map and
+	// loads the vertices, indices and Bounds of the given aiMesh
+	// into the given containers. no OpenGL calls are made.
+	static void convert(
+		std::map<std::string, Mesh::RigInfo> &rig_info_map,
+		std::vector<Vertex> &vertices,
+		std::vector<uint32_t> &indices,
+		Bounds &bounds,
+		aiMesh *ai_mesh,
+		const aiScene *scene
+	);
+
 private:
-	// sets the Mesh's VAO, VBO, and EBO by
-	// sending the given <vertices> and <indices> vectors to the videocard.
+	// sets the Mesh's range of the GeometryArena by
+	// sending the given <vertices> and <indices> to the videocard.
 	void _send_to_videocard(
-		const std::vector<Vertex>& vertices,
-		const std::vector<uint32_t>& indices
+		const Vertex *vertices,
+		const size_t &n_vertices,
+		const uint32_t *indices,
+		const size_t &n_indices
 	);
 
 public:
-	// binds and draws the Mesh's geometry with OpenGL.
+	// draws the Mesh's geometry with OpenGL.
+	// the GeometryArena must already be bound.
 	void draw() const;
+
+	// draws <n_instances> of the Mesh's geometry with one OpenGL call,
+	// using the model matrices in the GeometryArena's instance buffer.
+	// the GeometryArena must already be bound.
+	void draw_instanced(const GLsizei &n_instances) const;
 };
 } // namespace gu
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "model_cache.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const char MAGIC[4] = {'G', 'U', 'M', 'C'};
+static const size_t GEOMETRY_ALIGNMENT = 16; // bytes
+static const uint32_t FLAG_TANGENT_SPACE = 1 << 0;
+static const uint64_t NO_MATERIAL = UINT64_MAX; // stands for Mesh::NO_MATERIAL
+
+namespace {
+// this local struct is written at the very beginning of a cache file.
+struct CacheHeader {
+	char magic[4] = {0, 0, 0, 0};
+	uint32_t version = 0;
+	uint32_t vertex_size = 0; // sizeof(Vertex)
+	uint32_t max_bone_influences = 0;
+	uint32_t flags = 0; // compile options that change the Vertex layout
+	uint32_t n_materials = 0;
+	uint32_t n_rig_infos = 0;
+	uint32_t n_meshes = 0;
+	int64_t source_write_time = 0; // of the 3D model file
+	uint64_t source_size = 0; // of the 3D model file
+};
+
+// this local struct reads values sequentially from a mapped cache file.
+// every read returns false instead of reading past the end of the file.
+struct CacheReader {
+	const char *data = nullptr;
+	size_t size = 0;
+	size_t offset = 0;
+
+	bool read(void *dst, const size_t &n_bytes) {
+		if (n_bytes > size - offset)
+			return false;
+		std::memcpy(dst, data + offset, n_bytes);
+		offset += n_bytes;
+		return true;
+	}
+
+	template <typename T>
+	bool read(T &value) { return read(&value, sizeof(T)); }
+
+	bool read_bounds(gu::Bounds &bounds) {
+		return (
+			    read(&bounds.min[0], sizeof(float) * 3)
+			and read(&bounds.max[0], sizeof(float) * 3)
+			and read(&bounds.center[0], sizeof(float) * 3)
+			and read(bounds.radius)
+		);
+	}
+
+	bool read_string(std::string &str) {
+		uint32_t length = 0;
+		if (not read(length) or length > size - offset)
+			return false;
+		str.assign(data + offset, length);
+		offset += length;
+		return true;
+	}
+
+	// returns a pointer to <n_bytes> in the mapped file
+	// that begin at the next multiple of the GEOMETRY_ALIGNMENT.
+	const char *take_aligned(const size_t &n_bytes) {
+		size_t start = (
+			(offset + GEOMETRY_ALIGNMENT - 1) / GEOMETRY_ALIGNMENT
+		) * GEOMETRY_ALIGNMENT;
+		if (start > size or n_bytes > size - start)
+			return nullptr;
+		offset = start + n_bytes;
+		return data + start;
+	}
+};
+
+// this local struct appends values to a buffer that becomes a cache file.
+struct CacheWriter {
+	std::vector<char> buffer;
+
+	void write(const void *src, const size_t &n_bytes) {
+		const char *bytes = static_cast<const char *>(src);
+		buffer.insert(buffer.end(), bytes, bytes + n_bytes);
+	}
+
+	template <typename T>
+	void write(const T &value) { write(&value, sizeof(T)); }
+
+	void write_bounds(const gu::Bounds &bounds) {
+		write(&bounds.min[0], sizeof(float) * 3);
+		write(&bounds.max[0], sizeof(float) * 3);
+		write(&bounds.center[0], sizeof(float) * 3);
+		write(bounds.radius);
+	}
+
+	void write_string(const std::string &str) {
+		write(static_cast<uint32_t>(str.size()));
+		write(str.data(), str.size());
+	}
+
+	// pads the buffer to the next multiple of the GEOMETRY_ALIGNMENT
+	// and then appends the given <n_bytes>.
+	void write_aligned(const void *src, const size_t &n_bytes) {
+		size_t start = (
+			(buffer.size() + GEOMETRY_ALIGNMENT - 1) / GEOMETRY_ALIGNMENT
+		) * GEOMETRY_ALIGNMENT;
+		buffer.resize(start, 0);
+		write(src, n_bytes);
+	}
+};
+} // blank namespace
+
+// returns the flags of the compile options that change the Vertex layout.
+static uint32_t get_layout_flags() {
+	uint32_t flags = 0;
+	#if not defined(GURU_DISABLE_TANGENT_SPACE)
+	flags |= FLAG_TANGENT_SPACE;
+	#endif
+	return flags;
+}
+
+// sets the write time and size of the file at <path> by reference.
+// returns false if the file couldn't be inspected.
+static bool get_source_stamp(
+	const std::filesystem::path &path, int64_t &write_time, uint64_t &size
+) {
+	std::error_code error;
+	auto time = std::filesystem::last_write_time(path, error);
+	if (error)
+		return false;
+	size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+	if (error)
+		return false;
+	write_time = static_cast<int64_t>(time.time_since_epoch().count());
+	return true;
+}
+
+namespace gu {
+namespace res {
+std::filesystem::path ModelCache::get_cache_path(
+	const std::filesystem::path &model_path
+) {
+	std::filesystem::path cache_path = model_path;
+	cache_path += ".gucache";
+	return cache_path;
+}
+
+bool ModelCache::open(const std::filesystem::path &model_path) {
+	close();
+	int64_t write_time = 0;
+	uint64_t source_size = 0;
+	if (not get_source_stamp(model_path, write_time, source_size))
+		return false;
+	if (not _file.open(get_cache_path(model_path)))
+		return false;
+
+	// determines if the cache file matches
+	// the 3D model file and this build of Guru.
+	CacheReader reader;
+	reader.data = _file.get_data();
+	reader.size = _file.get_size();
+	CacheHeader header;
+	if (
+		not reader.read(header)
+		or std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+		or header.version != VERSION
+		or header.vertex_size != sizeof(Vertex)
+		or header.max_bone_influences != Settings::MAX_BONE_INFLUENCES
+		or header.flags != get_layout_flags()
+		or header.source_write_time != write_time
+		or header.source_size != source_size
+	) {
+		close();
+		return false;
+	}
+
+	// reads the image paths of each Material.
+	_material_paths.resize(header.n_materials);
+	for (auto &paths : _material_paths) {
+		for (auto &path : paths) {
+			std::string path_str;
+			if (not reader.read_string(path_str)) {
+				close();
+				return false;
+			}
+			path = path_str;
+		}
+	}
+
+	// reads the rigging information.
+	for (uint32_t i = 0; i < header.n_rig_infos; ++i) {
+		std::string name;
+		Mesh::RigInfo info;
+		int32_t bone_ID = -1;
+		if (
+			not reader.read_string(name)
+			or not reader.read(bone_ID)
+			or not reader.read(&info.local_space_to_bone[0][0], sizeof(float) * 16)
+		) {
+			close();
+			return false;
+		}
+		info.bone_ID = bone_ID;
+		_name_to_rig_info[name] = info;
+	}
+
+	// points each MeshView to its geometry inside of the mapped file.
+	_meshes.resize(header.n_meshes);
+	for (auto &mesh : _meshes) {
+		uint64_t material_index = 0, n_vertices = 0, n_indices = 0;
+		if (
+			not reader.read_string(mesh.name)
+			or not reader.read(material_index)
+			or not reader.read(n_vertices)
+			or not reader.read(n_indices)
+			or not reader.read_bounds(mesh.bounds)
+			or (
+				    material_index != NO_MATERIAL
+				and material_index >= header.n_materials
+			)
+			or n_vertices > reader.size / sizeof(Vertex)
+			or n_indices > reader.size / sizeof(uint32_t)
+		) {
+			close();
+			return false;
+		}
+		mesh.material_index = (
+			material_index == NO_MATERIAL
+			? Mesh::NO_MATERIAL : static_cast<size_t>(material_index)
+		);
+		mesh.n_vertices = static_cast<size_t>(n_vertices);
+		mesh.n_indices = static_cast<size_t>(n_indices);
+		mesh.vertices = reinterpret_cast<const Vertex *>(
+			reader.take_aligned(mesh.n_vertices * sizeof(Vertex))
+		);
+		mesh.indices = reinterpret_cast<const uint32_t *>(
+			reader.take_aligned(mesh.n_indices * sizeof(uint32_t))
+		);
+		if (not mesh.vertices or not mesh.indices) {
+			close();
+			return false;
+		}
+	}
+	return true;
+}
+
+void ModelCache::close() {
+	_file.close();
+	std::vector<Material::MapPaths>().swap(_material_paths);
+	_name_to_rig_info.clear();
+	std::vector<MeshView>().swap(_meshes);
+}
+
+bool ModelCache::write(
+	const std::filesystem::path &model_path,
+	const std::vector<Material::MapPaths> &material_paths,
+	const std::map<std::string, Mesh::RigInfo> &name_to_rig_info,
+	const std::vector<MeshData> &meshes
+) {
+	CacheHeader header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.vertex_size = sizeof(Vertex);
+	header.max_bone_influences = Settings::MAX_BONE_INFLUENCES;
+	header.flags = get_layout_flags();
+	header.n_materials = static_cast<uint32_t>(material_paths.size());
+	header.n_rig_infos = static_cast<uint32_t>(name_to_rig_info.size());
+	header.n_meshes = static_cast<uint32_t>(meshes.size());
+	if (
+		not get_source_stamp(
+			model_path, header.source_write_time, header.source_size
+		)
+	)
+		return false;
+
+	// lays out the cache file in memory.
+	CacheWriter writer;
+	writer.write(header);
+	for (const auto &paths : material_paths)
+		for (const auto &path : paths)
+			writer.write_string(path.string());
+
+	for (const auto &pair : name_to_rig_info) {
+		writer.write_string(pair.first);
+		writer.write(static_cast<int32_t>(pair.second.bone_ID));
+		writer.write(
+			&pair.second.local_space_to_bone[0][0], sizeof(float) * 16
+		);
+	}
+
+	for (const auto &mesh : meshes) {
+		writer.write_string(mesh.name);
+		writer.write(
+			mesh.material_index == Mesh::NO_MATERIAL
+			? NO_MATERIAL : static_cast<uint64_t>(mesh.material_index)
+		);
+		writer.write(static_cast<uint64_t>(mesh.vertices.size()));
+		writer.write(static_cast<uint64_t>(mesh.indices.size()));
+		writer.write_bounds(mesh.bounds);
+		writer.write_aligned(
+			mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex)
+		);
+		writer.write_aligned(
+			mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t)
+		);
+	}
+
+	// writes to a temporary file first so that a partially-written cache
+	// is never mistaken for a complete one.
+	std::filesystem::path cache_path = get_cache_path(model_path);
+	std::filesystem::path temp_path = cache_path;
+	temp_path += ".tmp";
+	{
+		std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+		if (file)
+			file.write(
+				writer.buffer.data(),
+				static_cast<std::streamsize>(writer.buffer.size())
+			);
+		if (not file) {
+			std::cerr
+				<< "The model cache " << cache_path
+				<< " could not be written." << std::endl;
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temp_path, cache_path, error);
+	if (error) {
+		std::filesystem::remove(temp_path, error);
+		std::cerr
+			<< "The model cache " << cache_path
+			<< " could not be written." << std::endl;
+		return false;
+	}
+	return true;
+}
+} // namespace res
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,112 @@
+/**
+ * model_cache.hpp
+ * ---
+ * this file defines the ModelCache class, which reads and writes
+ * a versioned binary cache file for a 3D model file.
+ * the cache holds the already-interleaved Vertices, the indices,
+ * the Bounds, the rigging information and the Material image paths
+ * of every Mesh,
+ * so that a ModelResource can skip the assimp library on warm starts.
+ *
+ * ---
+ * the cache file is placed next to the 3D model file
+ * with the extension ".gucache" appended to it.
+ * it is ignored if the 3D model file's write time or size changes,
+ * or if Guru was compiled with a different Vertex layout
+ * (e.g. GURU_DISABLE_TANGENT_SPACE or Settings::MAX_BONE_INFLUENCES).
+ * the cache can be turned off with the macro GURU_DISABLE_MODEL_CACHE.
+ *
+ */
+
+#pragma once
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "mesh.hpp"
+#include "../../system/mapped_file.hpp"
+
+namespace gu {
+namespace res {
+class ModelCache {
+public:
+	// increased whenever the layout of the cache file changes.
+	static const uint32_t VERSION = 2;
+
+	/**
+	 * ModelCache::MeshData
+	 * ---
+	 * this struct holds the geometry of a Mesh converted from assimp,
+	 * which is given to ModelCache::write(...).
+	 *
+	 */
+	struct MeshData {
+		std::string name;
+		size_t material_index = 0;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		Bounds bounds;
+	};
+
+	/**
+	 * ModelCache::MeshView
+	 * ---
+	 * this struct points to the geometry of a Mesh
+	 * inside of the memory-mapped cache file.
+	 * the pointers are only valid while the ModelCache is open.
+	 *
+	 */
+	struct MeshView {
+		std::string name;
+		size_t material_index = 0;
+		const Vertex *vertices = nullptr;
+		size_t n_vertices = 0;
+		const uint32_t *indices = nullptr;
+		size_t n_indices = 0;
+		Bounds bounds;
+	};
+
+private:
+	MappedFile _file;
+	std::vector<Material::MapPaths> _material_paths;
+	std::map<std::string, Mesh::RigInfo> _name_to_rig_info;
+	std::vector<MeshView> _meshes;
+
+public:
+	// returns the path of the cache file for the 3D model at <model_path>.
+	static std::filesystem::path get_cache_path(
+		const std::filesystem::path &model_path
+	);
+
+	// returns true if an up-to-date cache file of the 3D model
+	// at <model_path> was found and mapped into memory.
+	bool open(const std::filesystem::path &model_path);
+
+	// unmaps the cache file and clears the read contents.
+	void close();
+
+	// returns the image paths of every Material used by the 3D model.
+	inline const std::vector<Material::MapPaths> &get_material_paths() const {
+		return _material_paths;
+	}
+
+	// returns the rigging information of the 3D model.
+	inline const std::map<std::string, Mesh::RigInfo> &get_name_to_rig_info(
+	) const {
+		return _name_to_rig_info;
+	}
+
+	// returns the geometry of every Mesh in the cache file.
+	inline const std::vector<MeshView> &get_meshes() const { return _meshes; }
+
+	// returns true if a cache file for the 3D model at <model_path>
+	// was written with the given contents.
+	static bool write(
+		const std::filesystem::path &model_path,
+		const std::vector<Material::MapPaths> &material_paths,
+		const std::map<std::string, Mesh::RigInfo> &name_to_rig_info,
+		const std::vector<MeshData> &meshes
+	);
+};
+} // namespace res
+} // namespace gu
\ No newline at end of file
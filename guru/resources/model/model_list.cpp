@@ -1,5 +1,10 @@
 #include "model_list.hpp"
 #include <iostream>
+#include "../material/material_list.hpp"
+#include "../../system/gl_task_queue.hpp"
+#include "../../system/thread_pool.hpp"
+
+static auto &material_list = gu::res::MaterialList::material_list;
 
 namespace gu {
 namespace res {
@@ -17,5 +22,66 @@ std::shared_ptr<ModelResource> ModelResourceList::create_and_load(
 	add_entry(model_res);
 	return model_res;
 }
+
+std::shared_ptr<ModelResource> ModelResourceList::create_and_load_async(
+	const std::filesystem::path &model_path
+) {
+	std::shared_ptr<ModelResource> model_res = find_existing(model_path);
+	if (model_res)
+		return model_res;
+
+	model_res = std::make_shared<ModelResource>();
+	model_res->_path = model_path;
+	model_res->_loading = true;
+	add_entry(model_res);
+
+	// reads the 3D model file and decodes its images on a worker thread.
+	ThreadPool::thread_pool.submit([model_res]() {
+		auto source = std::make_shared<ModelResource::Source>();
+		if (not ModelResource::_read_source(*source, model_res->get_path())) {
+			GLTaskQueue::push([model_res]() {
+				model_res->_loading = false;
+			});
+			return;
+		}
+
+		// the images of every Material are decoded at once in parallel.
+		size_t n_materials = source->material_paths.size();
+		source->material_images.resize(n_materials);
+		std::vector<Material::Images *> requests;
+		for (size_t i = 0; i < n_materials; ++i) {
+			Material::Images &images = source->material_images[i];
+			Material::find_images(images, source->material_paths[i].data());
+			requests.push_back(&images);
+		}
+		Material::decode_images(requests);
+
+		// queues the OpenGL uploads as small tasks
+		// so that they can be spread across several frames.
+		for (size_t i = 0; i < n_materials; ++i) {
+			GLTaskQueue::push([model_res, source, i]() {
+				model_res->_add_material(
+					material_list.create_and_load(source->material_images[i]),
+					source->material_paths[i]
+				);
+			});
+		}
+
+		// the <_meshes> vector is pre-allocated to prevent Mesh dtors
+		// from being called by the vector having to reallocate itself.
+		GLTaskQueue::push([model_res, source]() {
+			model_res->_meshes.reserve(source->meshes.size());
+		});
+		for (size_t i = 0; i < source->meshes.size(); ++i) {
+			GLTaskQueue::push([model_res, source, i]() {
+				model_res->_add_mesh(source->meshes[i]);
+			});
+		}
+		GLTaskQueue::push([model_res, source]() {
+			model_res->_finish_loading(*source);
+		});
+	});
+	return model_res;
+}
 } // namespace res
 } // namespace gu
\ No newline at end of file
@@ -29,6 +29,16 @@ public:
 	std::shared_ptr<ModelResource> create_and_load(
 		const std::filesystem::path &model_path
 	);
+
+	// returns a created shared pointer entry for a new ModelResource
+	// without waiting for it to be loaded.
+	// the 3D model file is read and its images are decoded on the ThreadPool,
+	// then the OpenGL uploads are queued to the GLTaskQueue,
+	// which is run a bit every frame by env::poll_events_and_update_delta().
+	// the ModelResource isn't drawn while ModelResource::is_loading().
+	std::shared_ptr<ModelResource> create_and_load_async(
+		const std::filesystem::path &model_path
+	);
 };
 }
 }
\ No newline at end of file
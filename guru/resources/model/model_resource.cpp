@@ -4,6 +4,8 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include "../material/material_list.hpp"
+#include "../../shader/uniform_blocks.hpp"
+#include "../../system/gl_state.hpp"
 
 static auto &material_list = gu::res::MaterialList::material_list;
 
@@ -51,10 +53,63 @@ static void count_meshes(size_t &n_meshes, aiNode *node) {
 }
 
 void ModelResource::load(const std::filesystem::path &path) {
+	Source source;
+	if (not _read_source(source, path))
+		return;
+	_path = path;
+
+	// finds the images of every Material that isn't loaded yet
+	// and decodes them all at once in parallel.
+	size_t n_materials = source.material_paths.size();
+	source.material_images.resize(n_materials);
+	std::vector<Material::Images *> requests;
+	for (size_t i = 0; i < n_materials; ++i) {
+		const Material::MapPaths &paths = source.material_paths[i];
+		if (not material_list.find_existing(paths[0])) {
+			Material::find_images(source.material_images[i], paths.data());
+			requests.push_back(&source.material_images[i]);
+		}
+	}
+	Material::decode_images(requests);
+
+	for (size_t i = 0; i < n_materials; ++i) {
+		const Material::MapPaths &paths = source.material_paths[i];
+		std::shared_ptr<Material> material = (
+			material_list.find_existing(paths[0])
+		);
+		if (not material)
+			material = material_list.create_and_load(source.material_images[i]);
+		_add_material(material, paths);
+	}
+
+	// the <_meshes> vector is pre-allocated to prevent Mesh dtors
+	// from being called by the vector having to reallocate itself.
+	_meshes.reserve(source.meshes.size());
+	for (const auto &view : source.meshes)
+		_add_mesh(view);
+	_finish_loading(source);
+}
+
+bool ModelResource::_read_source(
+	Source &source, const std::filesystem::path &path
+) {
 	if (not std::filesystem::exists(path)) {
 		std::cerr << path << " could not be found." << std::endl;
-		return;
+		return false;
+	}
+	source.path = path;
+
+	#if not defined(GURU_DISABLE_MODEL_CACHE)
+	// uses the binary cache of the 3D object file if it's up to date,
+	// which skips the assimp library entirely.
+	// the geometry is then sent to the videocard straight from the mapped file.
+	if (source.cache.open(path)) {
+		source.material_paths = source.cache.get_material_paths();
+		source.name_to_rig_info = source.cache.get_name_to_rig_info();
+		source.meshes = source.cache.get_meshes();
+		return true;
 	}
+	#endif
 
 	// uses the assimp library to load the 3D object file.
 	Assimp::Importer importer;
@@ -77,20 +132,68 @@ void ModelResource::load(const std::filesystem::path &path) {
 			<< "Error with Model::load:\n"
 			<< importer.GetErrorString()
 			<< std::endl;
-		return;
+		return false;
 	}
-	_path = path;
 
-	// determines the amount of meshes that will be used.
-	// this is pre-allocated to prevent Mesh dtors from being called
-	// by the vector having to reallocate itself.
+	// converts the file's data into local vectors.
 	size_t n_meshes = 0;
 	count_meshes(n_meshes, scene->mRootNode);
-	_meshes.reserve(n_meshes);
+	source.mesh_data.reserve(n_meshes);
+	_process_node(source, scene->mRootNode, scene);
+
+	source.meshes.reserve(source.mesh_data.size());
+	for (const auto &data : source.mesh_data) {
+		res::ModelCache::MeshView view;
+		view.name = data.name;
+		view.material_index = data.material_index;
+		view.vertices = data.vertices.data();
+		view.n_vertices = data.vertices.size();
+		view.indices = data.indices.data();
+		view.n_indices = data.indices.size();
+		view.bounds = data.bounds;
+		source.meshes.push_back(view);
+	}
+
+	#if not defined(GURU_DISABLE_MODEL_CACHE)
+	res::ModelCache::write(
+		path, source.material_paths, source.name_to_rig_info, source.mesh_data
+	);
+	#endif
+	return true;
+}
 
-	// fills the pre-allocated <_meshes> vector with the file's data.
-	n_meshes = 0;
-	_process_node(n_meshes, scene->mRootNode, scene);
+void ModelResource::_add_material(
+	const std::shared_ptr<Material> &material,
+	const Material::MapPaths &paths
+) {
+	_materials.push_back(material);
+	_material_paths.push_back(paths);
+}
+
+void ModelResource::_add_mesh(const res::ModelCache::MeshView &view) {
+	size_t mesh_index = _meshes.size();
+	_meshes.emplace_back();
+	_meshes[mesh_index].load(
+		view.name,
+		view.material_index,
+		view.vertices,
+		view.n_vertices,
+		view.indices,
+		view.n_indices,
+		&view.bounds
+	);
+	_bounds.merge(_meshes[mesh_index].get_bounds());
+	const std::shared_ptr<Material> &material = get_material(
+		view.material_index
+	);
+	if (not material or not material->is_transparent())
+		_transparent_mesh_indices.push_back(mesh_index);
+	else
+		_opaque_mesh_indices.push_back(mesh_index);
+}
+
+void ModelResource::_finish_loading(Source &source) {
+	_name_to_rig_info = std::move(source.name_to_rig_info);
 	for (const auto &material : _materials) {
 		for (uint8_t j = 1; j < Material::N_MAP_TYPES; ++j) {
 			if (material->uses_map(j)) {
@@ -99,54 +202,48 @@ void ModelResource::load(const std::filesystem::path &path) {
 			}
 		}
 	}
+	_loading = false;
 }
 
-// returns the index of the Material in the given <materials> vector
+// returns the index of the Material in the given <material_paths> vector
 // whose diffuse texture path matches the given <diffuse_path>.
 static size_t find_material_index(
 	const std::filesystem::path &diffuse_path,
-	const std::vector<std::shared_ptr<Material>> &materials
+	const std::vector<Material::MapPaths> &material_paths
 ) {
-	size_t i = materials.size();
-	for (i = 0; i < materials.size(); ++i)
-		if (materials[i]->get_path() == diffuse_path)
+	size_t i = material_paths.size();
+	for (i = 0; i < material_paths.size(); ++i)
+		if (material_paths[i][0] == diffuse_path)
 			break;
 	return i;
 }
 
-// returns the index of the given <materials> vector that indicates
-// which Material shared pointer for the Mesh to use for drawing.
-static size_t load_material(
-	std::vector<std::shared_ptr<Material>> &materials,
+// returns the index of the given <material_paths> vector that indicates
+// which Material for the Mesh to use for drawing.
+// the image paths of a newly used Material are pushed to <material_paths>.
+// no Materials are loaded, so this can be run on any thread.
+static size_t find_material(
+	std::vector<Material::MapPaths> &material_paths,
 	const aiMaterial *const ai_material,
 	const std::filesystem::path &model_directory
 ) {
 	if (ai_material->GetTextureCount(aiTextureType_DIFFUSE) == 0)
-		return materials.size();
+		return Mesh::NO_MATERIAL;
 
 	// gets the diffuse image path.
 	aiString ai_diffuse;
 	ai_material->GetTexture(aiTextureType_DIFFUSE, 0, &ai_diffuse);
 	std::filesystem::path diffuse_path = model_directory / ai_diffuse.C_Str();
 
-	// determines if this Material already exists in the ModelResource's <_materials>.
-	size_t existing_mat_index = find_material_index(diffuse_path, materials);
-	if (existing_mat_index < materials.size())
-		return existing_mat_index;
-
-	// determines if this Material has already been loaded
-	// based off the diffuse texture path. 
-	// if so, a shared pointer to the existing one is used.
-	std::shared_ptr<Material> existing_material = (
-		material_list.find_existing(diffuse_path)
+	// determines if this Material is already used by the 3D model.
+	size_t existing_mat_index = find_material_index(
+		diffuse_path, material_paths
 	);
-	if (existing_material) {
-		materials.push_back(existing_material);
-		return materials.size() - 1;
-	}
+	if (existing_mat_index < material_paths.size())
+		return existing_mat_index;
 
 	// gets local image paths for each kind of map from the loaded aiMaterial.
-	std::filesystem::path paths[Material::N_MAP_TYPES];
+	Material::MapPaths paths;
 	paths[0] = diffuse_path;
 	aiString ai_image_names[Material::N_MAP_TYPES];
 
@@ -195,41 +292,44 @@ static size_t load_material(
 		if (ai_image_names[i].length > 0)
 			paths[i] = model_directory / ai_image_names[i].C_Str();
 	}
-
-	// loads the Material's textures.
-	materials.push_back(material_list.create_and_load(paths));
-	return materials.size() - 1;
+	material_paths.push_back(paths);
+	return material_paths.size() - 1;
 }
 
-void ModelResource::_process_node(size_t &n_meshes, aiNode *node, const aiScene *scene) {
-	std::filesystem::path dir = _path.parent_path();
+void ModelResource::_process_node(
+	Source &source, aiNode *node, const aiScene *scene
+) {
+	std::filesystem::path dir = source.path.parent_path();
 
-	// loads the contained meshes to the <_meshes> vector.
+	// converts the contained meshes into the source's <mesh_data>.
 	for (uint32_t i = 0; i < node->mNumMeshes; ++i) {
 		aiMesh *const ai_mesh = scene->mMeshes[node->mMeshes[i]];
-		aiMaterial *const ai_mat = scene->mMaterials[ai_mesh->mMaterialIndex];
 
-		// loads material.
-		size_t mat_index = load_material(
-			_materials,
+		// finds material.
+		size_t mat_index = find_material(
+			source.material_paths,
 			scene->mMaterials[ai_mesh->mMaterialIndex],
 			dir
 		);
 
-		// loads the Mesh's geometry and gives it its <_material_index>,
-		// then the Mesh's index is organized.
-		_meshes.emplace_back();
-		_meshes[n_meshes].load(_name_to_rig_info, ai_mesh, scene, dir, mat_index);
-		if (not _materials[mat_index]->is_transparent())
-			_transparent_mesh_indices.push_back(n_meshes);
-		else
-			_opaque_mesh_indices.push_back(n_meshes);
-		++n_meshes;
+		// converts the Mesh's geometry and gives it its material index.
+		source.mesh_data.emplace_back();
+		res::ModelCache::MeshData &data = source.mesh_data.back();
+		data.name = ai_mesh->mName.C_Str();
+		data.material_index = mat_index;
+		Mesh::convert(
+			source.name_to_rig_info,
+			data.vertices,
+			data.indices,
+			data.bounds,
+			ai_mesh,
+			scene
+		);
 	}
 
 	// runs this method by recursion on any children nodes.
 	for (uint32_t i = 0; i < node->mNumChildren; ++i)
-		_process_node(n_meshes, node->mChildren[i], scene);
+		_process_node(source, node->mChildren[i], scene);
 }
 
 void ModelResource::find_mesh_indices_by_name(
@@ -247,6 +347,8 @@ void ModelResource::find_mesh_indices_by_path(
 ) const {
 	for (size_t i = 0; i < _meshes.size(); ++i) {
 		const size_t &mat_index = _meshes[i].get_material_index();
+		if (mat_index == Mesh::NO_MATERIAL)
+			continue;
 		const auto &mat_path = _materials[mat_index]->get_path();
 		std::string local_path = (
 			mat_path.stem().string() + mat_path.extension().string()
@@ -261,8 +363,12 @@ int32_t ModelResource::find_material_index_by_mesh_name(
 	const std::string &name
 ) const {
 	for (size_t i = 0; i < _meshes.size(); ++i) {
-		if (name == _meshes[i].get_name())
-			return static_cast<int32_t>(_meshes[i].get_material_index());
+		if (name == _meshes[i].get_name()) {
+			const size_t &mat_index = _meshes[i].get_material_index();
+			if (mat_index == Mesh::NO_MATERIAL)
+				return -1;
+			return static_cast<int32_t>(mat_index);
+		}
 	}
 	return -1;
 }
@@ -281,6 +387,12 @@ int32_t ModelResource::find_material_index_by_path(
 	return -1;
 }
 
+void ModelResource::pad_bounds(const float &margin) {
+	_bounds.pad(margin);
+	for (Mesh &mesh : _meshes)
+		mesh.pad_bounds(margin);
+}
+
 void ModelResource::set_face_cull_option(const GLenum& cull_option) {
 	switch (cull_option) {
 	case GL_FRONT:
@@ -300,6 +412,104 @@ void ModelResource::draw_meshes(
 	draw_opaque_meshes(material_overrides, mesh_overrides);
 }
 
+void ModelResource::draw_meshes_instanced(
+	std::span<const glm::mat4> model_mats,
+	const std::vector<Material::Override> &material_overrides,
+	const std::vector<Mesh::Override> &mesh_overrides
+) {
+	if (_loading or model_mats.empty())
+		return;
+
+	// every Mesh reads the same model matrices.
+	res::GeometryArena::geometry_arena.set_instances(
+		model_mats.data(), model_mats.size()
+	);
+	GLsizei n_instances = static_cast<GLsizei>(model_mats.size());
+	_draw_mesh_by_indices(
+		material_overrides,
+		mesh_overrides,
+		_transparent_mesh_indices,
+		false,
+		n_instances
+	);
+	_draw_mesh_by_indices(
+		material_overrides,
+		mesh_overrides,
+		_opaque_mesh_indices,
+		true,
+		n_instances
+	);
+}
+
+void ModelResource::draw_meshes_instanced(
+	std::span<const glm::mat4> model_mats,
+	std::span<const float> anim_times,
+	const std::vector<Material::Override> &material_overrides,
+	const std::vector<Mesh::Override> &mesh_overrides
+) {
+	if (_loading or model_mats.empty())
+		return;
+	if (anim_times.size() < model_mats.size()) {
+		std::cerr << "there are fewer animation times than instances."
+			<< std::endl;
+		return;
+	}
+
+	res::GeometryArena::geometry_arena.set_instance_times(
+		anim_times.data(), model_mats.size()
+	);
+	draw_meshes_instanced(model_mats, material_overrides, mesh_overrides);
+}
+
+bool ModelResource::draw_visible_meshes(
+	const Camera &camera,
+	const glm::mat4 &model_mat,
+	const std::vector<Material::Override> &material_overrides,
+	const std::vector<Mesh::Override> &mesh_overrides
+) {
+	if (_loading or not camera.is_model_visible(_bounds, model_mat))
+		return false;
+
+	// keeps the Meshes in view in their original order,
+	// which the <mesh_overrides> rely on.
+	auto find_visible = [&](
+		std::vector<size_t> &visible, const std::vector<size_t> &mesh_indices
+	) {
+		visible.clear();
+		for (const size_t &i : mesh_indices)
+			if (camera.is_mesh_visible(_meshes[i].get_bounds(), model_mat))
+				visible.push_back(i);
+	};
+	find_visible(_visible_transparent_indices, _transparent_mesh_indices);
+	find_visible(_visible_opaque_indices, _opaque_mesh_indices);
+
+	_draw_mesh_by_indices(
+		material_overrides, mesh_overrides, _visible_transparent_indices, false
+	);
+	_draw_mesh_by_indices(
+		material_overrides, mesh_overrides, _visible_opaque_indices, true
+	);
+	return true;
+}
+
+void ModelResource::draw_visible_meshes_instanced(
+	const Camera &camera,
+	std::span<const glm::mat4> model_mats,
+	const std::vector<Material::Override> &material_overrides,
+	const std::vector<Mesh::Override> &mesh_overrides
+) {
+	if (_loading)
+		return;
+
+	_visible_model_mats.clear();
+	for (const glm::mat4 &model_mat : model_mats)
+		if (camera.is_model_visible(_bounds, model_mat))
+			_visible_model_mats.push_back(model_mat);
+	draw_meshes_instanced(
+		_visible_model_mats, material_overrides, mesh_overrides
+	);
+}
+
 void ModelResource::draw_transparent_meshes(
 	const std::vector<Material::Override> &material_overrides,
 	const std::vector<Mesh::Override> &mesh_overrides
@@ -322,14 +532,14 @@ void ModelResource::_draw_mesh_by_indices(
 	const std::vector<Material::Override> &material_overrides,
 	const std::vector<Mesh::Override> &mesh_overrides,
 	const std::vector<size_t> &mesh_indices,
-	const bool use_face_culling
+	const bool use_face_culling,
+	const GLsizei n_instances
 ) {
-	if (use_face_culling and _face_cull_option != GL_NONE) {
-		glEnable(GL_CULL_FACE);
-		glCullFace(_face_cull_option);
-	} else {
-		glDisable(GL_CULL_FACE);
-	}
+	// nothing is drawn until the ModelResource has finished loading.
+	if (_loading)
+		return;
+
+	GLState::set_cull_face(use_face_culling ? _face_cull_option : GL_NONE);
 
 	// backs up the default Material shared pointers.
 	std::vector<Material::Override> backup_materials;
@@ -344,7 +554,9 @@ void ModelResource::_draw_mesh_by_indices(
 		_materials[mat_override.material_index] = mat_override.material;
 	}
 
-	// draws Meshes.
+	// draws Meshes, whose geometry is all under the GeometryArena's VAO.
+	UniformBlocks::upload_lights();
+	res::GeometryArena::geometry_arena.bind();
 	size_t mesh_overrides_index = 0;
 	std::shared_ptr<Material> last_bound = nullptr;
 	for (const size_t &i : mesh_indices) {
@@ -358,15 +570,21 @@ void ModelResource::_draw_mesh_by_indices(
 			mesh_material = mesh_overrides[mesh_overrides_index].material;
 			++mesh_overrides_index;
 		} else {
-			mesh_material = _materials[_meshes[i].get_material_index()];
+			mesh_material = get_material(_meshes[i].get_material_index());
 		}
 
 		// binds the Material if it hasn't already, then draws the Mesh.
+		// a Mesh without a Material has nothing to be drawn with.
+		if (not mesh_material)
+			continue;
 		if (last_bound != mesh_material) {
 			mesh_material->bind_to_GL();
 			last_bound = mesh_material;
 		}
-		_meshes[i].draw();
+		if (n_instances > 0)
+			_meshes[i].draw_instanced(n_instances);
+		else
+			_meshes[i].draw();
 	}
 
 	// restores the default Material shared pointers.
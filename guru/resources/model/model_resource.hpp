@@ -8,15 +8,48 @@
  */
 
 #pragma once
+#include <span>
 #include "mesh.hpp"
+#include "model_cache.hpp"
+#include "../../environment/camera.hpp"
 
 namespace gu {
+namespace res {
+class ModelResourceList;
+}
+
 class ModelResource {
+public:
+	/**
+	 * ModelResource::Source
+	 * ---
+	 * this struct holds everything read from a 3D model file
+	 * before any OpenGL calls are made, so that it can be prepared
+	 * on a worker thread and then uploaded on the main thread.
+	 *
+	 */
+	struct Source {
+		std::filesystem::path path;
+		res::ModelCache cache; // used if the 3D model file was cached
+		std::vector<res::ModelCache::MeshData> mesh_data; // if not cached
+		std::vector<res::ModelCache::MeshView> meshes; // points to geometry
+		std::vector<Material::MapPaths> material_paths;
+		std::vector<Material::Images> material_images; // if decoded early
+		std::map<std::string, Mesh::RigInfo> name_to_rig_info;
+	};
+
 protected:
 	std::vector<Mesh> _meshes; // VAOs
 	std::vector<std::shared_ptr<Material>> _materials; // materials
+	std::vector<Material::MapPaths> _material_paths; // matches <_materials>
 	std::vector<size_t> _transparent_mesh_indices;
 	std::vector<size_t> _opaque_mesh_indices;
+	Bounds _bounds; // of every Mesh in model space
+
+	// reused by the draws that cull against a Camera.
+	std::vector<size_t> _visible_transparent_indices;
+	std::vector<size_t> _visible_opaque_indices;
+	std::vector<glm::mat4> _visible_model_mats;
 
 	// this map is used to map the name of a bone to some ID and offset matrix.
 	std::map<std::string, Mesh::RigInfo> _name_to_rig_info; // UNCERTAIN: make unordered_map?
@@ -24,6 +57,8 @@ protected:
 	GLenum _face_cull_option = GL_BACK;
 	std::filesystem::path _path; // path to the loaded 3D model
 	bool _uses_map[Material::N_MAP_TYPES]; // [i] is true if Mesh loaded map
+	bool _loading = false; // true while being loaded in the background
+	friend class res::ModelResourceList;
 
 public:
 	// ctor. initializes member variables.
@@ -44,9 +79,35 @@ public:
 	void load(const std::filesystem::path& path);
 
 protected:
+	// returns true if the 3D object file at <path> was read into <source>.
+	// a cache file is used if it's up to date, otherwise it's written.
+	// no OpenGL calls are made and no ResourceLists are used,
+	// so this can be run on any thread.
+	static bool _read_source(Source &source, const std::filesystem::path &path);
+
 	// processes a given node and its contained aiMeshes, with each
-	// aiMesh's data being transferred to the object's list of Meshes.
-	void _process_node(size_t &n_meshes, aiNode *node, const aiScene *scene);
+	// aiMesh's geometry being converted into the <source>'s <mesh_data>.
+	// the image paths of the aiMeshes' Materials are found along the way.
+	static void _process_node(
+		Source &source, aiNode *node, const aiScene *scene
+	);
+
+	// adds the given <material> and its image <paths>
+	// to the object's list of Materials.
+	void _add_material(
+		const std::shared_ptr<Material> &material,
+		const Material::MapPaths &paths
+	);
+
+	// adds a new Mesh to the object's list of Meshes,
+	// sends the geometry of the given <view> to the videocard,
+	// and organizes the Mesh's index by the transparency of its Material.
+	void _add_mesh(const res::ModelCache::MeshView &view);
+
+	// takes the rigging information from the <source>,
+	// sets <_uses_map> from the maps used by the object's Materials,
+	// and marks the ModelResource as finished loading.
+	void _finish_loading(Source &source);
 
 public:
 	// returns true if this ModelResource uses a particular map type.
@@ -54,9 +115,47 @@ public:
 		return (map_type < Material::N_MAP_TYPES and _uses_map[map_type]);
 	}
 
+	// returns true while the ModelResource is still being loaded
+	// in the background. nothing is drawn until loading has finished.
+	inline bool is_loading() const { return _loading; }
+
 	// returns the file path to the 3D object file.
 	inline const std::filesystem::path &get_path() const { return _path; }
 
+	// returns the number of Meshes in the ModelResource.
+	inline size_t get_n_meshes() const { return _meshes.size(); }
+
+	// returns the Mesh at <mesh_index> in the object's list of Meshes.
+	inline const Mesh &get_mesh(const size_t &mesh_index) const {
+		return _meshes[mesh_index];
+	}
+
+	// returns the Material at <material_index>
+	// in the object's list of Materials,
+	// or nullptr if <material_index> is Mesh::NO_MATERIAL.
+	inline const std::shared_ptr<Material> &get_material(
+		const size_t &material_index
+	) const {
+		static const std::shared_ptr<Material> NO_MATERIAL = nullptr;
+		if (material_index >= _materials.size())
+			return NO_MATERIAL;
+		return _materials[material_index];
+	}
+
+	// returns the face culling option of GL_FRONT, GL_BACK, or GL_NONE.
+	inline const GLenum &get_face_cull_option() const {
+		return _face_cull_option;
+	}
+
+	// returns the Bounds of every Mesh in model space.
+	inline const Bounds &get_bounds() const { return _bounds; }
+
+	// grows the Bounds of the ModelResource and each of its Meshes
+	// by the <margin> in every direction.
+	// this keeps animated models from being culled
+	// when they move outside of their bind pose.
+	void pad_bounds(const float &margin);
+
 	// returns true if the ModelResource has rigged bones.
 	inline bool has_rig() const { return _name_to_rig_info.size() > 0; }
 
@@ -103,6 +202,73 @@ public:
 		)
 	);
 
+	// draws every mesh of the ModelResource once for each of the given
+	// <model_mats> with hardware instancing, so each Mesh is one draw call
+	// no matter how many instances there are.
+	// the bound Shader must read the model matrix from the per-instance
+	// attribute "layout (location = 7) in mat4 attr_model_mat"
+	// (e.g. the INSTANCING variant of "light_shader.v_shader").
+	// ---
+	// <material_overrides> and <mesh_overrides> are used like in draw_meshes().
+	void draw_meshes_instanced(
+		std::span<const glm::mat4> model_mats,
+		const std::vector<Material::Override> &material_overrides = (
+			std::vector<Material::Override>()
+		),
+		const std::vector<Mesh::Override> &mesh_overrides = (
+			std::vector<Mesh::Override>()
+		)
+	);
+
+	// draws every mesh like above, also giving each instance
+	// its own time in the baked animation set on the bound Shader,
+	// which reads it from "layout (location = 11) in float attr_anim_time"
+	// (e.g. "baked_anim_light_shader.v_shader").
+	// <anim_times> must hold as many times as there are <model_mats>.
+	void draw_meshes_instanced(
+		std::span<const glm::mat4> model_mats,
+		std::span<const float> anim_times,
+		const std::vector<Material::Override> &material_overrides = (
+			std::vector<Material::Override>()
+		),
+		const std::vector<Mesh::Override> &mesh_overrides = (
+			std::vector<Mesh::Override>()
+		)
+	);
+
+	// draws the meshes of the ModelResource that are in the <camera>'s view
+	// when transformed by the <model_mat>, which should also be set
+	// on the bound Shader. the whole model is tested first,
+	// then each of its Meshes, with the results counted
+	// in the <camera>'s CullingStats.
+	// returns false if the whole model was culled.
+	// ---
+	// <material_overrides> and <mesh_overrides> are used like in draw_meshes().
+	bool draw_visible_meshes(
+		const Camera &camera,
+		const glm::mat4 &model_mat,
+		const std::vector<Material::Override> &material_overrides = (
+			std::vector<Material::Override>()
+		),
+		const std::vector<Mesh::Override> &mesh_overrides = (
+			std::vector<Mesh::Override>()
+		)
+	);
+
+	// draws the instances of the ModelResource like draw_meshes_instanced(...)
+	// after removing every instance whose <model_mats> place it
+	// outside of the <camera>'s view.
+	void draw_visible_meshes_instanced(
+		const Camera &camera,
+		std::span<const glm::mat4> model_mats,
+		const std::vector<Material::Override> &material_overrides = (
+			std::vector<Material::Override>()
+		),
+		const std::vector<Mesh::Override> &mesh_overrides = (
+			std::vector<Mesh::Override>()
+		)
+	);
+
 	// draws the transparent meshes of the ModelResource.
 	// ---
 	// <material_overrides> can be given
@@ -149,11 +315,15 @@ protected:
 	// ---
 	// if <use_face_culling> is true,
 	// then the ModelResource's face-culling option will be applied.
+	// ---
+	// if <n_instances> is more than 0, then each Mesh is drawn
+	// that many times from the GeometryArena's instance buffer.
 	void _draw_mesh_by_indices(
 		const std::vector<Material::Override> &material_overrides,
 		const std::vector<Mesh::Override> &mesh_overrides,
 		const std::vector<size_t> &mesh_indices,
-		const bool use_face_culling
+		const bool use_face_culling,
+		const GLsizei n_instances = 0
 	);
 };
 } // namespace gu
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * vertex.hpp
+ * ---
+ * this file defines the Vertex struct,
+ * which is the layout of the geometry stored in the GeometryArena.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include "../../system/settings.hpp"
+
+namespace gu {
+/**
+ * Vertex
+ * ---
+ * this struct is used to buffer geometric information
+ * from a file to the video card.
+ *
+ */
+struct Vertex {
+	glm::vec3 position = glm::vec3(0.0f);
+	glm::vec2 uv = glm::vec2(0.0f);
+	glm::vec3 normal = glm::vec3(0.0f);
+	#if not defined(GURU_DISABLE_TANGENT_SPACE)
+	glm::vec3 tangent = glm::vec3(0.0f);
+	glm::vec3 bitangent = glm::vec3(0.0f);
+	#endif
+	int bone_IDs[Settings::MAX_BONE_INFLUENCES];
+	float weights[Settings::MAX_BONE_INFLUENCES];
+
+	inline Vertex() { set_bone_data_to_default(); }
+
+	// sets all rigging information in the Vertex to not be used.
+	void set_bone_data_to_default() {
+		for (uint8_t i = 0; i < Settings::MAX_BONE_INFLUENCES; ++i) {
+			bone_IDs[i] = -1;
+			weights[i] = 0.0f;
+		}
+	}
+
+	// sets the next empty rigging information elements of <bone_IDs> and <weights>
+	// to the given <bone_ID> and <weight>.
+	void set_bone_data(int bone_ID, const float &weight) {
+		for (uint8_t i = 0; i < Settings::MAX_BONE_INFLUENCES; ++i) {
+			if (bone_IDs[i] == -1) {
+				// a bone ID is not yet set for this influence.
+				bone_IDs[i] = bone_ID;
+				weights[i] = weight;
+				break;
+			}
+		}
+	}
+};
+} // namespace gu
\ No newline at end of file
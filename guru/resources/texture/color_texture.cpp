@@ -1,6 +1,7 @@
 #include "color_texture.hpp"
 #include <string>
 #include "texture_list.hpp"
+#include "../../system/gl_state.hpp"
 
 static auto &texture_list = gu::res::TextureList::texture_list;
 
@@ -19,7 +20,7 @@ std::shared_ptr<TextureInfo> create_solid_color(
 	// creates a new texture in OpenGL memory and sets its parameters.
 	GLuint texture_ID;
 	glGenTextures(1, &texture_ID);
-	glBindTexture(GL_TEXTURE_2D, texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D, texture_ID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
@@ -56,7 +57,7 @@ std::shared_ptr<TextureInfo> create_radial_gradient(
 	// creates a new texture in OpenGL memory and sets its parameters.
 	GLuint texture_ID;
 	glGenTextures(1, &texture_ID);
-	glBindTexture(GL_TEXTURE_2D, texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D, texture_ID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
@@ -118,7 +119,7 @@ std::shared_ptr<TextureInfo> create_checkerboard(
 	// creates a new texture in OpenGL memory and sets its parameters.
 	GLuint texture_ID;
 	glGenTextures(1, &texture_ID);
-	glBindTexture(GL_TEXTURE_2D, texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D, texture_ID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
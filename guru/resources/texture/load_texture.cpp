@@ -4,6 +4,8 @@
 #include "stb_image.h"
 #include "texture_list.hpp"
 #include "color_texture.hpp"
+#include "../../system/gl_state.hpp"
+#include "../../system/thread_pool.hpp"
 
 static const gu::Color RAW_COLOR = gu::Color(1.0, 0.0, 0.0);
 static const gu::Color ERROR_CHECKERBOARD_LIGHT = gu::Color(100, 0, 86);
@@ -23,20 +25,86 @@ GLenum determine_format(int n_color_channels) {
 	}
 }
 
-std::shared_ptr<TextureInfo> load_texture(
-	const std::filesystem::path &path,
+ImageData::~ImageData() {
+	free_pixels();
+}
+
+ImageData::ImageData(ImageData &&other) noexcept {
+	*this = std::move(other);
+}
+
+ImageData &ImageData::operator= (ImageData &&other) noexcept {
+	if (this == &other)
+		return *this;
+	free_pixels();
+	path = std::move(other.path);
+	width = other.width;
+	height = other.height;
+	n_channels = other.n_channels;
+	pixels = other.pixels;
+	other.pixels = nullptr;
+	return *this;
+}
+
+void ImageData::free_pixels() {
+	if (pixels)
+		stbi_image_free(pixels);
+	pixels = nullptr;
+}
+
+bool decode_image(ImageData &image, const std::filesystem::path &path) {
+	image.free_pixels();
+	image.path = path;
+	image.pixels = stbi_load(
+		path.string().c_str(),
+		&image.width,
+		&image.height,
+		&image.n_channels,
+		0
+	);
+	return image.pixels != nullptr;
+}
+
+void decode_images(const std::vector<ImageData *> &images) {
+	if (images.size() == 1) {
+		decode_image(*images[0], std::filesystem::path(images[0]->path));
+		return;
+	}
+	ThreadPool::thread_pool.run_parallel(images.size(), [&images](size_t i) {
+		decode_image(*images[i], std::filesystem::path(images[i]->path));
+	});
+}
+
+std::shared_ptr<TextureInfo> upload_texture(
+	ImageData &image,
 	bool *is_transparent,
 	const bool smooth_on_mag
 ) {
-	// returns the existing texture ID if the same <path> has been found.
-	const std::shared_ptr<TextureInfo> &ptr = texture_list.find_existing(path);
-	if (ptr)
+	// returns the existing texture ID if the same path has been found.
+	const std::shared_ptr<TextureInfo> &ptr = texture_list.find_existing(
+		image.path
+	);
+	if (ptr) {
+		image.free_pixels();
 		return ptr;
+	}
+
+	if (not image.pixels) {
+		std::cerr
+			<< "Image " << image.path.string() << " could not be loaded."
+			<< std::endl;
+
+		const std::shared_ptr<TextureInfo> &error_info = create_checkerboard(
+			ERROR_CHECKERBOARD_LIGHT,
+			ERROR_CHECKERBOARD_DARK
+		);
+		return error_info;
+	}
 
 	// creates texture in OpenGL memory and sets its parameters.
 	GLuint texture_ID;
 	glGenTextures(1, &texture_ID);
-	glBindTexture(GL_TEXTURE_2D, texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D, texture_ID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 	glTexParameteri(
@@ -45,55 +113,55 @@ std::shared_ptr<TextureInfo> load_texture(
 	GLenum mag_option = smooth_on_mag ? GL_LINEAR : GL_NEAREST;
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_option);
 
-	// loads image with stbi.
-	int w, h, n_channels;
-	unsigned char *data = stbi_load(
-		path.string().c_str(), &w, &h, &n_channels, 0
+	// transfers data to the texture.
+	const int &w = image.width;
+	const int &h = image.height;
+	const int &n_channels = image.n_channels;
+	unsigned char *data = image.pixels;
+	GLenum format = determine_format(n_channels);
+	glTexImage2D(
+		GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data
 	);
+	glGenerateMipmap(GL_TEXTURE_2D);
 
-	if (data) {
-		// transfers data to the texture.
-		GLenum format = determine_format(n_channels);
-		glTexImage2D(
-			GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data
-		);
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// if the function is specified to check for transparency,
-		// then a grid of pixels will be sampled
-		// proportionally across the image to check if the texture is transparent.
-		if (n_channels == 4 and is_transparent) {
-			for (float x = 0.25f; x < 1.0f; x+=0.25f) {
-				for (float y = 0.25f; x < 1.0f; x += 0.25f) {
-					int center_pixel_i = static_cast<int>(
-						h * y * w + w * x
-					) * n_channels;
-					if (data[center_pixel_i + 3] < 255) {
-						*is_transparent = true;
-						break;
-					}
-				}
-				if (*is_transparent)
+	// if the function is specified to check for transparency,
+	// then a grid of pixels will be sampled
+	// proportionally across the image to check if the texture is transparent.
+	if (n_channels == 4 and is_transparent) {
+		for (float x = 0.25f; x < 1.0f; x+=0.25f) {
+			for (float y = 0.25f; x < 1.0f; x += 0.25f) {
+				int center_pixel_i = static_cast<int>(
+					h * y * w + w * x
+				) * n_channels;
+				if (data[center_pixel_i + 3] < 255) {
+					*is_transparent = true;
 					break;
+				}
 			}
+			if (*is_transparent)
+				break;
 		}
-		stbi_image_free(data);
-		TextureInfo new_info = TextureInfo(path, texture_ID);
-		texture_list.create_entry(new_info);
-		return texture_list.get_last_created();
 	}
+	TextureInfo new_info = TextureInfo(image.path, texture_ID);
+	image.free_pixels();
+	texture_list.create_entry(new_info);
+	return texture_list.get_last_created();
+}
 
-	std::cerr
-		<< "Image " << path.string() << " could not be loaded."
-		<< std::endl;
-	stbi_image_free(data);
-	glDeleteTextures(1, &texture_ID);
+std::shared_ptr<TextureInfo> load_texture(
+	const std::filesystem::path &path,
+	bool *is_transparent,
+	const bool smooth_on_mag
+) {
+	// returns the existing texture ID if the same <path> has been found.
+	const std::shared_ptr<TextureInfo> &ptr = texture_list.find_existing(path);
+	if (ptr)
+		return ptr;
 
-	const std::shared_ptr<TextureInfo> &error_info = create_checkerboard(
-		ERROR_CHECKERBOARD_LIGHT,
-		ERROR_CHECKERBOARD_DARK
-	);
-	return error_info;
+	// loads image with stbi.
+	ImageData image;
+	decode_image(image, path);
+	return upload_texture(image, is_transparent, smooth_on_mag);
 }
 
 GLuint load_cube_map(
@@ -114,7 +182,7 @@ GLuint load_cube_map(
 	// creates texture in OpenGL memory and sets its parameters.
 	GLuint texture_ID;
 	glGenTextures(1, &texture_ID);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, texture_ID);
+	GLState::bind_texture(GL_TEXTURE_CUBE_MAP, texture_ID);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
@@ -10,14 +10,67 @@
 #pragma once
 #include <filesystem>
 #include <memory>
+#include <vector>
 #include "texture_info.hpp"
 #include "../color.hpp"
 
 namespace gu {
 namespace res {
+/**
+ * ImageData
+ * ---
+ * this struct holds the pixels of an image decoded by stb_image.
+ * decoding makes no OpenGL calls, so it can be done on any thread
+ * before the image is given to upload_texture(...) on the main thread.
+ *
+ */
+struct ImageData {
+	std::filesystem::path path;
+	int width = 0;
+	int height = 0;
+	int n_channels = 0;
+	unsigned char *pixels = nullptr; // nullptr if the image couldn't be loaded
+
+	ImageData() = default;
+
+	// dtor. frees the decoded pixels.
+	~ImageData();
+
+	// moves the decoded pixels from <other>.
+	ImageData(ImageData &&other) noexcept;
+	ImageData &operator= (ImageData &&other) noexcept;
+
+	// deletes copy ctors to prevent the pixels from being freed twice.
+	ImageData(const ImageData&) = delete;
+	ImageData &operator= (const ImageData&) = delete;
+
+	// frees the decoded pixels.
+	void free_pixels();
+};
+
 // returns the image format, based on the number of color channels.
 GLenum determine_format(int n_color_channels);
 
+// returns true if the image found at <path> was decoded into <image>.
+// no OpenGL calls are made, so this can be run on any thread.
+bool decode_image(ImageData &image, const std::filesystem::path &path);
+
+// decodes every given image from its already set <path>
+// in parallel on the ThreadPool, returning once all of them are decoded.
+// no OpenGL calls are made, so this can be run on any thread.
+void decode_images(const std::vector<ImageData *> &images);
+
+// returns a shared pointer to a TextureInfo object that contains
+// the OpenGL ID of the given decoded <image>, which is then freed.
+// if the image's path was already loaded, the existing texture is returned.
+// <is_transparent> and <smooth_on_mag> are used like in load_texture(...).
+// this must be called from the main thread.
+std::shared_ptr<TextureInfo> upload_texture(
+	ImageData &image,
+	bool *is_transparent=nullptr,
+	const bool smooth_on_mag=true
+);
+
 // returns a shared pointer to a TextureInfo object that contains
 // the OpenGL ID of the loaded image found at <path>.
 // <is_transparent> is a boolean which when used will
@@ -13,6 +13,7 @@
 #include "texture_info.hpp"
 #include "../color.hpp"
 #include "../resource_list.hpp"
+#include "../../system/gl_state.hpp"
 
 namespace gu {
 namespace res {
@@ -30,6 +31,7 @@ protected:
 		const std::shared_ptr<TextureInfo> &res_ptr
 	) override {
 		glDeleteTextures(1, &(res_ptr->texture_ID));
+		GLState::forget_texture(res_ptr->texture_ID);
 	}
 };
 } // namespace res
@@ -0,0 +1,48 @@
+#include "deferred_shader.hpp"
+#include "uniform_blocks.hpp"
+#include "../environment/shadow_maps.hpp"
+
+namespace gu {
+void DeferredShader::_config_uniform_IDs() {
+	// finds IDs of uniform variables in the DeferredShader.
+	glLinkProgram(_program_ID);
+	_uni_inv_PV_mat_4fv_ID = glGetUniformLocation(_program_ID, "_inv_PV_mat");
+	_uni_viewport_4fv_ID = glGetUniformLocation(_program_ID, "_viewport");
+	_uni_clear_color_3fv_ID = glGetUniformLocation(
+		_program_ID, "_clear_color"
+	);
+	UniformBlocks::bind_program(_program_ID);
+
+	static const char *GBUFFER_NAMES[4] = {
+		"_g_albedo", "_g_normal", "_g_material", "_g_depth"
+	};
+	GLint uni_gbuffer_1i_IDs[4]{};
+	for (int i = 0; i < 4; ++i) {
+		uni_gbuffer_1i_IDs[i] = glGetUniformLocation(
+			_program_ID, GBUFFER_NAMES[i]
+		);
+	}
+	GLint uni_lights_1i_ID = glGetUniformLocation(
+		_program_ID, "_deferred_lights"
+	);
+	glLinkProgram(0);
+
+	// the GBuffer's textures are expected to be bound
+	// in order from the GBUFFER_TEXTURE_UNIT.
+	use();
+	for (int i = 0; i < 4; ++i)
+		glUniform1i(uni_gbuffer_1i_IDs[i], GBUFFER_TEXTURE_UNIT + i);
+	glUniform1i(uni_lights_1i_ID, LIGHTS_TEXTURE_UNIT);
+
+	// the shadowed light shaders read the maps of the ShadowMaps.
+	glUniform1i(
+		glGetUniformLocation(_program_ID, "_cascade_shadow_maps"),
+		ShadowMaps::CASCADES_TEXTURE_UNIT
+	);
+	glUniform1i(
+		glGetUniformLocation(_program_ID, "_spot_shadow_maps"),
+		ShadowMaps::SPOT_TEXTURE_UNIT
+	);
+	GLState::use_program(0);
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+ * deferred_shader.hpp
+ * ---
+ * this file defines the DeferredShader class as a child of the Shader class,
+ * which is built to light the GBuffer in the passes of the DeferredRenderer.
+ *
+ * ---
+ * the GBuffer's textures are read as "_g_albedo", "_g_normal",
+ * "_g_material" and "_g_depth" from the texture units beginning at
+ * the GBUFFER_TEXTURE_UNIT, and the lights drawn as volumes
+ * are read as "_deferred_lights" from the LIGHTS_TEXTURE_UNIT.
+ * each pixel's world position is rebuilt from its depth
+ * with the inverse of the Camera's projection * view matrix.
+ * the maps of the ShadowMaps are read from their own texture units.
+ *
+ */
+
+#pragma once
+#include "shader.hpp"
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace gu {
+class DeferredShader : public Shader {
+public:
+	// the first of the texture units the GBuffer's textures are bound to.
+	static constexpr GLuint GBUFFER_TEXTURE_UNIT = 0;
+
+	// the texture unit the lights drawn as volumes are bound to,
+	// which follows the LightClusters'.
+	static constexpr GLuint LIGHTS_TEXTURE_UNIT = 13;
+
+protected:
+	GLint _uni_inv_PV_mat_4fv_ID = -1; // inverse projection-view matrix
+	GLint _uni_viewport_4fv_ID = -1; // x, y, width, height
+	GLint _uni_clear_color_3fv_ID = -1; // of pixels with no geometry
+
+	// sets the class's contained uniform IDs by searching for them in the code.
+	virtual void _config_uniform_IDs() override;
+
+public:
+	// sets the inverse projection-view matrix in the DeferredShader.
+	// this will be the "uniform mat4 _inv_PV_mat".
+	inline void set_inv_PV_mat(const glm::mat4 &mat) const {
+		glUniformMatrix4fv(_uni_inv_PV_mat_4fv_ID, 1, GL_FALSE, &mat[0][0]);
+	}
+
+	// sets the glViewport(...) x, y, width and height of the Camera.
+	// this will be the "uniform vec4 _viewport".
+	inline void set_viewport(const glm::vec4 &viewport) const {
+		glUniform4fv(_uni_viewport_4fv_ID, 1, &viewport[0]);
+	}
+
+	// sets the color of the pixels that no geometry was drawn to.
+	// this will be the "uniform vec3 _clear_color".
+	inline void set_clear_color(const glm::vec3 &color) const {
+		glUniform3fv(_uni_clear_color_3fv_ID, 1, &color[0]);
+	}
+};
+} // namespace gu
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "model_shader.hpp"
+#include "uniform_blocks.hpp"
+#include "../resources/animation/baked_animation.hpp"
+#include "../resources/animation/bone_palette.hpp"
 #include "../resources/material/material.hpp"
-#include "../system/settings.hpp"
 
 namespace gu {
 void ModelShader::_config_uniform_IDs() {
@@ -8,7 +10,9 @@ void ModelShader::_config_uniform_IDs() {
 	glLinkProgram(_program_ID);
 	_uni_PVM_mat_4fv_ID = glGetUniformLocation(_program_ID, "_PVM_mat");
 	_uni_PV_mat_4fv_ID = glGetUniformLocation(_program_ID, "_PV_mat");
-	_set_bone_mat_uniform_IDs();
+	_uni_model_mat_4fv_ID = glGetUniformLocation(_program_ID, "_model_mat");
+	_set_bone_palette_uniform_IDs();
+	UniformBlocks::bind_program(_program_ID);
 
 	// gets the locations of the texture IDs.
 	GLint uni_map_texture_1i_IDs[Material::MAP_TYPE::ENUM_MAX]{};
@@ -25,30 +29,49 @@ void ModelShader::_config_uniform_IDs() {
 	use();
 	for (uint8_t i = 0; i < Material::MAP_TYPE::ENUM_MAX; ++i)
 		glUniform1i(uni_map_texture_1i_IDs[i], Material::MAP_TYPE::DIFFUSE + i);
-	glUseProgram(0);
+	_set_bone_palette_texture_unit();
+	GLState::use_program(0);
 }
 
-void ModelShader::_set_bone_mat_uniform_IDs() {
-	if (glGetUniformLocation(_program_ID, "_bone_mats[0]") == -1) {
-		_uses_animation = false;
-		return;
-	}
+void ModelShader::_set_bone_palette_uniform_IDs() {
+	_uni_bone_palette_1i_ID = glGetUniformLocation(_program_ID, "_bone_palette");
+	_uni_bone_offset_1i_ID = glGetUniformLocation(_program_ID, "_bone_offset");
+	_uni_n_bones_1i_ID = glGetUniformLocation(_program_ID, "_n_bones");
+	_uses_animation = _uni_bone_palette_1i_ID != -1;
 
-	_uses_animation = true;
-	_uni_bone_mat_4fv_IDs.reserve(Settings::MAX_BONES);
-	for (size_t i = 0; i < Settings::MAX_BONES; ++i) {
-		std::string search_str = std::string("_bone_mats[") + std::to_string(i) + std::string("]");
-		_uni_bone_mat_4fv_IDs.push_back(
-			glGetUniformLocation(_program_ID, search_str.c_str())
-		);
-	}
+	_uni_baked_anim_1i_ID = glGetUniformLocation(_program_ID, "_baked_anim");
+	_uni_baked_n_bones_1i_ID = glGetUniformLocation(
+		_program_ID, "_baked_n_bones"
+	);
+	_uni_baked_n_frames_1i_ID = glGetUniformLocation(
+		_program_ID, "_baked_n_frames"
+	);
+	_uni_baked_fps_1f_ID = glGetUniformLocation(_program_ID, "_baked_fps");
+	_uses_baked_animation = _uni_baked_anim_1i_ID != -1;
 }
 
-void ModelShader::update_GL_bones(
-	const std::vector<glm::mat4> &bone_mats
+void ModelShader::_set_bone_palette_texture_unit() const {
+	if (_uses_animation)
+		glUniform1i(_uni_bone_palette_1i_ID, res::BonePalette::TEXTURE_UNIT);
+	if (_uses_baked_animation)
+		glUniform1i(_uni_baked_anim_1i_ID, res::BakedAnimation::TEXTURE_UNIT);
+}
+
+void ModelShader::set_baked_animation(
+	const res::BakedAnimation &baked_animation
 ) const {
-	for (size_t i = 0; i < Settings::MAX_BONES; ++i)
-		_set_bone_mat(i, bone_mats[i]);
+	if (not _uses_baked_animation)
+		return;
+	baked_animation.bind();
+	glUniform1i(
+		_uni_baked_n_bones_1i_ID,
+		static_cast<GLint>(baked_animation.get_n_bones())
+	);
+	glUniform1i(
+		_uni_baked_n_frames_1i_ID,
+		static_cast<GLint>(baked_animation.get_n_frames())
+	);
+	glUniform1f(_uni_baked_fps_1f_ID, baked_animation.get_frames_per_second());
 }
 
 } // namespace gu
\ No newline at end of file
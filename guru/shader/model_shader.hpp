@@ -11,26 +11,36 @@
 #include <glm/mat4x4.hpp>
 
 namespace gu {
+namespace res {
+class BakedAnimation;
+} // namespace res
+
 class ModelShader : public Shader {
 protected:
 	GLint _uni_PVM_mat_4fv_ID = -1; // projection-view-model matrix
 	GLint _uni_PV_mat_4fv_ID = -1; // projection-view matrix
-	std::vector<GLint> _uni_bone_mat_4fv_IDs; // animation bone matrices
+	GLint _uni_model_mat_4fv_ID = -1; // model matrix
+	GLint _uni_bone_palette_1i_ID = -1; // samplerBuffer of bone matrices
+	GLint _uni_bone_offset_1i_ID = -1; // first matrix of the palette
+	GLint _uni_n_bones_1i_ID = -1; // matrices per palette
 	bool _uses_animation = false;
+	GLint _uni_baked_anim_1i_ID = -1; // sampler2D of baked bone matrices
+	GLint _uni_baked_n_bones_1i_ID = -1;
+	GLint _uni_baked_n_frames_1i_ID = -1;
+	GLint _uni_baked_fps_1f_ID = -1;
+	bool _uses_baked_animation = false;
 
 	// sets the class's contained uniform IDs by searching for them in the code.
 	virtual void _config_uniform_IDs() override;
 
-	// sets the uniform IDs for each element of "bone_mats" in the ModelShader.
-	void _set_bone_mat_uniform_IDs();
+	// sets the uniform IDs used to read the BonePalette
+	// and BakedAnimations in the ModelShader.
+	void _set_bone_palette_uniform_IDs();
 
-	inline void _set_bone_mat(const size_t &index, const glm::mat4 &mat) const {
-		if (_uses_animation) {
-			glUniformMatrix4fv(
-				_uni_bone_mat_4fv_IDs[index], 1, GL_FALSE, &mat[0][0]
-			);
-		}
-	}
+	// sets the samplerBuffer "_bone_palette" to the BonePalette's
+	// texture unit and the sampler2D "_baked_anim" to the BakedAnimation's.
+	// the ModelShader must be in use.
+	void _set_bone_palette_texture_unit() const;
 public:
 	// sets the projection-view-model matrix in the ModelShader.
 	// this will be the "uniform mat4 _PVM_mat" in the vertex shader.
@@ -42,6 +52,31 @@ public:
 		glUniformMatrix4fv(_uni_PV_mat_4fv_ID, 1, GL_FALSE, &mat[0][0]);
 	}
 
-	void update_GL_bones(const std::vector<glm::mat4> &bone_mats) const;
+	// sets the model matrix in the ModelShader.
+	// this will be the "uniform mat4 _model_mat" in the vertex shader.
+	inline void set_model_mat(const glm::mat4 &mat) const {
+		glUniformMatrix4fv(_uni_model_mat_4fv_ID, 1, GL_FALSE, &mat[0][0]);
+	}
+
+	// sets which matrices of the BonePalette are read as the bones
+	// of the drawn Meshes, with <offset> being the first matrix
+	// of the palette and <n_bones> being the number of matrices per palette.
+	// when drawing with instancing, the palette of each instance
+	// is expected to directly follow the palette of the previous instance.
+	// every palette of the frame should be pushed to the BonePalette
+	// and sent with one call to BonePalette::upload() before drawing.
+	inline void set_bone_palette(
+		const size_t &offset, const size_t &n_bones
+	) const {
+		if (_uses_animation) {
+			glUniform1i(_uni_bone_offset_1i_ID, static_cast<GLint>(offset));
+			glUniform1i(_uni_n_bones_1i_ID, static_cast<GLint>(n_bones));
+		}
+	}
+
+	// binds the <baked_animation>'s texture and sets the ModelShader
+	// to skin each instance with it at that instance's time.
+	// the ModelShader must be in use.
+	void set_baked_animation(const res::BakedAnimation &baked_animation) const;
 };
 } // namespace gu
\ No newline at end of file
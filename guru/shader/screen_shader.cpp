@@ -12,6 +12,6 @@ void ScreenShader::_config_uniform_IDs() {
 	// the screen texture will be expected to be bound to GL_TEXTURE0.
 	use();
 	glUniform1i(uni_screen_texture_1i_ID, 0);
-	glUseProgram(0);
+	GLState::use_program(0);
 }
 } // namespace gu
\ No newline at end of file
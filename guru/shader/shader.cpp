@@ -40,9 +40,17 @@ static GLuint build_shader_part(GLenum shader_type, const char* src) {
 }
 
 namespace gu {
+bool Shader::load_source(
+	std::string &received, const std::filesystem::path &path
+) {
+	return load_text_from_file(received, path);
+}
+
 Shader::~Shader() {
-	if (_program_ID != 0)
+	if (_program_ID != 0) {
 		glDeleteProgram(_program_ID);
+		GLState::forget_program(_program_ID);
+	}
 }
 
 bool Shader::build_from_files(
@@ -50,8 +58,8 @@ bool Shader::build_from_files(
 	const std::filesystem::path &f_shader_path
 ) {
 	std::string v_shader_src, f_shader_src;
-	load_text_from_file(v_shader_src, v_shader_path);
-	load_text_from_file(f_shader_src, f_shader_path);
+	load_source(v_shader_src, v_shader_path);
+	load_source(f_shader_src, f_shader_path);
 
 	bool build_is_successful = build_from_source(
 		v_shader_src.c_str(), f_shader_src.c_str()
@@ -66,8 +74,10 @@ bool Shader::build_from_files(
 bool Shader::build_from_source(
 	const char *v_shader_src, const char *f_shader_src
 ) {
-	if (_program_ID != 0)
+	if (_program_ID != 0) {
 		glDeleteProgram(_program_ID);
+		GLState::forget_program(_program_ID);
+	}
 
 	// builds the vertex shader.
 	GLuint v_shader = build_shader_part(GL_VERTEX_SHADER, v_shader_src);
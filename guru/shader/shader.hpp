@@ -8,7 +8,9 @@
 
 #pragma once
 #include <filesystem>
+#include <string>
 #include <glad/gl.h>
+#include "../system/gl_state.hpp"
 
 namespace gu {
 class Shader {
@@ -20,7 +22,14 @@ public:
 	~Shader();
 
 public:
-	inline void use() const { glUseProgram(_program_ID); }
+	// makes the shader program the one in use.
+	inline void use() const { GLState::use_program(_program_ID); }
+
+	// loads the source code of the shader file at the <path>
+	// into the given string <received>, returning true if it was loaded.
+	static bool load_source(
+		std::string &received, const std::filesystem::path &path
+	);
 
 	// returns true if the shader program was successfully built.
 	virtual bool build_from_files(
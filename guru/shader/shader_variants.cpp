@@ -0,0 +1,71 @@
+#include "shader_variants.hpp"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+// returns the <count> clamped from <min_count> to <max_count>.
+// <max_count> is taken by value, since it's given the UniformBlocks' counts.
+static int clamp_count(
+	const uint8_t &count, const int &min_count, size_t max_count
+) {
+	return std::clamp(
+		static_cast<int>(count), min_count, static_cast<int>(max_count)
+	);
+}
+
+namespace gu {
+size_t ShaderKey::Hash::operator()(const ShaderKey &key) const {
+	uint64_t bits = (
+		  static_cast<uint64_t>(key.features)
+		| static_cast<uint64_t>(key.n_dir_lights) << 8
+		| static_cast<uint64_t>(key.n_point_lights) << 16
+		| static_cast<uint64_t>(key.n_spot_lights) << 24
+		| static_cast<uint64_t>(key.n_bone_influences) << 32
+	);
+	return std::hash<uint64_t>()(bits);
+}
+
+std::string ShaderKey::get_defines() const {
+	std::ostringstream defines;
+	defines
+		<< "#define MAX_DIR_LIGHTS " << UniformBlocks::MAX_DIR_LIGHTS << '\n'
+		<< "#define MAX_POINT_LIGHTS "
+		<< UniformBlocks::MAX_POINT_LIGHTS << '\n'
+		<< "#define MAX_SPOT_LIGHTS " << UniformBlocks::MAX_SPOT_LIGHTS << '\n'
+		<< "#define N_DIR_LIGHTS "
+		<< clamp_count(n_dir_lights, 0, UniformBlocks::MAX_DIR_LIGHTS) << '\n'
+		<< "#define N_POINT_LIGHTS "
+		<< clamp_count(n_point_lights, 0, UniformBlocks::MAX_POINT_LIGHTS)
+		<< '\n'
+		<< "#define N_SPOT_LIGHTS "
+		<< clamp_count(n_spot_lights, 0, UniformBlocks::MAX_SPOT_LIGHTS) << '\n'
+		<< "#define MAX_BONE_INFLUENCES "
+		<< clamp_count(n_bone_influences, 1, 4) << '\n'
+		<< "#define SKINNING " << (has(SKINNING) ? 1 : 0) << '\n'
+		<< "#define NORMAL_MAPPING " << (has(NORMAL_MAPPING) ? 1 : 0) << '\n'
+		<< "#define INSTANCING " << (has(INSTANCING) ? 1 : 0) << '\n';
+	return defines.str();
+}
+
+std::string ShaderKey::inject_into(const std::string &src) const {
+	// finds the end of the "#version" line, which has to come first.
+	size_t version_line = src.find("#version");
+	size_t insert_at = 0;
+	size_t next_line_number = 1;
+	if (version_line != std::string::npos) {
+		size_t line_end = src.find('\n', version_line);
+		insert_at = line_end == std::string::npos ? src.size() : line_end + 1;
+		next_line_number = static_cast<size_t>(
+			std::count(src.begin(), src.begin() + insert_at, '\n')
+		) + 1;
+	}
+
+	std::string result = src.substr(0, insert_at);
+	if (not result.empty() and result.back() != '\n')
+		result += '\n';
+	result += get_defines();
+	result += "#line " + std::to_string(next_line_number) + '\n';
+	result += src.substr(insert_at);
+	return result;
+}
+} // namespace gu
\ No newline at end of file
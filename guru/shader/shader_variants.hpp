@@ -0,0 +1,172 @@
+/**
+ * shader_variants.hpp
+ * ---
+ * this file defines the ShaderKey struct and the ShaderVariants class,
+ * which build specialized versions of one pair of shader files
+ * by injecting preprocessor defines after their "#version" line,
+ * so one source can stand in for many hand-copied ones.
+ *
+ * ---
+ * a ShaderKey injects every one of these defines:
+ *
+ * MAX_DIR_LIGHTS, MAX_POINT_LIGHTS, MAX_SPOT_LIGHTS:
+ *     the sizes of the "LightBlock" arrays, which always match
+ *     the UniformBlocks so the std140 layout can't drift from it.
+ * N_DIR_LIGHTS, N_POINT_LIGHTS, N_SPOT_LIGHTS:
+ *     how many of the "LightBlock" lights are used,
+ *     from 0 to the matching MAX_*_LIGHTS.
+ *     with NORMAL_MAPPING, each light used is sent to the fragment shader
+ *     in tangent space, so a videocard with few vertex shader outputs
+ *     only fits a few of them. without it, the fragment shader
+ *     lights in world space and any number of lights fits.
+ * MAX_BONE_INFLUENCES: the bones that can move a vertex, from 1 to 4.
+ * SKINNING, NORMAL_MAPPING, INSTANCING: 1 if the feature is used, else 0.
+ *
+ * a base shader gives each define a default inside of "#ifndef",
+ * so it still builds on its own (see "light_shader.v_shader"
+ * and "light_shader.f_shader", which are the default base shaders).
+ * a "#line" directive follows the defines,
+ * so compile errors still give the lines of the file.
+ *
+ * ---
+ * a variant is built the first time it's asked for and is kept
+ * until the ShaderVariants is cleared, so materials only pay
+ * for the permutations they use. every variant is a separate
+ * shader program, so its uniforms have to be set after it's built.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include "shader.hpp"
+#include "uniform_blocks.hpp"
+
+namespace gu {
+struct ShaderKey {
+public:
+	enum FEATURE : uint8_t {
+		SKINNING = 1 << 0,
+		NORMAL_MAPPING = 1 << 1,
+		INSTANCING = 1 << 2,
+	};
+
+	// the hash of a ShaderKey, for unordered containers.
+	struct Hash {
+		size_t operator()(const ShaderKey &key) const;
+	};
+
+	// only the first light of each kind is used unless more are asked for.
+	uint8_t features = NORMAL_MAPPING;
+	uint8_t n_dir_lights = 1;
+	uint8_t n_point_lights = 1;
+	uint8_t n_spot_lights = 1;
+	uint8_t n_bone_influences = 4;
+
+	bool operator==(const ShaderKey &other) const = default;
+
+	// returns true if the key uses the <feature>.
+	inline bool has(const FEATURE &feature) const {
+		return (features & feature) != 0;
+	}
+
+	// turns the <feature> on or off.
+	inline ShaderKey &set(const FEATURE &feature, const bool &used = true) {
+		features = static_cast<uint8_t>(
+			used ? (features | feature) : (features & ~feature)
+		);
+		return *this;
+	}
+
+	// returns the "#define" lines of the key,
+	// with every count clamped to its allowed range.
+	std::string get_defines() const;
+
+	// returns the shader source code <src> with the defines of the key
+	// inserted after its "#version" line, or at its start if it has none.
+	std::string inject_into(const std::string &src) const;
+};
+
+template <typename T>
+class ShaderVariants {
+	static_assert(
+		std::is_base_of_v<Shader, T>,
+		"ShaderVariants can only build children of the Shader class."
+	);
+
+private:
+	std::filesystem::path _v_shader_path;
+	std::filesystem::path _f_shader_path;
+	std::string _v_shader_src;
+	std::string _f_shader_src;
+	std::unordered_map<
+		ShaderKey, std::unique_ptr<T>, ShaderKey::Hash
+	> _variants; // nullptr for the keys that failed to build
+
+public:
+	inline ShaderVariants() {}
+
+	ShaderVariants(const ShaderVariants &) = delete;
+	ShaderVariants &operator=(const ShaderVariants &) = delete;
+
+	// returns true if the base shader's source code was loaded
+	// from the files at <v_shader_path> and <f_shader_path>.
+	// this clears any variants built from a previous base shader.
+	bool load(
+		const std::filesystem::path &v_shader_path,
+		const std::filesystem::path &f_shader_path
+	) {
+		clear();
+		_v_shader_path = v_shader_path;
+		_f_shader_path = f_shader_path;
+		bool loaded = (
+			    Shader::load_source(_v_shader_src, v_shader_path)
+			and Shader::load_source(_f_shader_src, f_shader_path)
+			and not _v_shader_src.empty()
+			and not _f_shader_src.empty()
+		);
+		if (not loaded) {
+			std::cerr
+				<< "ShaderVariants: the base shader could not be loaded from "
+				<< v_shader_path << ", " << f_shader_path << std::endl;
+		}
+		return loaded;
+	}
+
+	// returns the variant of the base shader for the <key>,
+	// building it if it hasn't been asked for before,
+	// or returns nullptr if it failed to build.
+	// a variant that failed isn't built again until clear() is called.
+	T *get(const ShaderKey &key) {
+		auto found = _variants.find(key);
+		if (found != _variants.end())
+			return found->second.get();
+
+		std::unique_ptr<T> shader = std::make_unique<T>();
+		std::string v_shader_src = key.inject_into(_v_shader_src);
+		std::string f_shader_src = key.inject_into(_f_shader_src);
+		if (not shader->build_from_source(
+			v_shader_src.c_str(), f_shader_src.c_str()
+		)) {
+			std::cerr
+				<< "ShaderVariants: a variant of " << _v_shader_path
+				<< ", " << _f_shader_path
+				<< " failed to build with:\n" << key.get_defines()
+				<< std::endl;
+			shader.reset();
+		}
+		return _variants.emplace(key, std::move(shader)).first->second.get();
+	}
+
+	// returns the number of variants that have been asked for.
+	inline size_t get_n_variants() const { return _variants.size(); }
+
+	// deletes every variant.
+	inline void clear() { _variants.clear(); }
+};
+} // namespace gu
\ No newline at end of file
@@ -15,6 +15,6 @@ void SkyboxShader::_config_uniform_IDs() {
 	// the GL_TEXTUREx that corresponds to Material::MAP_TYPE::SKYBOX.
 	use();
 	glUniform1i(uni_skybox_texture_1i_ID, Material::MAP_TYPE::SKYBOX);
-	glUseProgram(0);
+	GLState::use_program(0);
 }
 } // namespace gu
\ No newline at end of file
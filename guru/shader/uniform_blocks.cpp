@@ -0,0 +1,205 @@
+#include "uniform_blocks.hpp"
+#include <algorithm>
+
+static_assert(sizeof(gu::UniformBlocks::CameraData) == 144);
+static_assert(sizeof(gu::UniformBlocks::DirLightData) == 48);
+static_assert(sizeof(gu::UniformBlocks::PointLightData) == 64);
+static_assert(sizeof(gu::UniformBlocks::SpotLightData) == 96);
+static_assert(sizeof(gu::UniformBlocks::ShadowData) == 624);
+
+// connects the uniform block named <block_name> in the program
+// to the <binding> point if the program uses that block.
+static void bind_block(
+	const GLuint &program_ID, const char *block_name, const GLuint &binding
+) {
+	GLuint block_index = glGetUniformBlockIndex(program_ID, block_name);
+	if (block_index != GL_INVALID_INDEX)
+		glUniformBlockBinding(program_ID, block_index, binding);
+}
+
+// copies the colors of the <light> into the given <diffuse> and <specular>.
+template <typename T>
+static void copy_light_colors(
+	T &light, glm::vec4 &diffuse, glm::vec4 &specular
+) {
+	diffuse = glm::vec4(light.get_diffuse().as_rgb(), 1.0f);
+	specular = glm::vec4(light.get_specular().as_rgb(), 1.0f);
+}
+
+// copies the attenuation factors of the <light> into the <attenuation>.
+template <typename T>
+static void copy_light_attenuation(T &light, glm::vec4 &attenuation) {
+	attenuation = glm::vec4(
+		light.get_constant().get_value(),
+		light.get_linear().get_value(),
+		light.get_quadratic().get_value(),
+		0.0f
+	);
+}
+
+namespace gu {
+GLuint UniformBlocks::_camera_UBO_ID = 0;
+GLuint UniformBlocks::_light_UBO_ID = 0;
+GLuint UniformBlocks::_shadow_UBO_ID = 0;
+UniformBlocks::LightData UniformBlocks::_lights;
+bool UniformBlocks::_lights_need_GL_update = true;
+uint64_t UniformBlocks::_dir_light_versions[MAX_DIR_LIGHTS]{};
+uint64_t UniformBlocks::_point_light_versions[MAX_POINT_LIGHTS]{};
+uint64_t UniformBlocks::_spot_light_versions[MAX_SPOT_LIGHTS]{};
+
+void UniformBlocks::bind_program(const GLuint &program_ID) {
+	bind_block(program_ID, "CameraBlock", CAMERA_BINDING);
+	bind_block(program_ID, "LightBlock", LIGHT_BINDING);
+	bind_block(program_ID, "ClusterBlock", CLUSTER_BINDING);
+	bind_block(program_ID, "ShadowBlock", SHADOW_BINDING);
+}
+
+void UniformBlocks::update_camera(const Camera &camera) {
+	_create();
+	CameraData data;
+	data.PV_mat = camera.get_projview();
+	data.skybox_mat = camera.get_skybox_mat();
+	data.view_pos = glm::vec4(
+		static_cast<glm::vec3>(camera.get_position()), 1.0f
+	);
+
+	glBindBuffer(GL_UNIFORM_BUFFER, _camera_UBO_ID);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraData), &data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBlocks::set_ambient_color(const glm::vec3 &color) {
+	_lights.ambient_color = glm::vec4(color, 1.0f);
+	_lights_need_GL_update = true;
+}
+
+void UniformBlocks::update_dir_light(
+	const size_t &index, DirLight &dir_light
+) {
+	if (
+		index >= MAX_DIR_LIGHTS
+		or _dir_light_versions[index] == dir_light.get_version()
+	)
+		return;
+
+	DirLightData &data = _lights.dir_lights[index];
+	copy_light_colors(dir_light, data.diffuse, data.specular);
+	data.direction = glm::vec4(
+		static_cast<glm::vec3>(dir_light.get_forward()), 0.0f
+	);
+	_dir_light_versions[index] = dir_light.get_version();
+	_lights_need_GL_update = true;
+}
+
+void UniformBlocks::update_point_light(
+	const size_t &index, PointLight &point_light
+) {
+	if (
+		index >= MAX_POINT_LIGHTS
+		or _point_light_versions[index] == point_light.get_version()
+	)
+		return;
+
+	PointLightData &data = _lights.point_lights[index];
+	copy_light_colors(point_light, data.diffuse, data.specular);
+	copy_light_attenuation(point_light, data.attenuation);
+	data.position = glm::vec4(
+		static_cast<glm::vec3>(point_light.get_position()), 1.0f
+	);
+	_point_light_versions[index] = point_light.get_version();
+	_lights_need_GL_update = true;
+}
+
+void UniformBlocks::update_spot_light(
+	const size_t &index, SpotLight &spot_light
+) {
+	if (
+		index >= MAX_SPOT_LIGHTS
+		or _spot_light_versions[index] == spot_light.get_version()
+	)
+		return;
+
+	SpotLightData &data = _lights.spot_lights[index];
+	copy_light_colors(spot_light, data.diffuse, data.specular);
+	copy_light_attenuation(spot_light, data.attenuation);
+	data.position = glm::vec4(
+		static_cast<glm::vec3>(spot_light.get_position()), 1.0f
+	);
+	data.direction = glm::vec4(
+		static_cast<glm::vec3>(spot_light.get_forward()), 0.0f
+	);
+	data.cutoffs = glm::vec4(
+		spot_light.get_inner_cutoff().get_value(),
+		spot_light.get_outer_cutoff().get_value(),
+		0.0f,
+		0.0f
+	);
+	_spot_light_versions[index] = spot_light.get_version();
+	_lights_need_GL_update = true;
+}
+
+void UniformBlocks::upload_lights() {
+	if (not _lights_need_GL_update)
+		return;
+
+	_create();
+	glBindBuffer(GL_UNIFORM_BUFFER, _light_UBO_ID);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightData), &_lights);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	_lights_need_GL_update = false;
+}
+
+void UniformBlocks::bind_no_shadows() {
+	_create();
+	glBindBufferBase(GL_UNIFORM_BUFFER, SHADOW_BINDING, _shadow_UBO_ID);
+}
+
+void UniformBlocks::deallocate() {
+	if (_camera_UBO_ID != 0)
+		glDeleteBuffers(1, &_camera_UBO_ID);
+	if (_light_UBO_ID != 0)
+		glDeleteBuffers(1, &_light_UBO_ID);
+	if (_shadow_UBO_ID != 0)
+		glDeleteBuffers(1, &_shadow_UBO_ID);
+	_camera_UBO_ID = 0;
+	_light_UBO_ID = 0;
+	_shadow_UBO_ID = 0;
+	_lights_need_GL_update = true;
+
+	// the lights are copied again for the next "LightBlock".
+	std::fill_n(_dir_light_versions, MAX_DIR_LIGHTS, 0);
+	std::fill_n(_point_light_versions, MAX_POINT_LIGHTS, 0);
+	std::fill_n(_spot_light_versions, MAX_SPOT_LIGHTS, 0);
+}
+
+void UniformBlocks::_create() {
+	if (_camera_UBO_ID != 0)
+		return;
+
+	// each buffer stays bound to its binding point for the whole program.
+	glGenBuffers(1, &_camera_UBO_ID);
+	glBindBuffer(GL_UNIFORM_BUFFER, _camera_UBO_ID);
+	glBufferData(
+		GL_UNIFORM_BUFFER, sizeof(CameraData), nullptr, GL_DYNAMIC_DRAW
+	);
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, _camera_UBO_ID);
+
+	glGenBuffers(1, &_light_UBO_ID);
+	glBindBuffer(GL_UNIFORM_BUFFER, _light_UBO_ID);
+	glBufferData(
+		GL_UNIFORM_BUFFER, sizeof(LightData), &_lights, GL_DYNAMIC_DRAW
+	);
+	glBindBufferBase(GL_UNIFORM_BUFFER, LIGHT_BINDING, _light_UBO_ID);
+
+	// the zeroed matrices of a default ShadowData don't matter,
+	// since its counts of 0 turn the shadows off.
+	ShadowData no_shadows;
+	glGenBuffers(1, &_shadow_UBO_ID);
+	glBindBuffer(GL_UNIFORM_BUFFER, _shadow_UBO_ID);
+	glBufferData(
+		GL_UNIFORM_BUFFER, sizeof(ShadowData), &no_shadows, GL_STATIC_DRAW
+	);
+	glBindBufferBase(GL_UNIFORM_BUFFER, SHADOW_BINDING, _shadow_UBO_ID);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * uniform_blocks.hpp
+ * ---
+ * this file defines the UniformBlocks struct, which holds the std140
+ * uniform buffer objects for the per-frame camera and light data.
+ * the buffers are bound at fixed binding points that are shared
+ * by every ModelShader, so the data is sent to the videocard once
+ * no matter how many shader programs read it.
+ *
+ * ---
+ * a shader reads the buffers by declaring the blocks:
+ *
+ * layout (std140) uniform CameraBlock {
+ *     mat4 _PV_mat;
+ *     mat4 _skybox_mat;
+ *     vec4 _view_pos; // .xyz is used
+ * };
+ *
+ * layout (std140) uniform LightBlock {
+ *     vec4 _ambient_color; // .rgb is used
+ *     DirLight _dir_lights[MAX_DIR_LIGHTS];
+ *     PointLight _point_lights[MAX_POINT_LIGHTS];
+ *     SpotLight _spot_lights[MAX_SPOT_LIGHTS];
+ * };
+ *
+ * with the light structs being laid out like the ones below
+ * (see "light_shader.f_shader").
+ * the "ClusterBlock" of a LightClusters is bound to the CLUSTER_BINDING.
+ *
+ * ---
+ * the "ShadowBlock" is bound to the SHADOW_BINDING:
+ *
+ * layout (std140) uniform ShadowBlock {
+ *     mat4 _shadow_view_mat; // of the Camera the cascades were fit to
+ *     mat4 _cascade_mats[N_CASCADES];
+ *     vec4 _cascade_splits; // view depth where each cascade ends
+ *     mat4 _spot_shadow_mats[MAX_SPOT_SHADOWS];
+ *     ivec4 _shadow_info; // n cascades, n spot maps, shadowed DirLight
+ *     vec4 _shadow_bias; // depth bias, normal offset
+ * };
+ *
+ * until a ShadowMaps binds its own, the bound "ShadowBlock" is all zeros,
+ * so shaders that read it don't draw any shadows.
+ *
+ */
+
+#pragma once
+#include <glad/gl.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include "../environment/camera.hpp"
+#include "../environment/lights.hpp"
+
+namespace gu {
+struct UniformBlocks {
+public:
+	static constexpr GLuint CAMERA_BINDING = 0; // "CameraBlock"
+	static constexpr GLuint LIGHT_BINDING = 1; // "LightBlock"
+	static constexpr GLuint CLUSTER_BINDING = 2; // "ClusterBlock"
+	static constexpr GLuint SHADOW_BINDING = 3; // "ShadowBlock"
+	static const size_t MAX_DIR_LIGHTS = 4;
+	static const size_t MAX_POINT_LIGHTS = 8;
+	static const size_t MAX_SPOT_LIGHTS = 4;
+	static const size_t N_CASCADES = 4;
+	static const size_t MAX_SPOT_SHADOWS = 4;
+
+	// these structs match the std140 layout of the blocks in GLSL.
+	// every member is a vec4 or a mat4, so no padding is needed.
+	struct CameraData {
+		glm::mat4 PV_mat = glm::mat4(1.0f);
+		glm::mat4 skybox_mat = glm::mat4(1.0f);
+		glm::vec4 view_pos = glm::vec4(0.0f);
+	};
+
+	// the slots that no light has been copied into are black,
+	// and their directions and attenuation still give finite results.
+	struct DirLightData {
+		glm::vec4 direction = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);
+		glm::vec4 diffuse = glm::vec4(0.0f);
+		glm::vec4 specular = glm::vec4(0.0f);
+	};
+
+	struct PointLightData {
+		glm::vec4 position = glm::vec4(0.0f);
+		glm::vec4 diffuse = glm::vec4(0.0f);
+		glm::vec4 specular = glm::vec4(0.0f);
+		glm::vec4 attenuation = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f); // c, l, q
+	};
+
+	struct SpotLightData {
+		glm::vec4 position = glm::vec4(0.0f);
+		glm::vec4 direction = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);
+		glm::vec4 diffuse = glm::vec4(0.0f);
+		glm::vec4 specular = glm::vec4(0.0f);
+		glm::vec4 attenuation = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f); // c, l, q
+		glm::vec4 cutoffs = glm::vec4(0.0f); // inner, outer
+	};
+
+	struct LightData {
+		glm::vec4 ambient_color = glm::vec4(0.0f);
+		DirLightData dir_lights[MAX_DIR_LIGHTS];
+		PointLightData point_lights[MAX_POINT_LIGHTS];
+		SpotLightData spot_lights[MAX_SPOT_LIGHTS];
+	};
+
+	struct ShadowData {
+		glm::mat4 view_mat = glm::mat4(1.0f);
+		glm::mat4 cascade_mats[N_CASCADES];
+		glm::vec4 cascade_splits = glm::vec4(0.0f);
+		glm::mat4 spot_mats[MAX_SPOT_SHADOWS];
+		glm::ivec4 info = glm::ivec4(0); // n cascades, n spots, DirLight
+		glm::vec4 bias = glm::vec4(0.0f); // depth, normal offset
+	};
+
+private:
+	static GLuint _camera_UBO_ID;
+	static GLuint _light_UBO_ID;
+	static GLuint _shadow_UBO_ID; // all zeros, for when there's no ShadowMaps
+	static LightData _lights; // copy of what's sent to the videocard
+	static bool _lights_need_GL_update;
+
+	// the version of the light last copied into each slot,
+	// or 0 if nothing has been copied into it.
+	static uint64_t _dir_light_versions[MAX_DIR_LIGHTS];
+	static uint64_t _point_light_versions[MAX_POINT_LIGHTS];
+	static uint64_t _spot_light_versions[MAX_SPOT_LIGHTS];
+
+	// instances of this struct cannot be created.
+	UniformBlocks() = delete;
+
+public:
+	// connects the "CameraBlock", "LightBlock", "ClusterBlock"
+	// and "ShadowBlock" of the given shader program
+	// to the shared binding points, if the program uses them.
+	static void bind_program(const GLuint &program_ID);
+
+	// sends the matrices and position of the <camera> to the videocard.
+	// this should be called once per frame for the Camera being drawn.
+	static void update_camera(const Camera &camera);
+
+	// sets the omnipresent color in the "LightBlock".
+	static void set_ambient_color(const glm::vec3 &color);
+
+	// copies the <dir_light> into the slot at <index> of the "LightBlock"
+	// if its version is different from the one last copied there.
+	static void update_dir_light(const size_t &index, DirLight &dir_light);
+
+	// copies the <point_light> into the slot at <index> of the "LightBlock"
+	// if its version is different from the one last copied there.
+	static void update_point_light(
+		const size_t &index, PointLight &point_light
+	);
+
+	// copies the <spot_light> into the slot at <index> of the "LightBlock"
+	// if its version is different from the one last copied there.
+	static void update_spot_light(const size_t &index, SpotLight &spot_light);
+
+	// sends the "LightBlock" to the videocard if it was modified.
+	// this is called by the draw functions before drawing,
+	// so the lights are sent at most once per frame.
+	static void upload_lights();
+
+	// binds the "ShadowBlock" of all zeros, which turns off shadows.
+	static void bind_no_shadows();
+
+	// deletes the uniform buffer objects.
+	static void deallocate();
+
+private:
+	// creates the uniform buffer objects if they don't exist yet.
+	static void _create();
+};
+} // namespace gu
\ No newline at end of file
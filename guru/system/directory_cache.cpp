@@ -0,0 +1,52 @@
+#include "directory_cache.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace gu {
+std::unordered_map<std::string, std::unordered_set<std::string>> DirectoryCache::_dir_to_files;
+std::mutex DirectoryCache::_mutex;
+
+// returns the given file or directory name in the form it's compared by.
+// file names are case-insensitive on Windows.
+static std::string to_key(const std::filesystem::path &name) {
+	std::string key = name.generic_string();
+	#if defined(_WIN32)
+	std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) {
+		return static_cast<char>(std::tolower(c));
+	});
+	#endif
+	return key;
+}
+
+bool DirectoryCache::contains(const std::filesystem::path &path) {
+	if (path.empty() or not path.has_filename())
+		return false;
+	std::filesystem::path directory = path.parent_path();
+	if (directory.empty())
+		directory = ".";
+	std::string dir_key = to_key(directory);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto iter = _dir_to_files.find(dir_key);
+	if (iter == _dir_to_files.end()) {
+		// lists the directory's regular files for the first time.
+		std::unordered_set<std::string> files;
+		std::error_code error;
+		for (
+			std::filesystem::directory_iterator entry(directory, error), end;
+			not error and entry != end;
+			entry.increment(error)
+		) {
+			if (entry->is_regular_file(error))
+				files.insert(to_key(entry->path().filename()));
+		}
+		iter = _dir_to_files.emplace(dir_key, std::move(files)).first;
+	}
+	return iter->second.count(to_key(path.filename())) > 0;
+}
+
+void DirectoryCache::clear() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_dir_to_files.clear();
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ * directory_cache.hpp
+ * ---
+ * this file defines the DirectoryCache struct, which lists the files
+ * of a directory the first time it's searched and then answers
+ * whether a file exists from that listing,
+ * so that searching for many possible image names
+ * doesn't have to ask the filesystem every time.
+ *
+ * ---
+ * files added to a directory after it's been listed won't be found
+ * until DirectoryCache::clear() is called.
+ * this can be used from any thread.
+ *
+ */
+
+#pragma once
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gu {
+struct DirectoryCache {
+private:
+	// maps a directory to the names of the files it contains.
+	static std::unordered_map<std::string, std::unordered_set<std::string>> _dir_to_files;
+	static std::mutex _mutex;
+
+	// instances of this struct cannot be created.
+	DirectoryCache() = delete;
+
+public:
+	// returns true if a file exists at the given <path>.
+	static bool contains(const std::filesystem::path &path);
+
+	// forgets every directory listing.
+	static void clear();
+};
+} // namespace gu
\ No newline at end of file
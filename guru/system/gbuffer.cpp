@@ -0,0 +1,112 @@
+#include "gbuffer.hpp"
+#include <iostream>
+#include "gl_state.hpp"
+
+// the internal format, format and type of each attachment's texture.
+static const GLenum INTERNAL_FORMATS[gu::GBuffer::N_ATTACHMENTS] = {
+	GL_RGBA8, GL_RGBA16F, GL_RG8, GL_DEPTH24_STENCIL8
+};
+static const GLenum FORMATS[gu::GBuffer::N_ATTACHMENTS] = {
+	GL_RGBA, GL_RGBA, GL_RG, GL_DEPTH_STENCIL
+};
+static const GLenum TYPES[gu::GBuffer::N_ATTACHMENTS] = {
+	GL_UNSIGNED_BYTE, GL_FLOAT, GL_UNSIGNED_BYTE, GL_UNSIGNED_INT_24_8
+};
+
+namespace gu {
+GBuffer::~GBuffer() {
+	deallocate();
+}
+
+bool GBuffer::create(const int &width, const int &height) {
+	if (width <= 0 or height <= 0)
+		return false;
+	deallocate();
+
+	glGenFramebuffers(1, &_framebuffer_ID);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _framebuffer_ID);
+
+	// creates each texture and attaches it to the framebuffer.
+	// the textures are read one texel per pixel, so they aren't filtered.
+	_width = static_cast<GLsizei>(width);
+	_height = static_cast<GLsizei>(height);
+	glGenTextures(N_ATTACHMENTS, _texture_IDs);
+	for (uint8_t i = 0; i < N_ATTACHMENTS; ++i) {
+		GLState::bind_texture(GL_TEXTURE_2D, _texture_IDs[i]);
+		glTexImage2D(
+			GL_TEXTURE_2D,
+			0,
+			INTERNAL_FORMATS[i],
+			_width,
+			_height,
+			0,
+			FORMATS[i],
+			TYPES[i],
+			nullptr
+		);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		GLenum attachment = (
+			i == DEPTH ? GL_DEPTH_STENCIL_ATTACHMENT : GL_COLOR_ATTACHMENT0 + i
+		);
+		glFramebufferTexture2D(
+			GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, _texture_IDs[i], 0
+		);
+	}
+	GLState::bind_texture(GL_TEXTURE_2D, 0);
+
+	static const GLenum DRAW_BUFFERS[3] = {
+		GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2
+	};
+	glDrawBuffers(3, DRAW_BUFFERS);
+
+	// checks if the build was successful.
+	GLenum buffer_status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
+	if (buffer_status != GL_FRAMEBUFFER_COMPLETE) {
+		std::cerr
+			<< "GBuffer: the Framebuffer of "
+			<< "<_framebuffer_ID> failed to be created."
+			<< std::endl;
+		return false;
+	}
+	return true;
+}
+
+void GBuffer::bind_and_clear() {
+	// the albedo's alpha of 0 marks pixels that nothing was drawn to.
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _framebuffer_ID);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(
+		  GL_COLOR_BUFFER_BIT
+		| GL_DEPTH_BUFFER_BIT
+		| GL_STENCIL_BUFFER_BIT
+	);
+	GLState::set_depth_test(true);
+	GLState::set_blend(false);
+}
+
+void GBuffer::bind_textures(const GLuint &first_unit) const {
+	for (uint8_t i = 0; i < N_ATTACHMENTS; ++i)
+		GLState::bind_texture(first_unit + i, GL_TEXTURE_2D, _texture_IDs[i]);
+}
+
+void GBuffer::deallocate() {
+	for (uint8_t i = 0; i < N_ATTACHMENTS; ++i) {
+		if (_texture_IDs[i] != 0) {
+			glDeleteTextures(1, &_texture_IDs[i]);
+			GLState::forget_texture(_texture_IDs[i]);
+		}
+		_texture_IDs[i] = 0;
+	}
+
+	if (_framebuffer_ID != 0) {
+		glDeleteFramebuffers(1, &_framebuffer_ID);
+		GLState::forget_framebuffer(_framebuffer_ID);
+	}
+	_framebuffer_ID = 0;
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * gbuffer.hpp
+ * ---
+ * this file defines the GBuffer class, which is a variant of
+ * the Screenbuffer that the opaque geometry is rendered to
+ * when deferred shading is used. instead of lit colors,
+ * it keeps the attributes of the nearest surface at every pixel,
+ * which are lit afterwards by the DeferredRenderer.
+ *
+ * ---
+ * the attachments are:
+ * 0: albedo (GL_RGBA8), with .rgb being the diffuse color.
+ * 1: normal (GL_RGBA16F), with .xyz being the world-space normal.
+ * 2: material (GL_RG8), with .r being the metallic (specular) strength
+ *    and .g being the roughness.
+ * depth: GL_DEPTH24_STENCIL8, which can be sampled.
+ *
+ * a shader writing to the GBuffer declares:
+ *
+ * layout (location = 0) out vec4 g_albedo;
+ * layout (location = 1) out vec4 g_normal;
+ * layout (location = 2) out vec4 g_material;
+ *
+ * (see "gbuffer_shader.f_shader").
+ * the GBuffer isn't multisampled.
+ *
+ */
+
+#pragma once
+#include <stdint.h>
+#include <glad/gl.h>
+
+namespace gu {
+struct GBuffer {
+public:
+	enum ATTACHMENT : uint8_t {
+		ALBEDO,
+		NORMAL,
+		MATERIAL,
+		DEPTH,
+		N_ATTACHMENTS,
+	};
+
+private:
+	GLsizei _width = 640;
+	GLsizei _height = 480;
+	GLuint _framebuffer_ID = 0;
+	GLuint _texture_IDs[N_ATTACHMENTS]{};
+
+public:
+	// dtor. deletes resources.
+	~GBuffer();
+	inline const GLsizei &get_width() const { return _width; }
+	inline const GLsizei &get_height() const { return _height; }
+
+	// returns the framebuffer ID.
+	inline const GLuint &get_ID() const { return _framebuffer_ID; }
+
+	// returns the ID of the texture of the given <attachment>.
+	inline const GLuint &get_texture_ID(const ATTACHMENT &attachment) const {
+		return _texture_IDs[attachment];
+	}
+
+	// allocates the textures and framebuffer of the GBuffer object.
+	// this will destroy any pre-existing resources.
+	bool create(const int &width, const int &height);
+
+	// clears and binds the GBuffer so that its attachments are drawn to.
+	void bind_and_clear();
+
+	// binds the textures of the attachments to the texture units
+	// from <first_unit> onward, in the order of the ATTACHMENTs.
+	void bind_textures(const GLuint &first_unit) const;
+
+	// deletes the textures and framebuffer.
+	void deallocate();
+};
+} // namespace gu
\ No newline at end of file
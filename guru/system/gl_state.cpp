@@ -0,0 +1,253 @@
+#include "gl_state.hpp"
+
+// marks a piece of shadowed state whose real value isn't known.
+static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+// returns the index of the <target> in a texture unit's tracked targets,
+// or -1 if the <target> isn't tracked.
+static int get_texture_target_index(const GLenum &target) {
+	switch (target) {
+	case GL_TEXTURE_2D: return 0;
+	case GL_TEXTURE_CUBE_MAP: return 1;
+	case GL_TEXTURE_2D_MULTISAMPLE: return 2;
+	case GL_TEXTURE_BUFFER: return 3;
+	case GL_TEXTURE_2D_ARRAY: return 4;
+	default: return -1;
+	}
+}
+
+// returns true if the shadowed <value> has to be changed to <new_value>,
+// which is then set. the call is counted as issued or suppressed.
+template <typename T>
+static bool needs_change(
+	T &value, const T &new_value, size_t &n_issued, size_t &n_suppressed
+) {
+	if (value == new_value) {
+		++n_suppressed;
+		return false;
+	}
+	value = new_value;
+	++n_issued;
+	return true;
+}
+
+// enables or disables the <capability> if it differs from <enabled>.
+static void set_capability(
+	const GLenum &capability,
+	GLint &enabled,
+	const bool &new_enabled,
+	size_t &n_issued,
+	size_t &n_suppressed
+) {
+	if (needs_change(enabled, GLint(new_enabled), n_issued, n_suppressed)) {
+		if (new_enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+}
+
+namespace gu {
+// returns the texture IDs of every tracked target of every texture unit
+// with each of them set as unknown.
+static std::array<
+	std::array<GLuint, GLState::N_TEXTURE_TARGETS>, GLState::MAX_TEXTURE_UNITS
+> make_unknown_texture_IDs() {
+	std::array<
+		std::array<GLuint, GLState::N_TEXTURE_TARGETS>,
+		GLState::MAX_TEXTURE_UNITS
+	> texture_IDs;
+	for (auto &unit_IDs : texture_IDs)
+		unit_IDs.fill(UNKNOWN);
+	return texture_IDs;
+}
+
+GLuint GLState::_program_ID = UNKNOWN;
+GLuint GLState::_VAO_ID = UNKNOWN;
+GLuint GLState::_active_unit = UNKNOWN;
+std::array<
+	std::array<GLuint, GLState::N_TEXTURE_TARGETS>, GLState::MAX_TEXTURE_UNITS
+> GLState::_texture_IDs = make_unknown_texture_IDs();
+GLuint GLState::_read_framebuffer_ID = UNKNOWN;
+GLuint GLState::_draw_framebuffer_ID = UNKNOWN;
+GLint GLState::_cull_face_enabled = -1;
+GLenum GLState::_cull_face_mode = UNKNOWN;
+GLint GLState::_depth_test_enabled = -1;
+GLenum GLState::_depth_func = UNKNOWN;
+GLint GLState::_blend_enabled = -1;
+GLenum GLState::_blend_src_factor = UNKNOWN;
+GLenum GLState::_blend_dst_factor = UNKNOWN;
+GLint GLState::_stencil_test_enabled = -1;
+size_t GLState::_n_issued = 0;
+size_t GLState::_n_suppressed = 0;
+
+void GLState::invalidate() {
+	_program_ID = UNKNOWN;
+	_VAO_ID = UNKNOWN;
+	_active_unit = UNKNOWN;
+	_texture_IDs = make_unknown_texture_IDs();
+	_read_framebuffer_ID = UNKNOWN;
+	_draw_framebuffer_ID = UNKNOWN;
+	_cull_face_enabled = -1;
+	_cull_face_mode = UNKNOWN;
+	_depth_test_enabled = -1;
+	_depth_func = UNKNOWN;
+	_blend_enabled = -1;
+	_blend_src_factor = UNKNOWN;
+	_blend_dst_factor = UNKNOWN;
+	_stencil_test_enabled = -1;
+}
+
+void GLState::use_program(const GLuint &program_ID) {
+	if (needs_change(_program_ID, program_ID, _n_issued, _n_suppressed))
+		glUseProgram(program_ID);
+}
+
+void GLState::bind_VAO(const GLuint &VAO_ID) {
+	if (needs_change(_VAO_ID, VAO_ID, _n_issued, _n_suppressed))
+		glBindVertexArray(VAO_ID);
+}
+
+void GLState::set_active_texture_unit(const GLuint &unit) {
+	if (needs_change(_active_unit, unit, _n_issued, _n_suppressed))
+		glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::bind_texture(
+	const GLuint &unit, const GLenum &target, const GLuint &texture_ID
+) {
+	int target_index = get_texture_target_index(target);
+	if (unit >= MAX_TEXTURE_UNITS or target_index < 0) {
+		set_active_texture_unit(unit);
+		glBindTexture(target, texture_ID);
+		++_n_issued;
+		return;
+	}
+
+	GLuint &bound_ID = _texture_IDs[unit][target_index];
+	if (needs_change(bound_ID, texture_ID, _n_issued, _n_suppressed)) {
+		set_active_texture_unit(unit);
+		glBindTexture(target, texture_ID);
+	}
+}
+
+void GLState::bind_texture(const GLenum &target, const GLuint &texture_ID) {
+	if (_active_unit == UNKNOWN)
+		set_active_texture_unit(0);
+	bind_texture(_active_unit, target, texture_ID);
+}
+
+void GLState::bind_framebuffer(
+	const GLenum &target, const GLuint &framebuffer_ID
+) {
+	if (target == GL_READ_FRAMEBUFFER) {
+		if (
+			needs_change(
+				_read_framebuffer_ID, framebuffer_ID, _n_issued, _n_suppressed
+			)
+		)
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer_ID);
+	} else if (target == GL_DRAW_FRAMEBUFFER) {
+		if (
+			needs_change(
+				_draw_framebuffer_ID, framebuffer_ID, _n_issued, _n_suppressed
+			)
+		)
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer_ID);
+	} else if (
+		    _read_framebuffer_ID == framebuffer_ID
+		and _draw_framebuffer_ID == framebuffer_ID
+	) {
+		++_n_suppressed;
+	} else {
+		glBindFramebuffer(target, framebuffer_ID);
+		_read_framebuffer_ID = framebuffer_ID;
+		_draw_framebuffer_ID = framebuffer_ID;
+		++_n_issued;
+	}
+}
+
+void GLState::set_cull_face(const GLenum &cull_option) {
+	bool enabled = cull_option != GL_NONE;
+	set_capability(
+		GL_CULL_FACE, _cull_face_enabled, enabled, _n_issued, _n_suppressed
+	);
+	if (
+		    enabled
+		and needs_change(_cull_face_mode, cull_option, _n_issued, _n_suppressed)
+	)
+		glCullFace(cull_option);
+}
+
+void GLState::set_depth_test(const bool &enabled) {
+	set_capability(
+		GL_DEPTH_TEST, _depth_test_enabled, enabled, _n_issued, _n_suppressed
+	);
+}
+
+void GLState::set_depth_func(const GLenum &func) {
+	if (needs_change(_depth_func, func, _n_issued, _n_suppressed))
+		glDepthFunc(func);
+}
+
+void GLState::set_blend(const bool &enabled) {
+	set_capability(
+		GL_BLEND, _blend_enabled, enabled, _n_issued, _n_suppressed
+	);
+}
+
+void GLState::set_blend_func(
+	const GLenum &src_factor, const GLenum &dst_factor
+) {
+	if (
+		    _blend_src_factor == src_factor
+		and _blend_dst_factor == dst_factor
+	) {
+		++_n_suppressed;
+		return;
+	}
+	glBlendFunc(src_factor, dst_factor);
+	_blend_src_factor = src_factor;
+	_blend_dst_factor = dst_factor;
+	++_n_issued;
+}
+
+void GLState::set_stencil_test(const bool &enabled) {
+	set_capability(
+		GL_STENCIL_TEST,
+		_stencil_test_enabled,
+		enabled,
+		_n_issued,
+		_n_suppressed
+	);
+}
+
+void GLState::forget_program(const GLuint &program_ID) {
+	if (_program_ID == program_ID)
+		_program_ID = UNKNOWN;
+}
+
+void GLState::forget_VAO(const GLuint &VAO_ID) {
+	if (_VAO_ID == VAO_ID)
+		_VAO_ID = 0;
+}
+
+void GLState::forget_texture(const GLuint &texture_ID) {
+	for (auto &unit_IDs : _texture_IDs)
+		for (auto &bound_ID : unit_IDs)
+			if (bound_ID == texture_ID)
+				bound_ID = 0;
+}
+
+void GLState::forget_framebuffer(const GLuint &framebuffer_ID) {
+	if (_read_framebuffer_ID == framebuffer_ID)
+		_read_framebuffer_ID = 0;
+	if (_draw_framebuffer_ID == framebuffer_ID)
+		_draw_framebuffer_ID = 0;
+}
+
+void GLState::reset_counters() {
+	_n_issued = 0;
+	_n_suppressed = 0;
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,123 @@
+/**
+ * gl_state.hpp
+ * ---
+ * this file defines the GLState struct, which shadows the OpenGL state
+ * that Guru changes while drawing (the bound program, VAO, textures,
+ * framebuffers, and the face culling, depth and blend settings),
+ * so that calls which wouldn't change anything are skipped.
+ *
+ * ---
+ * every OpenGL call that changes this state should go through GLState.
+ * if the state is changed by code outside of Guru,
+ * then GLState::invalidate() should be called afterwards.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <stdint.h>
+#include <glad/gl.h>
+
+namespace gu {
+struct GLState {
+public:
+	// the number of texture units whose bindings are tracked.
+	static const GLuint MAX_TEXTURE_UNITS = 16;
+
+	// the number of texture targets that are tracked per texture unit:
+	// GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_MULTISAMPLE,
+	// GL_TEXTURE_BUFFER and GL_TEXTURE_2D_ARRAY.
+	static const size_t N_TEXTURE_TARGETS = 5;
+
+private:
+
+	static GLuint _program_ID;
+	static GLuint _VAO_ID;
+	static GLuint _active_unit;
+	static std::array<
+		std::array<GLuint, N_TEXTURE_TARGETS>, MAX_TEXTURE_UNITS
+	> _texture_IDs;
+	static GLuint _read_framebuffer_ID;
+	static GLuint _draw_framebuffer_ID;
+	static GLint _cull_face_enabled; // -1 if unknown
+	static GLenum _cull_face_mode;
+	static GLint _depth_test_enabled; // -1 if unknown
+	static GLenum _depth_func;
+	static GLint _blend_enabled; // -1 if unknown
+	static GLenum _blend_src_factor;
+	static GLenum _blend_dst_factor;
+	static GLint _stencil_test_enabled; // -1 if unknown
+	static size_t _n_issued; // calls passed on to OpenGL
+	static size_t _n_suppressed; // calls skipped for changing nothing
+
+	// instances of this struct cannot be created.
+	GLState() = delete;
+
+public:
+	// forgets all of the shadowed state,
+	// so that the next call of every kind is passed on to OpenGL.
+	static void invalidate();
+
+	// calls glUseProgram(...) if the <program_ID> isn't in use.
+	static void use_program(const GLuint &program_ID);
+
+	// calls glBindVertexArray(...) if the <VAO_ID> isn't bound.
+	static void bind_VAO(const GLuint &VAO_ID);
+
+	// calls glActiveTexture(...) if the <unit> isn't active.
+	static void set_active_texture_unit(const GLuint &unit);
+
+	// binds the <texture_ID> to the <target> of the given texture <unit>.
+	static void bind_texture(
+		const GLuint &unit, const GLenum &target, const GLuint &texture_ID
+	);
+
+	// binds the <texture_ID> to the <target> of the active texture unit.
+	// this is used when creating and uploading textures.
+	static void bind_texture(const GLenum &target, const GLuint &texture_ID);
+
+	// binds the <framebuffer_ID> to GL_FRAMEBUFFER,
+	// GL_READ_FRAMEBUFFER or GL_DRAW_FRAMEBUFFER.
+	static void bind_framebuffer(
+		const GLenum &target, const GLuint &framebuffer_ID
+	);
+
+	// sets the face culling option to GL_FRONT, GL_BACK, or GL_NONE,
+	// with GL_NONE disabling GL_CULL_FACE.
+	static void set_cull_face(const GLenum &cull_option);
+
+	// enables or disables GL_DEPTH_TEST.
+	static void set_depth_test(const bool &enabled);
+
+	// calls glDepthFunc(...) if the <func> isn't already used.
+	static void set_depth_func(const GLenum &func);
+
+	// enables or disables GL_BLEND.
+	static void set_blend(const bool &enabled);
+
+	// calls glBlendFunc(...) if the factors aren't already used.
+	static void set_blend_func(
+		const GLenum &src_factor, const GLenum &dst_factor
+	);
+
+	// enables or disables GL_STENCIL_TEST.
+	static void set_stencil_test(const bool &enabled);
+
+	// these are called after the given object has been deleted,
+	// since OpenGL reverts the bindings of a deleted object to 0.
+	static void forget_program(const GLuint &program_ID);
+	static void forget_VAO(const GLuint &VAO_ID);
+	static void forget_texture(const GLuint &texture_ID);
+	static void forget_framebuffer(const GLuint &framebuffer_ID);
+
+	// returns the number of calls that were passed on to OpenGL.
+	inline static size_t get_n_issued() { return _n_issued; }
+
+	// returns the number of calls that were skipped
+	// because they wouldn't have changed anything.
+	inline static size_t get_n_suppressed() { return _n_suppressed; }
+
+	// sets the issued and suppressed counts back to 0.
+	static void reset_counters();
+};
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "gl_task_queue.hpp"
+#include "settings.hpp"
+
+namespace gu {
+std::deque<std::function<void()>> GLTaskQueue::_tasks;
+std::mutex GLTaskQueue::_mutex;
+
+void GLTaskQueue::push(std::function<void()> task) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_tasks.push_back(std::move(task));
+}
+
+void GLTaskQueue::run(const double &budget) {
+	double start_time = glfwGetTime();
+	do {
+		std::function<void()> task;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_tasks.empty())
+				return;
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+
+		// the lock is released before running the task,
+		// since a task is allowed to push more tasks.
+		task();
+	} while (glfwGetTime() - start_time < budget);
+}
+
+void GLTaskQueue::clear() {
+	std::deque<std::function<void()>> tasks;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		tasks.swap(_tasks);
+	}
+}
+
+size_t GLTaskQueue::get_n_pending() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _tasks.size();
+}
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,43 @@
+/**
+ * gl_task_queue.hpp
+ * ---
+ * this file defines the GLTaskQueue struct, which holds tasks
+ * that have to be run on the main thread (e.g. OpenGL calls)
+ * but were queued from other threads.
+ * the queue is run by env::poll_events_and_update_delta()
+ * for, at most, Settings::get_GL_upload_budget() seconds per frame.
+ *
+ */
+
+#pragma once
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace gu {
+struct GLTaskQueue {
+private:
+	static std::deque<std::function<void()>> _tasks;
+	static std::mutex _mutex;
+
+	// instances of this struct cannot be created.
+	GLTaskQueue() = delete;
+
+public:
+	// queues the given <task> to be run on the main thread.
+	// this can be called from any thread.
+	static void push(std::function<void()> task);
+
+	// runs queued tasks in the order they were pushed
+	// until the queue is empty or <budget> seconds have passed.
+	// at least one task is always run so that the queue can't stall.
+	// this must be called from the main thread.
+	static void run(const double &budget);
+
+	// discards every queued task.
+	static void clear();
+
+	// returns the number of tasks that haven't been run yet.
+	static size_t get_n_pending();
+};
+} // namespace gu
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "mapped_file.hpp"
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gu {
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(const std::filesystem::path &path) {
+	close();
+
+	#if defined(_WIN32)
+	HANDLE file = CreateFileW(
+		path.wstring().c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size;
+	if (not GetFileSizeEx(file, &file_size) or file_size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW(
+		file, nullptr, PAGE_READONLY, 0, 0, nullptr
+	);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return false;
+	}
+
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	_file_handle = file;
+	_mapping_handle = mapping;
+	_data = static_cast<const char *>(view);
+	_size = static_cast<size_t>(file_size.QuadPart);
+	return true;
+
+	#elif defined(__linux__)
+	int file_descriptor = ::open(path.string().c_str(), O_RDONLY);
+	if (file_descriptor < 0)
+		return false;
+
+	struct stat file_stat;
+	if (fstat(file_descriptor, &file_stat) != 0 or file_stat.st_size == 0) {
+		::close(file_descriptor);
+		return false;
+	}
+
+	void *view = mmap(
+		nullptr,
+		static_cast<size_t>(file_stat.st_size),
+		PROT_READ,
+		MAP_PRIVATE,
+		file_descriptor,
+		0
+	);
+	if (view == MAP_FAILED) {
+		::close(file_descriptor);
+		return false;
+	}
+	_file_descriptor = file_descriptor;
+	_data = static_cast<const char *>(view);
+	_size = static_cast<size_t>(file_stat.st_size);
+	return true;
+
+	#else
+	return false;
+	#endif
+}
+
+void MappedFile::close() {
+	#if defined(_WIN32)
+	if (_data)
+		UnmapViewOfFile(_data);
+	if (_mapping_handle)
+		CloseHandle(_mapping_handle);
+	if (_file_handle)
+		CloseHandle(_file_handle);
+	_mapping_handle = nullptr;
+	_file_handle = nullptr;
+
+	#elif defined(__linux__)
+	if (_data)
+		munmap(const_cast<char *>(_data), _size);
+	if (_file_descriptor >= 0)
+		::close(_file_descriptor);
+	_file_descriptor = -1;
+	#endif
+
+	_data = nullptr;
+	_size = 0;
+}
+} // namespace gu
\ No newline at end of file
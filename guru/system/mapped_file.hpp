@@ -0,0 +1,52 @@
+/**
+ * mapped_file.hpp
+ * ---
+ * this file defines the MappedFile class, which maps a file
+ * into read-only memory so that its bytes can be used directly
+ * without being copied into a buffer first.
+ *
+ */
+
+#pragma once
+#include <filesystem>
+#include <stdint.h>
+
+namespace gu {
+class MappedFile {
+private:
+	const char *_data = nullptr;
+	size_t _size = 0;
+	#if defined(_WIN32)
+	void *_file_handle = nullptr;
+	void *_mapping_handle = nullptr;
+	#elif defined(__linux__)
+	int _file_descriptor = -1;
+	#endif
+
+public:
+	MappedFile() = default;
+
+	// dtor. unmaps the file if it's mapped.
+	~MappedFile();
+
+	// deletes copy ctors to prevent the mapping from being unmapped twice.
+	MappedFile(const MappedFile&) = delete;
+	MappedFile &operator= (const MappedFile&) = delete;
+
+	// returns true if the file at <path> was mapped into memory.
+	// any previously mapped file will be unmapped.
+	bool open(const std::filesystem::path &path);
+
+	// unmaps the file.
+	void close();
+
+	// returns true if a file is currently mapped.
+	inline bool is_open() const { return _data != nullptr; }
+
+	// returns a pointer to the first byte of the mapped file.
+	inline const char *get_data() const { return _data; }
+
+	// returns the number of bytes in the mapped file.
+	inline size_t get_size() const { return _size; }
+};
+} // namespace gu
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "screenbuffer.hpp"
 #include <iostream>
+#include "gl_state.hpp"
 
 #if defined(_WIN32)
 static const GLenum INTERNAL_FORMAT = GL_RGB;
@@ -20,13 +21,13 @@ bool Screenbuffer::create(const int &width, const int &height) {
 
 	// creates the image buffer.
 	glGenFramebuffers(1, &_image_buffer_ID);
-	glBindFramebuffer(GL_FRAMEBUFFER, _image_buffer_ID);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _image_buffer_ID);
 
 	// creates the multisample texture.
 	_width = static_cast<GLsizei>(width);
 	_height = static_cast<GLsizei>(height);
 	glGenTextures(1, &_multisample_texture_ID);
-	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, _multisample_texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D_MULTISAMPLE, _multisample_texture_ID);
 	glTexImage2DMultisample(
 		GL_TEXTURE_2D_MULTISAMPLE,
 		_n_samples,
@@ -35,7 +36,7 @@ bool Screenbuffer::create(const int &width, const int &height) {
 		_height,
 		GL_TRUE
 	);
-	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+	GLState::bind_texture(GL_TEXTURE_2D_MULTISAMPLE, 0);
 
 	// binds the multisample texture to the image buffer.
 	glFramebufferTexture2D(
@@ -75,15 +76,15 @@ bool Screenbuffer::create(const int &width, const int &height) {
 			<< std::endl;
 		return false;
 	}
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
 
 	// creates the intermediate buffer.
 	glGenFramebuffers(1, &_intermediate_buffer_ID);
-	glBindFramebuffer(GL_FRAMEBUFFER, _intermediate_buffer_ID);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _intermediate_buffer_ID);
 
 	// creates the output screen texture.
 	glGenTextures(1, &_screen_texture_ID);
-	glBindTexture(GL_TEXTURE_2D, _screen_texture_ID);
+	GLState::bind_texture(GL_TEXTURE_2D, _screen_texture_ID);
 	glTexImage2D(
 		GL_TEXTURE_2D,
 		0,
@@ -106,7 +107,7 @@ bool Screenbuffer::create(const int &width, const int &height) {
 		_screen_texture_ID,
 		0
 	);
-	glEnable(GL_STENCIL_TEST);
+	GLState::set_stencil_test(true);
 
 	// checks if the build was successful.
 	buffer_status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
@@ -122,7 +123,7 @@ bool Screenbuffer::create(const int &width, const int &height) {
 
 void Screenbuffer::bind_and_clear(const gu::Color &clear_color) {
 	// clears Window in preparation.
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
 	glClearColor(
 		RAW_COLOR.get_r(),
 		RAW_COLOR.get_g(),
@@ -136,7 +137,7 @@ void Screenbuffer::bind_and_clear(const gu::Color &clear_color) {
 	);
 
 	// binds the Screenbuffer.
-	glBindFramebuffer(GL_FRAMEBUFFER, _image_buffer_ID);
+	GLState::bind_framebuffer(GL_FRAMEBUFFER, _image_buffer_ID);
 	glClearColor(
 		clear_color.get_r(),
 		clear_color.get_g(),
@@ -148,24 +149,32 @@ void Screenbuffer::bind_and_clear(const gu::Color &clear_color) {
 		| GL_DEPTH_BUFFER_BIT
 		| GL_STENCIL_BUFFER_BIT
 	);
-	glEnable(GL_DEPTH_TEST);
+	GLState::set_depth_test(true);
 }
 
 void Screenbuffer::_delete_resources() {
-	if (_screen_texture_ID != 0)
+	if (_screen_texture_ID != 0) {
 		glDeleteTextures(1, &_screen_texture_ID);
+		GLState::forget_texture(_screen_texture_ID);
+	}
 
-	if (_intermediate_buffer_ID != 0)
+	if (_intermediate_buffer_ID != 0) {
 		glDeleteFramebuffers(1, &_intermediate_buffer_ID);
+		GLState::forget_framebuffer(_intermediate_buffer_ID);
+	}
 
 	if (_depth_buffer_ID != 0)
 		glDeleteRenderbuffers(1, &_depth_buffer_ID);
 
-	if (_multisample_texture_ID != 0)
+	if (_multisample_texture_ID != 0) {
 		glDeleteTextures(1, &_multisample_texture_ID);
+		GLState::forget_texture(_multisample_texture_ID);
+	}
 
-	if (_image_buffer_ID != 0)
+	if (_image_buffer_ID != 0) {
 		glDeleteFramebuffers(1, &_image_buffer_ID);
+		GLState::forget_framebuffer(_image_buffer_ID);
+	}
 
 	_image_buffer_ID = 0;
 	_multisample_texture_ID = 0;
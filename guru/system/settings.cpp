@@ -5,6 +5,7 @@ bool Settings::_vsync = true;
 double Settings::_vsync_frame_duration = 0.016;
 uint16_t Settings::_fps_limit = 0;
 double Settings::_fps_limit_duration = 0.016;
+double Settings::_GL_upload_budget = 0.004;
 
 void Settings::set_fps_limit(uint16_t limit) {
 	_fps_limit = limit;
@@ -20,6 +20,21 @@
  *
  * #define GURU_USE_LEFT_HANDED_COORDINATES
  *    changes Guru to use Left-Handed coordinates.
+ *
+ * #define GURU_DISABLE_MODEL_CACHE
+ *    stops ModelResources from reading and writing
+ *    the binary ".gucache" files next to 3D model files.
+ *    ModelResource, ModelCache
+ *
+ * #define GURU_DISABLE_SIMD_ANIMATION
+ *    interpolates the Bones of an Animation one at a time
+ *    instead of in SSE batches of four.
+ *    PoseBatch
+ *
+ * #define GURU_DISABLE_SIMD_CULLING
+ *    tests Bounds against the planes of a Frustum one at a time
+ *    instead of four at a time with SSE.
+ *    Frustum, Camera
  */
 
 #pragma once
@@ -37,7 +52,6 @@ public:
 	static const uint8_t OPENGL_VERSION_MAJOR = 3;
 	static const uint8_t OPENGL_VERSION_MINOR = 3;
 	static const uint8_t N_GLFW_SAMPLES = 4;
-	static const uint16_t MAX_BONES = 100; // model rig setting
 	static const uint8_t MAX_BONE_INFLUENCES = 4; // model rig setting
 
 private:
@@ -45,6 +59,7 @@ private:
 	static double _vsync_frame_duration; // duration (seconds) by monitor Hz
 	static uint16_t _fps_limit; // used if <vsync> is false and is more than 0
 	static double _fps_limit_duration; // duration (seconds) by fps limit
+	static double _GL_upload_budget; // duration (seconds) of GL tasks per frame
 
 	// instances of this struct cannot be created.
 	Settings() = delete;
@@ -79,5 +94,17 @@ public:
 	// imposes a framerate limit on the program.
 	// 0 will remove any framerate limit and turn off vsync.
 	static void set_fps_limit(uint16_t limit);
+
+	// returns the maximum duration that queued OpenGL uploads
+	// (from resources loaded in the background) can take each frame.
+	inline static const double &get_GL_upload_budget() {
+		return _GL_upload_budget;
+	}
+
+	// sets the maximum duration (seconds) that queued OpenGL uploads
+	// can take each frame. at least one upload is always run per frame.
+	inline static void set_GL_upload_budget(const double &budget) {
+		_GL_upload_budget = budget;
+	}
 };
 } // namespace gu
@@ -0,0 +1,109 @@
+#include "thread_pool.hpp"
+#include <memory>
+
+namespace {
+// this local struct is shared by the threads running
+// the indices of a single call to ThreadPool::run_parallel(...).
+struct ParallelRun {
+	std::function<void(size_t)> task;
+	size_t n = 0;
+	std::atomic<size_t> next_index = 0;
+	std::atomic<size_t> n_finished = 0;
+	std::mutex mutex;
+	std::condition_variable finished;
+
+	// runs unclaimed indices until none are left.
+	void help() {
+		size_t n_run = 0;
+		for (size_t i = next_index++; i < n; i = next_index++) {
+			task(i);
+			++n_run;
+		}
+		if (n_run > 0 and (n_finished += n_run) == n) {
+			std::lock_guard<std::mutex> lock(mutex);
+			finished.notify_all();
+		}
+	}
+};
+} // blank namespace
+
+namespace gu {
+ThreadPool ThreadPool::thread_pool;
+
+ThreadPool::ThreadPool(size_t n_threads) {
+	if (n_threads == 0) {
+		size_t n_hardware = std::thread::hardware_concurrency();
+		n_threads = n_hardware > 1 ? n_hardware - 1 : 1;
+	}
+	_n_threads = n_threads;
+}
+
+ThreadPool::~ThreadPool() {
+	shutdown();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_tasks.push_back(std::move(task));
+
+		// starts the workers the first time they're needed.
+		if (_workers.empty()) {
+			_stopping = false;
+			_workers.reserve(_n_threads);
+			for (size_t i = 0; i < _n_threads; ++i)
+				_workers.emplace_back(&ThreadPool::_work, this);
+		}
+	}
+	_condition.notify_one();
+}
+
+void ThreadPool::run_parallel(size_t n, std::function<void(size_t)> task) {
+	if (n == 0)
+		return;
+	auto run = std::make_shared<ParallelRun>();
+	run->task = std::move(task);
+	run->n = n;
+
+	// a helper that starts after every index was claimed does nothing.
+	size_t n_helpers = n - 1 < _n_threads ? n - 1 : _n_threads;
+	for (size_t i = 0; i < n_helpers; ++i)
+		submit([run]() { run->help(); });
+
+	// the calling thread claims indices as well, so it only waits
+	// on indices that are already running on other threads.
+	run->help();
+	std::unique_lock<std::mutex> lock(run->mutex);
+	run->finished.wait(lock, [&run] { return run->n_finished == run->n; });
+}
+
+void ThreadPool::shutdown() {
+	std::vector<std::thread> workers;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_tasks.clear();
+		_stopping = true;
+		workers.swap(_workers);
+	}
+	_condition.notify_all();
+	for (auto &worker : workers)
+		worker.join();
+}
+
+void ThreadPool::_work() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this] {
+				return _stopping or not _tasks.empty();
+			});
+			if (_stopping)
+				return;
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+		task();
+	}
+}
+} // namespace gu
\ No newline at end of file
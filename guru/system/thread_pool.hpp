@@ -0,0 +1,74 @@
+/**
+ * thread_pool.hpp
+ * ---
+ * this file defines the ThreadPool class, which runs submitted tasks
+ * on a set of worker threads. the workers aren't started
+ * until the first task is submitted, so a program that never
+ * submits anything won't create any threads.
+ *
+ * ---
+ * tasks run by a ThreadPool must never make OpenGL calls
+ * or touch any ResourceList; work that must happen
+ * on the main thread is given to the GLTaskQueue instead.
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gu {
+class ThreadPool {
+public:
+	// the pool used for loading resources in the background.
+	static ThreadPool thread_pool;
+
+private:
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void()>> _tasks;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	size_t _n_threads = 0;
+	bool _stopping = false;
+
+public:
+	// ctor. sets the number of worker threads to be started.
+	// 0 will use one less than the number of hardware threads.
+	ThreadPool(size_t n_threads = 0);
+
+	// dtor. stops the worker threads.
+	~ThreadPool();
+
+	// deletes copy ctors since the workers belong to this pool.
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool &operator= (const ThreadPool&) = delete;
+
+	// returns the number of worker threads used by the pool.
+	inline size_t get_n_threads() const { return _n_threads; }
+
+	// queues the given <task> to be run on a worker thread,
+	// starting the workers if they haven't been started yet.
+	void submit(std::function<void()> task);
+
+	// runs <task> once for every index from 0 to <n - 1>,
+	// spreading the indices across the worker threads,
+	// and returns once every index has been run.
+	// the calling thread runs indices too, so this is safe to call
+	// from a task that's already running on one of the workers.
+	void run_parallel(size_t n, std::function<void(size_t)> task);
+
+	// discards every task that hasn't started yet,
+	// waits for the running tasks to finish, and joins the workers.
+	// the pool can still be used afterwards.
+	void shutdown();
+
+private:
+	// runs tasks until the pool is shut down.
+	void _work();
+};
+} // namespace gu
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <glad/gl.h>
 #include <glfw/glfw3.h>
 #include <glm/vec2.hpp>
+#include "gl_state.hpp"
 
 namespace gu {
 class Window {
@@ -53,7 +54,7 @@ public:
 	}
 
 	inline void clear() {
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::bind_framebuffer(GL_FRAMEBUFFER, 0);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 